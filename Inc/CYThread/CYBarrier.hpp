@@ -0,0 +1,106 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_BARRIER_HPP__
+#define __CY_BARRIER_HPP__
+
+#include "CYThread/CYThreadDefine.hpp"
+
+#include <atomic>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Sense-reversing barrier.
+ * Every participant flips its local sense on arrival, the last one to arrive resets the count and
+ * publishes the new sense, which releases the others. No state has to be reset between phases,
+ * so the same barrier synchronizes any number of consecutive phases.
+ */
+class CYTHREAD_API CYBarrier
+{
+public:
+    /**
+     * Constructor.
+     * @param nParticipants Threads that have to arrive before the barrier opens.
+     */
+    explicit CYBarrier(int nParticipants) noexcept;
+
+    CYBarrier(const CYBarrier&) = delete;
+    CYBarrier& operator=(const CYBarrier&) = delete;
+    CYBarrier(CYBarrier&&) noexcept = delete;
+    CYBarrier& operator=(CYBarrier&&) noexcept = delete;
+
+public:
+    /**
+     * Arrive at the barrier and wait until every participant arrived.
+     * @note Spins briefly before it blocks, phases are usually short.
+     */
+    void ArriveAndWait() noexcept;
+
+    /**
+     * Get the participant count.
+     * @return Participants.
+     */
+    [[nodiscard]] int GetParticipantCount() const noexcept
+    {
+        return m_nParticipants;
+    }
+
+private:
+    /**
+     * Spin iterations before a waiting participant blocks.
+     */
+    static constexpr int SPIN_COUNT = 4096;
+
+    const int m_nParticipants;
+    std::atomic<int> m_nRemaining;
+    std::atomic<bool> m_bSense{ false };
+};
+
+/**
+ * Kernel of a parallel region, called once on every worker.
+ */
+using CYParallelKernel = std::function<void(int nWorkerIndex, int nWorkerCount, CYBarrier& objBarrier)>;
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_BARRIER_HPP__
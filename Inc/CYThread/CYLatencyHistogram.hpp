@@ -0,0 +1,207 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LATENCY_HISTOGRAM_HPP__
+#define __CY_LATENCY_HISTOGRAM_HPP__
+
+#include "CYThread/CYThreadDefine.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Latency Histogram.
+ * Log-linear buckets in the style of HDR histograms: values below SUB_BUCKET_COUNT get a bucket
+ * each, every further power of two is split into SUB_BUCKET_COUNT equal buckets. The relative
+ * error stays below 1 / SUB_BUCKET_COUNT over the whole range, with a fixed bucket array.
+ * @note Values are nanoseconds, everything from 2^(MAX_EXPONENT + 1) on lands in the last bucket.
+ */
+class CYLatencyHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t{ 1 } << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_EXPONENT = 39;
+    static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+    /**
+     * Get the bucket a value is counted in.
+     * @param nValue Value in nanoseconds.
+     * @return Bucket index.
+     */
+    [[nodiscard]] static constexpr size_t GetBucketIndex(uint64_t nValue) noexcept
+    {
+        if (nValue < SUB_BUCKET_COUNT)
+        {
+            return static_cast<size_t>(nValue);
+        }
+
+        const uint32_t nExponent = static_cast<uint32_t>(std::bit_width(nValue)) - 1;
+        if (nExponent > MAX_EXPONENT)
+        {
+            return BUCKET_COUNT - 1;
+        }
+        const size_t nSubBucket = static_cast<size_t>(nValue >> (nExponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+        return (nExponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + nSubBucket;
+    }
+
+    /**
+     * Get the highest value a bucket counts.
+     * @param nIndex Bucket index.
+     * @return Upper bound in nanoseconds.
+     */
+    [[nodiscard]] static constexpr uint64_t GetBucketUpperBound(size_t nIndex) noexcept
+    {
+        const size_t nGroup = nIndex / SUB_BUCKET_COUNT;
+        const uint64_t nSubBucket = nIndex % SUB_BUCKET_COUNT;
+        if (nGroup == 0)
+        {
+            return nSubBucket;
+        }
+
+        const uint32_t nShift = static_cast<uint32_t>(nGroup) - 1;
+        return ((SUB_BUCKET_COUNT + nSubBucket + 1) << nShift) - 1;
+    }
+
+public:
+    /**
+     * Count a value.
+     * @param nValue Value in nanoseconds.
+     * @param nCount How often the value occurred.
+     */
+    void Record(uint64_t nValue, uint64_t nCount = 1) noexcept
+    {
+        AddToBucket(GetBucketIndex(nValue), nCount);
+    }
+
+    /**
+     * Add to a bucket directly.
+     * @param nIndex Bucket index.
+     * @param nCount Values to add.
+     */
+    void AddToBucket(size_t nIndex, uint64_t nCount) noexcept
+    {
+        m_arrCount[nIndex] += nCount;
+        m_nTotalCount += nCount;
+    }
+
+    /**
+     * Add every value of another histogram.
+     * @param objOther Histogram to add.
+     */
+    void Merge(const CYLatencyHistogram& objOther) noexcept
+    {
+        for (size_t nIndex = 0; nIndex < BUCKET_COUNT; ++nIndex)
+        {
+            m_arrCount[nIndex] += objOther.m_arrCount[nIndex];
+        }
+        m_nTotalCount += objOther.m_nTotalCount;
+    }
+
+    /**
+     * Get the number of values counted.
+     * @return Value count.
+     */
+    [[nodiscard]] uint64_t GetCount() const noexcept
+    {
+        return m_nTotalCount;
+    }
+
+    /**
+     * Get the value below which a share of the values lies.
+     * @param dPercentile Share in percent, 0 to 100.
+     * @return Upper bound of the bucket holding that value, 0 if the histogram is empty.
+     */
+    [[nodiscard]] uint64_t GetPercentile(double dPercentile) const noexcept
+    {
+        if (m_nTotalCount == 0)
+        {
+            return 0;
+        }
+
+        dPercentile = dPercentile < 0.0 ? 0.0 : (dPercentile > 100.0 ? 100.0 : dPercentile);
+        uint64_t nRank = static_cast<uint64_t>(dPercentile / 100.0 * static_cast<double>(m_nTotalCount) + 0.5);
+        nRank = nRank == 0 ? 1 : nRank;
+
+        uint64_t nSeen = 0;
+        for (size_t nIndex = 0; nIndex < BUCKET_COUNT; ++nIndex)
+        {
+            nSeen += m_arrCount[nIndex];
+            if (nSeen >= nRank)
+            {
+                return GetBucketUpperBound(nIndex);
+            }
+        }
+        return GetBucketUpperBound(BUCKET_COUNT - 1);
+    }
+
+    [[nodiscard]] uint64_t GetP50() const noexcept { return GetPercentile(50.0); }
+    [[nodiscard]] uint64_t GetP99() const noexcept { return GetPercentile(99.0); }
+    [[nodiscard]] uint64_t GetP999() const noexcept { return GetPercentile(99.9); }
+
+    /**
+     * Get the highest value counted.
+     * @return Upper bound of the highest non-empty bucket, 0 if the histogram is empty.
+     */
+    [[nodiscard]] uint64_t GetMax() const noexcept
+    {
+        for (size_t nIndex = BUCKET_COUNT; nIndex > 0; --nIndex)
+        {
+            if (m_arrCount[nIndex - 1] != 0)
+            {
+                return GetBucketUpperBound(nIndex - 1);
+            }
+        }
+        return 0;
+    }
+
+private:
+    std::array<uint64_t, BUCKET_COUNT> m_arrCount{};
+    uint64_t m_nTotalCount{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_LATENCY_HISTOGRAM_HPP__
@@ -0,0 +1,217 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_SCRATCH_ARENA_HPP__
+#define __CY_SCRATCH_ARENA_HPP__
+
+#include "CYThread/CYThreadDefine.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Position in a scratch arena, see CYScratchArena::GetMark().
+ */
+struct CYScratchMark
+{
+    void* pBlock{ nullptr };
+    char* pCursor{ nullptr };
+};
+
+/**
+ * Scratch Arena.
+ * Bump-pointer allocator owned by a worker. Allocating moves a cursor, freeing is a no-op and the
+ * whole arena is released at once by Reset(), which the worker calls after each task (or at each
+ * frame, see CYArenaResetMode). Memory never travels between threads, so temporaries of a task
+ * cost neither a malloc nor a cross-thread free.
+ * @note Not thread-safe, only the owning worker may use it. Destructors are not run on reset.
+ */
+class CYTHREAD_API CYScratchArena
+{
+public:
+    /**
+     * Default block size.
+     */
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * Constructor.
+     * @param nBlockSize Size of the first block, allocated on first use.
+     */
+    explicit CYScratchArena(size_t nBlockSize = DEFAULT_BLOCK_SIZE) noexcept;
+    ~CYScratchArena();
+
+    CYScratchArena(const CYScratchArena&) = delete;
+    CYScratchArena& operator=(const CYScratchArena&) = delete;
+    CYScratchArena(CYScratchArena&&) noexcept = delete;
+    CYScratchArena& operator=(CYScratchArena&&) noexcept = delete;
+
+public:
+    /**
+     * Get the arena of the calling worker.
+     * @return The arena, nullptr if the caller is not a pool worker.
+     */
+    [[nodiscard]] static CYScratchArena* GetCurrent() noexcept;
+
+    /**
+     * Allocate raw memory.
+     * @param nSize Bytes to allocate.
+     * @param nAlign Alignment, a power of two.
+     * @return The memory, nullptr if the system is out of memory.
+     */
+    [[nodiscard]] void* Allocate(size_t nSize, size_t nAlign = alignof(std::max_align_t)) noexcept;
+
+    /**
+     * Allocate an uninitialized array.
+     * @param nCount Element count.
+     * @return The array, nullptr if the system is out of memory.
+     */
+    template <class T>
+    [[nodiscard]] T* AllocateArray(size_t nCount) noexcept
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "The arena never runs destructors");
+        if (nCount > SIZE_MAX / sizeof(T))
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(Allocate(sizeof(T) * nCount, alignof(T)));
+    }
+
+    /**
+     * Construct an object in the arena.
+     * @param args Constructor arguments.
+     * @return The object, nullptr if the system is out of memory.
+     */
+    template <class T, class... Args>
+    [[nodiscard]] T* New(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "The arena never runs destructors");
+        void* pMemory = Allocate(sizeof(T), alignof(T));
+        return pMemory ? ::new (pMemory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /**
+     * Get the current position, allocations made after it can be dropped by Rewind().
+     * @return The position.
+     */
+    [[nodiscard]] CYScratchMark GetMark() const noexcept
+    {
+        return { m_pBlock, m_pCursor };
+    }
+
+    /**
+     * Drop every allocation made after a position.
+     * @param objMark Position returned by GetMark().
+     */
+    void Rewind(const CYScratchMark& objMark) noexcept;
+
+    /**
+     * Drop every allocation.
+     * @note If the last cycle needed several blocks they are merged, so the next one needs a single block.
+     */
+    void Reset() noexcept;
+
+    /**
+     * Set the size of the first block.
+     * @param nBlockSize Block size in bytes.
+     * @note Only takes effect before the first allocation or after a reset that merges blocks.
+     */
+    void SetBlockSize(size_t nBlockSize) noexcept
+    {
+        m_nBlockSize = nBlockSize;
+    }
+
+    /**
+     * Get the bytes handed out since the last reset, padding included.
+     * @return Used bytes.
+     */
+    [[nodiscard]] size_t GetUsed() const noexcept;
+
+    /**
+     * Get the bytes held by all blocks.
+     * @return Capacity.
+     */
+    [[nodiscard]] size_t GetCapacity() const noexcept
+    {
+        return m_nCapacity;
+    }
+
+private:
+    /**
+     * Block header, the data follows it with the default alignment.
+     */
+    struct alignas(std::max_align_t) CYBlock
+    {
+        CYBlock* pPrev;
+        size_t nSize;
+        size_t nUsedBefore;
+    };
+
+    /**
+     * Chain a new block able to hold the allocation.
+     */
+    bool AddBlock(size_t nSize, size_t nAlign) noexcept;
+
+    /**
+     * Free the blocks newer than pKeep.
+     */
+    void FreeBlocksAfter(CYBlock* pKeep) noexcept;
+
+    [[nodiscard]] static char* GetBlockBegin(CYBlock* pBlock) noexcept
+    {
+        return reinterpret_cast<char*>(pBlock + 1);
+    }
+
+    CYBlock* m_pBlock{ nullptr };
+    char* m_pCursor{ nullptr };
+    char* m_pEnd{ nullptr };
+    size_t m_nBlockSize;
+    size_t m_nCapacity{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_SCRATCH_ARENA_HPP__
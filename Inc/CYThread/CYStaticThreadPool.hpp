@@ -0,0 +1,404 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_STATIC_THREAD_POOL_HPP__
+#define __CY_STATIC_THREAD_POOL_HPP__
+
+#include "CYThread/CYThreadDefine.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Callable stored in place.
+ * Holds any void() callable of up to TaskSize bytes in its own storage, so queuing a task never
+ * allocates. Move only, moving leaves the source empty.
+ */
+template <size_t TaskSize>
+class CYStaticTask
+{
+public:
+    CYStaticTask() noexcept = default;
+
+    ~CYStaticTask()
+    {
+        Reset();
+    }
+
+    CYStaticTask(const CYStaticTask&) = delete;
+    CYStaticTask& operator=(const CYStaticTask&) = delete;
+
+    CYStaticTask(CYStaticTask&& objOther) noexcept
+    {
+        MoveFrom(objOther);
+    }
+
+    CYStaticTask& operator=(CYStaticTask&& objOther) noexcept
+    {
+        if (this != &objOther)
+        {
+            Reset();
+            MoveFrom(objOther);
+        }
+        return *this;
+    }
+
+public:
+    /**
+     * Store a callable.
+     * @param funTask Callable, must fit into TaskSize bytes and be nothrow movable.
+     */
+    template <class Func>
+    void Emplace(Func&& funTask) noexcept(std::is_nothrow_constructible_v<std::decay_t<Func>, Func&&>)
+    {
+        using Stored = std::decay_t<Func>;
+        static_assert(sizeof(Stored) <= TaskSize, "Task does not fit into the static task slot, raise TaskSize");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t), "Task is over aligned for the static task slot");
+        static_assert(std::is_nothrow_move_constructible_v<Stored>, "Task must be nothrow move constructible");
+        static_assert(std::is_invocable_v<Stored&>, "Task must be callable without arguments");
+
+        Reset();
+        ::new (static_cast<void*>(m_arrStorage)) Stored(std::forward<Func>(funTask));
+        m_pfnOperation = &Operate<Stored>;
+    }
+
+    /**
+     * Run the stored callable.
+     * @note The task must not be empty.
+     */
+    void Invoke()
+    {
+        m_pfnOperation(CYOperation::OPERATION_INVOKE, m_arrStorage, nullptr);
+    }
+
+    /**
+     * Destroy the stored callable.
+     */
+    void Reset() noexcept
+    {
+        if (m_pfnOperation)
+        {
+            m_pfnOperation(CYOperation::OPERATION_DESTROY, m_arrStorage, nullptr);
+            m_pfnOperation = nullptr;
+        }
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return m_pfnOperation == nullptr;
+    }
+
+private:
+    enum class CYOperation : uint8_t
+    {
+        OPERATION_INVOKE            = 0,
+        OPERATION_MOVE              = 1,		// Move construct into the destination, then destroy the source
+        OPERATION_DESTROY           = 2,
+    };
+
+    using OperationProc = void(*)(CYOperation eOperation, void* pSource, void* pDestination);
+
+    template <class Stored>
+    static void Operate(CYOperation eOperation, void* pSource, void* pDestination)
+    {
+        Stored* pStored = std::launder(static_cast<Stored*>(pSource));
+        switch (eOperation)
+        {
+        case CYOperation::OPERATION_INVOKE:
+            (*pStored)();
+            break;
+        case CYOperation::OPERATION_MOVE:
+            ::new (pDestination) Stored(std::move(*pStored));
+            pStored->~Stored();
+            break;
+        case CYOperation::OPERATION_DESTROY:
+            pStored->~Stored();
+            break;
+        }
+    }
+
+    void MoveFrom(CYStaticTask& objOther) noexcept
+    {
+        if (objOther.m_pfnOperation)
+        {
+            objOther.m_pfnOperation(CYOperation::OPERATION_MOVE, objOther.m_arrStorage, m_arrStorage);
+            m_pfnOperation = objOther.m_pfnOperation;
+            objOther.m_pfnOperation = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char m_arrStorage[TaskSize];
+    OperationProc m_pfnOperation{ nullptr };
+};
+
+/**
+ * Static Capacity Thread Pool.
+ * Workers, the task ring and every task slot are sized by the template arguments and live inside
+ * the pool object. The only allocations are the worker threads, made by the constructor; after
+ * that submitting, running and dropping tasks never touches the heap.
+ * @note SubmitTask never blocks, it fails when the ring is full.
+ */
+template <size_t Workers, size_t QueueCapacity, size_t TaskSize = 64>
+class CYStaticThreadPool
+{
+public:
+    static_assert(Workers > 0, "A static pool needs at least one worker");
+    static_assert(QueueCapacity > 0, "A static pool needs at least one task slot");
+
+    using TaskType = CYStaticTask<TaskSize>;
+
+    /**
+     * Constructor, starts every worker.
+     * @note If a worker cannot be started, the ones already running are stopped before the error is rethrown.
+     */
+    CYStaticThreadPool()
+    {
+        try
+        {
+            for (size_t i = 0; i < Workers; ++i)
+            {
+                m_arrWorker[i] = std::thread(&CYStaticThreadPool::WorkerLoop, this, i);
+            }
+        }
+        catch (...)
+        {
+            (void)Shutdown(CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE);
+            throw;
+        }
+    }
+
+    ~CYStaticThreadPool()
+    {
+        (void)Shutdown(CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE);
+    }
+
+    CYStaticThreadPool(const CYStaticThreadPool&) = delete;
+    CYStaticThreadPool& operator=(const CYStaticThreadPool&) = delete;
+    CYStaticThreadPool(CYStaticThreadPool&&) noexcept = delete;
+    CYStaticThreadPool& operator=(CYStaticThreadPool&&) noexcept = delete;
+
+public:
+    /**
+     * Queue a task.
+     * @param funTask Callable, checked against TaskSize at compile time.
+     * @return True if queued, false if the ring is full or the pool is stopping.
+     */
+    template <class Func>
+    bool SubmitTask(Func&& funTask) noexcept(std::is_nothrow_constructible_v<std::decay_t<Func>, Func&&>)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_objMutex);
+            if (m_bStopping || m_nCount == QueueCapacity)
+            {
+                return false;
+            }
+            m_arrTask[(m_nHead + m_nCount) % QueueCapacity].Emplace(std::forward<Func>(funTask));
+            ++m_nCount;
+        }
+        m_cvWork.notify_one();
+        return true;
+    }
+
+    /**
+     * Stop the pool.
+     * @param eMode How queued tasks are treated, cancelled tasks are destroyed without running.
+     * @param nTimeoutMs Drain deadline in milliseconds for SHUTDOWN_MODE_DRAIN_DEADLINE.
+     * @return True if the pool was running.
+     * @note Called from one of its workers, every other worker is joined and the calling one is left
+     *       to a later Shutdown() or the destructor, which must then run on another thread.
+     */
+    bool Shutdown(CYShutdownMode eMode, uint32_t nTimeoutMs = 0) noexcept
+    {
+        if (StopWorkers(eMode, nTimeoutMs))
+        {
+            m_cvWork.notify_all();
+            JoinWorkers();
+            return true;
+        }
+
+        JoinWorkers();
+        return false;
+    }
+
+    /**
+     * Get the number of queued tasks.
+     * @return Tasks that did not start yet.
+     */
+    [[nodiscard]] size_t GetPendingTaskCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        return m_nCount;
+    }
+
+    /**
+     * Get the index of the calling worker.
+     * @return Worker index, -1 if the caller is not a worker of this pool.
+     */
+    [[nodiscard]] int GetCurrentWorkerIndex() const noexcept
+    {
+        return s_pCurrentPool == this ? static_cast<int>(s_nCurrentWorker) : -1;
+    }
+
+    [[nodiscard]] static constexpr size_t GetMaxThreadCount() noexcept
+    {
+        return Workers;
+    }
+
+    [[nodiscard]] static constexpr size_t GetQueueCapacity() noexcept
+    {
+        return QueueCapacity;
+    }
+
+private:
+    /**
+     * Mark the pool stopping and drop or keep the queued tasks as the mode says.
+     * @param eMode How queued tasks are treated.
+     * @param nTimeoutMs Drain deadline in milliseconds for SHUTDOWN_MODE_DRAIN_DEADLINE.
+     * @return True if the pool was running.
+     */
+    bool StopWorkers(CYShutdownMode eMode, uint32_t nTimeoutMs) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_objMutex);
+        if (m_bStopped)
+        {
+            return false;
+        }
+
+        m_bStopped = true;
+        m_bStopping = true;
+        if (eMode == CYShutdownMode::SHUTDOWN_MODE_DRAIN_DEADLINE)
+        {
+            (void)m_cvDrained.wait_for(lock, std::chrono::milliseconds(nTimeoutMs), [this] { return m_nCount == 0; });
+        }
+        if (eMode != CYShutdownMode::SHUTDOWN_MODE_DRAIN)
+        {
+            for (; m_nCount > 0; --m_nCount)
+            {
+                m_arrTask[m_nHead].Reset();
+                m_nHead = (m_nHead + 1) % QueueCapacity;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Join every worker but the calling one, a thread cannot join itself.
+     */
+    void JoinWorkers() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_objJoinMutex);
+        const int nCurrentWorker = GetCurrentWorkerIndex();
+        for (size_t i = 0; i < Workers; ++i)
+        {
+            if (static_cast<int>(i) != nCurrentWorker && m_arrWorker[i].joinable())
+            {
+                m_arrWorker[i].join();
+            }
+        }
+    }
+
+    /**
+     * Worker body, runs queued tasks until the pool stops and the ring is empty.
+     * @param nWorker Worker index.
+     */
+    void WorkerLoop(size_t nWorker)
+    {
+        s_pCurrentPool = this;
+        s_nCurrentWorker = nWorker;
+
+        TaskType objTask;
+        std::unique_lock<std::mutex> lock(m_objMutex);
+        for (;;)
+        {
+            m_cvWork.wait(lock, [this] { return m_nCount != 0 || m_bStopping; });
+            if (m_nCount == 0)
+            {
+                break;
+            }
+
+            objTask = std::move(m_arrTask[m_nHead]);
+            m_nHead = (m_nHead + 1) % QueueCapacity;
+            if (--m_nCount == 0 && m_bStopping)
+            {
+                m_cvDrained.notify_all();
+            }
+            lock.unlock();
+
+            objTask.Invoke();
+            objTask.Reset();
+
+            lock.lock();
+        }
+
+        s_pCurrentPool = nullptr;
+    }
+
+private:
+    mutable std::mutex m_objMutex;
+    std::mutex m_objJoinMutex;
+    std::condition_variable m_cvWork;
+    std::condition_variable m_cvDrained;
+    std::array<TaskType, QueueCapacity> m_arrTask;
+    std::array<std::thread, Workers> m_arrWorker;
+    size_t m_nHead{ 0 };
+    size_t m_nCount{ 0 };
+    bool m_bStopping{ false };
+    bool m_bStopped{ false };
+
+    static inline thread_local const CYStaticThreadPool* s_pCurrentPool{ nullptr };
+    static inline thread_local size_t s_nCurrentWorker{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_STATIC_THREAD_POOL_HPP__
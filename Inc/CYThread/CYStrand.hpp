@@ -0,0 +1,228 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_STRAND_HPP__
+#define __CY_STRAND_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Strand.
+ * Tasks submitted to one strand run one at a time in submission order, while different strands
+ * run in parallel on the same pool. Tasks are kept in a lock-free queue per strand and at most
+ * one runner task of the strand occupies a worker at any time, so a hot strand never blocks
+ * workers on a mutex. Queue nodes are recycled through per-worker free lists like the pool's own
+ * task nodes. A runner carries the tag of the tasks it runs and only runs tasks of that tag, so tag
+ * statistics, limits and waits see the strand's tasks.
+ */
+class CYTHREAD_API CYStrand
+{
+public:
+    /**
+     * Constructor.
+     * @param pThreadPool Pool the strand runs on.
+     */
+    explicit CYStrand(ICYThreadPool* pThreadPool);
+
+    /**
+     * Destructor, waits for the queued tasks because the runner references the strand.
+     */
+    virtual ~CYStrand();
+
+    CYStrand(const CYStrand&) = delete;
+    CYStrand& operator=(const CYStrand&) = delete;
+    CYStrand(CYStrand&&) noexcept = delete;
+    CYStrand& operator=(CYStrand&&) noexcept = delete;
+
+public:
+    /**
+     * Queue a objTask behind the earlier tasks of the strand.
+     * @param objTask Task object.
+     * @return True once the task is queued, false if the strand has no pool or no node for it.
+     * @note If the pool refuses the runner the task still stays queued, see IsRunnerDeferred(). It
+     *       runs once a later SubmitTask() or Wait() gets a runner onto the pool, or on the thread
+     *       calling Wait() if the pool keeps refusing. The same holds for a runner the pool drops
+     *       unrun, e.g. through CancelTag(). An exception thrown by a task is swallowed so that the
+     *       tasks behind it still run.
+     */
+    bool SubmitTask(const CYThreadTask& objTask);
+
+    /**
+     * Wait until every queued task of the strand has run.
+     * @param nTimeoutMs Timeout in milliseconds, UINT32_MAX waits forever.
+     * @return 0 if the strand is idle, 1 on timeout.
+     * @note If the pool refused the runner, the queue is run on the calling thread.
+     */
+    uint32_t Wait(uint32_t nTimeoutMs = UINT32_MAX) noexcept;
+
+    /**
+     * Get the number of queued and running tasks.
+     * @return Outstanding task count.
+     */
+    [[nodiscard]] size_t GetPendingCount() const noexcept
+    {
+        return m_nPendingTasks.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Check if queued tasks wait for a runner the pool refused or dropped.
+     * @return True if the tasks only run once a later SubmitTask() or Wait() gets a runner going.
+     */
+    [[nodiscard]] bool IsRunnerDeferred() const noexcept
+    {
+        return m_bRunnerParked.load(std::memory_order_acquire);
+    }
+
+private:
+    /**
+     * Recycler of the queue nodes, defined in the translation unit.
+     */
+    class CYNodePool;
+
+    /**
+     * Shared by the copies of one runner task, parks the runner if the pool drops it unrun.
+     */
+    class CYRunnerTicket;
+
+    /**
+     * Push a node, safe from any thread.
+     */
+    void Push(CYTaskRecord* pNode) noexcept;
+
+    /**
+     * Pop the oldest node, only called by the runner.
+     * @return Node, nullptr if a producer has not finished linking it yet.
+     */
+    [[nodiscard]] CYTaskRecord* Pop() noexcept;
+
+    /**
+     * Hand the runner to the pool.
+     * @return True if the pool accepted it.
+     */
+    [[nodiscard]] bool ScheduleRunner() noexcept;
+
+    /**
+     * Hand the runner to the pool, remembering a refusal so that the queue is not lost.
+     */
+    void ScheduleOrPark() noexcept;
+
+    /**
+     * Note that tasks are queued without a runner and wake Wait().
+     */
+    void ParkRunner() noexcept;
+
+    /**
+     * Take over a runner the pool refused earlier.
+     * @return True if the caller is the runner now.
+     */
+    [[nodiscard]] bool ClaimParkedRunner() noexcept;
+
+    /**
+     * Run queued tasks on a worker until the strand is idle or the batch is used up.
+     * @param objStopToken Token of the runner task.
+     */
+    void RunTasks(const CYStopToken& objStopToken) noexcept;
+
+    /**
+     * Account one finished or dropped task.
+     * @return True if the strand became idle.
+     */
+    bool FinishTask() noexcept;
+
+private:
+    /**
+     * Tasks a runner executes before it gives its worker back to the pool.
+     */
+    static constexpr int RUNNER_BATCH = 64;
+
+    /**
+     * Pool the strand runs on.
+     */
+    ICYThreadPool* m_pThreadPool{ nullptr };
+
+    /**
+     * Queue nodes, recycled instead of allocated per task.
+     */
+    std::unique_ptr<CYNodePool> m_ptrNodePool;
+
+    /**
+     * Intrusive MPSC queue linked through CYTaskRecord::pNext, producers swap m_pHead, the runner
+     * owns m_pTail.
+     */
+    CYTaskRecord m_objStub;
+    std::atomic<CYTaskRecord*> m_pHead{ &m_objStub };
+    CYTaskRecord* m_pTail{ &m_objStub };
+
+    /**
+     * Queued and running tasks, the 0 to 1 transition schedules the runner.
+     */
+    std::atomic<size_t> m_nPendingTasks{ 0 };
+
+    /**
+     * Set while tasks are queued but the pool refused their runner, cleared by whoever takes over.
+     */
+    std::atomic<bool> m_bRunnerParked{ false };
+
+    /**
+     * Owned by whoever holds the runner role: the tag the next runner is submitted with and the
+     * popped node of another tag it starts with.
+     */
+    CYTaskTag m_nRunnerTag{ CYTHREAD_NO_TAG };
+    CYTaskRecord* m_pCarriedNode{ nullptr };
+
+    /**
+     * Wait() support.
+     */
+    std::mutex m_objMutex;
+    std::condition_variable m_objCondVar;
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_STRAND_HPP__
@@ -0,0 +1,211 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TASK_GROUP_HPP__
+#define __CY_TASK_GROUP_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+class CYThread;
+class CYThreadPool;
+class CYTaskQueue;
+
+/**
+ * Task Group.
+ * Tracks every task submitted through it, including the tasks of nested child groups,
+ * so that all of them can be cancelled or waited for at once.
+ */
+class CYTHREAD_API CYTaskGroup
+{
+public:
+    /**
+     * Constructor.
+     * @param pThreadPool Pool the group submits to.
+     * @param pParentGroup Optional parent, its Cancel() and Wait() also cover this group.
+     */
+    explicit CYTaskGroup(ICYThreadPool* pThreadPool, CYTaskGroup* pParentGroup = nullptr);
+
+    /**
+     * Destructor, waits for the outstanding tasks because they still reference the group.
+     * @note Child groups must be destroyed before their parent.
+     */
+    virtual ~CYTaskGroup();
+
+    CYTaskGroup(const CYTaskGroup&) = delete;
+    CYTaskGroup& operator=(const CYTaskGroup&) = delete;
+    CYTaskGroup(CYTaskGroup&&) noexcept = delete;
+    CYTaskGroup& operator=(CYTaskGroup&&) noexcept = delete;
+
+public:
+    /**
+     * Submit a objTask through the group.
+     * @param objTask Task object.
+     * @return True if success, false if the group is cancelled or the pool rejected the task.
+     */
+    bool SubmitTask(const CYThreadTask& objTask);
+
+    /**
+     * Submit an object objTask through the group.
+     * @param pInvokingObject Object invoking the task.
+     * @return True if success, false if the group is cancelled or the pool rejected the task.
+     */
+    bool SubmitTask(ICYIThreadableObject* pInvokingObject);
+
+    /**
+     * Cancel the group and its child groups.
+     * @note Queued tasks are discarded without running, running tasks get their stop token signalled.
+     */
+    void Cancel() noexcept;
+
+    /**
+     * Check if this group or one of its ancestors was cancelled.
+     * @return True if cancelled, false otherwise.
+     */
+    [[nodiscard]] bool IsCancelled() const noexcept;
+
+    /**
+     * Check if this group is pGroup or nested below it.
+     * @param pGroup Candidate ancestor.
+     * @return True if pGroup is this group or one of its ancestors.
+     */
+    [[nodiscard]] bool IsWithin(const CYTaskGroup* pGroup) const noexcept;
+
+    /**
+     * Wait until every task of the group and its child groups finished or was discarded.
+     * @param nTimeoutMs Timeout in milliseconds, UINT32_MAX waits forever.
+     * @return 0 if the group is idle, 1 on timeout.
+     */
+    uint32_t Wait(uint32_t nTimeoutMs = UINT32_MAX) noexcept;
+
+    /**
+     * Get the number of queued and running tasks, including child groups.
+     * @return Outstanding task count.
+     */
+    [[nodiscard]] int GetPendingCount() const noexcept
+    {
+        return m_nPendingTasks.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the pool the group submits to.
+     * @return Thread pool.
+     */
+    [[nodiscard]] ICYThreadPool* GetThreadPool() const noexcept
+    {
+        return m_pThreadPool;
+    }
+
+    /**
+     * Get the parent group.
+     * @return Parent group or nullptr.
+     */
+    [[nodiscard]] CYTaskGroup* GetParentGroup() const noexcept
+    {
+        return m_pParentGroup;
+    }
+
+private:
+    friend class CYThread;
+    friend class CYThreadPool;
+    friend class CYTaskQueue;
+
+    /**
+     * Account a task accepted by the pool, called under the pool lock.
+     */
+    void OnTaskSubmitted() noexcept;
+
+    /**
+     * Account a task that finished or was discarded.
+     * @note The group may be destroyed by a waiter as soon as this returns.
+     */
+    void OnTaskFinished() noexcept;
+
+private:
+    /**
+     * Pool the group submits to.
+     */
+    ICYThreadPool* m_pThreadPool{ nullptr };
+
+    /**
+     * Enclosing group, nullptr for a root group.
+     */
+    CYTaskGroup* m_pParentGroup{ nullptr };
+
+    /**
+     * Queued and running tasks of this group and its children.
+     */
+    std::atomic<int> m_nPendingTasks{ 0 };
+
+    /**
+     * Set once by Cancel().
+     */
+    std::atomic<bool> m_bCancelled{ false };
+
+    /**
+     * Queued records of the group, linked through CYTaskRecord::pGroupNext and guarded by the pool lock.
+     */
+    CYTaskRecord* m_pQueuedRecord{ nullptr };
+
+    /**
+     * Child groups, so that cancelling a group reaches their queued records too.
+     */
+    CYTaskGroup* m_pFirstChild{ nullptr };
+    CYTaskGroup* m_pPrevSibling{ nullptr };
+    CYTaskGroup* m_pNextSibling{ nullptr };
+    std::mutex m_objChildMutex;
+
+    /**
+     * Wait() support.
+     */
+    std::mutex m_objMutex;
+    std::condition_variable m_objCondVar;
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_TASK_GROUP_HPP__
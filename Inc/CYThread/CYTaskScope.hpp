@@ -0,0 +1,153 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TASK_SCOPE_HPP__
+#define __CY_TASK_SCOPE_HPP__
+
+#include "CYThread/CYTaskGroup.hpp"
+
+#include <exception>
+#include <mutex>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Task Scope.
+ * Structured concurrency nursery: every task spawned through the scope is joined before the
+ * scope is left, and the first exception thrown by one of them is rethrown to the owner.
+ */
+class CYTHREAD_API CYTaskScope
+{
+public:
+    /**
+     * Constructor.
+     * @param pThreadPool Pool the scope submits to.
+     * @param pParentGroup Optional group, its Cancel() also cancels the tasks of the scope.
+     */
+    explicit CYTaskScope(ICYThreadPool* pThreadPool, CYTaskGroup* pParentGroup = nullptr);
+
+    /**
+     * Destructor, joins the outstanding tasks.
+     * @note Rethrows a captured exception unless the scope is left by another exception.
+     */
+    ~CYTaskScope() noexcept(false);
+
+    CYTaskScope(const CYTaskScope&) = delete;
+    CYTaskScope& operator=(const CYTaskScope&) = delete;
+    CYTaskScope(CYTaskScope&&) noexcept = delete;
+    CYTaskScope& operator=(CYTaskScope&&) noexcept = delete;
+
+public:
+    /**
+     * Spawn a objTask in the scope.
+     * @param objTask Task object.
+     * @return True if success, false if the scope is cancelled or the pool rejected the task.
+     */
+    bool SubmitTask(const CYThreadTask& objTask);
+
+    /**
+     * Spawn an object objTask in the scope.
+     * @param pInvokingObject Object invoking the task.
+     * @return True if success, false if the scope is cancelled, the object is still queued or the pool rejected the task.
+     * @note The object runs through a scope task, so cancel the scope rather than calling
+     *       TerminateWorkingThread on the object. It counts as queued until that task starts.
+     */
+    bool SubmitTask(ICYIThreadableObject* pInvokingObject);
+
+    /**
+     * Cancel the tasks of the scope.
+     */
+    void Cancel() noexcept;
+
+    /**
+     * Wait for every task of the scope, helping to execute queued tasks when called on a worker.
+     * @note Rethrows the first exception thrown by a task of the scope.
+     */
+    void Join();
+
+    /**
+     * Get the number of queued and running tasks.
+     * @return Outstanding task count.
+     */
+    [[nodiscard]] int GetPendingCount() const noexcept
+    {
+        return m_objTaskGroup.GetPendingCount();
+    }
+
+private:
+    /**
+     * Wait until the scope is idle without rethrowing.
+     */
+    void WaitIdle() noexcept;
+
+    /**
+     * Keep the first exception thrown by a task.
+     * @param ptrException Exception to keep.
+     */
+    void CaptureException(std::exception_ptr ptrException) noexcept;
+
+private:
+    /**
+     * Pool the scope submits to.
+     */
+    ICYThreadPool* m_pThreadPool{ nullptr };
+
+    /**
+     * Counts the children with a single atomic and carries cancellation.
+     */
+    CYTaskGroup m_objTaskGroup;
+
+    /**
+     * First exception thrown by a child.
+     */
+    std::mutex m_objMutex;
+    std::exception_ptr m_ptrException;
+
+    /**
+     * Exceptions in flight when the scope was entered.
+     */
+    int m_nUncaughtExceptions{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_TASK_SCOPE_HPP__
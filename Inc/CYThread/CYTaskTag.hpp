@@ -0,0 +1,80 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TASK_TAG_HPP__
+#define __CY_TASK_TAG_HPP__
+
+#include "CYThread/CYThreadDefine.hpp"
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Task Tag Registry.
+ * Interns tag names into process-wide numeric tags, so that tasks carry a plain integer while
+ * statistics can still be reported by name. Interned tags have CYTHREAD_INTERNED_TAG_BIT set
+ * and never collide with numeric tags below it.
+ * @note Interning takes a lock, intern a name once and keep the tag.
+ */
+class CYTHREAD_API CYTaskTagRegistry
+{
+public:
+    CYTaskTagRegistry() = delete;
+
+public:
+    /**
+     * Get the tag of a name, interning it on first use.
+     * @param pszName Tag name.
+     * @return Tag, CYTHREAD_NO_TAG for an empty name or when out of memory.
+     */
+    [[nodiscard]] static CYTaskTag Intern(const char* pszName) noexcept;
+
+    /**
+     * Get the name of an interned tag.
+     * @param nTag Tag returned by Intern().
+     * @return Name, valid for the lifetime of the process, nullptr for tags that were not interned.
+     */
+    [[nodiscard]] static const char* GetName(CYTaskTag nTag) noexcept;
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_TASK_TAG_HPP__
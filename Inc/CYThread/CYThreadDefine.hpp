@@ -45,6 +45,8 @@
 
 #include <stdint.h>
 #include <functional>
+#include <atomic>
+#include <memory>
 
 #define CYTHRAD_NAMESPACE_BEGIN			namespace cry {
 #define CYTHRAD_NAMESPACE				cry
@@ -103,8 +105,92 @@
 #    define CYTHREAD_API
 #endif
 
+#if defined(__has_include)
+#  if __has_include(<stop_token>)
+#    if defined(__APPLE__)
+#      if (defined(__MAC_OS_X_VERSION_MIN_REQUIRED) && __MAC_OS_X_VERSION_MIN_REQUIRED >= 110000) || \
+          (defined(__IPHONE_OS_VERSION_MIN_REQUIRED) && __IPHONE_OS_VERSION_MIN_REQUIRED >= 140000) || \
+          (defined(__TV_OS_VERSION_MIN_REQUIRED) && __TV_OS_VERSION_MIN_REQUIRED >= 140000) || \
+          (defined(__WATCH_OS_VERSION_MIN_REQUIRED) && __WATCH_OS_VERSION_MIN_REQUIRED >= 70000)
+#        define CYTHREAD_HAS_STD_STOP_TOKEN 1
+#      else
+#        define CYTHREAD_HAS_STD_STOP_TOKEN 0
+#      endif
+#    else
+#      define CYTHREAD_HAS_STD_STOP_TOKEN 1
+#    endif
+#  else
+#    define CYTHREAD_HAS_STD_STOP_TOKEN 0
+#  endif
+#else
+#  define CYTHREAD_HAS_STD_STOP_TOKEN 1
+#endif
+
+#if defined(__ANDROID__) && !defined(CYTHREAD_FORCE_STD_STOP_TOKEN)
+#  undef CYTHREAD_HAS_STD_STOP_TOKEN
+#  define CYTHREAD_HAS_STD_STOP_TOKEN 0
+#endif
+
+#if CYTHREAD_HAS_STD_STOP_TOKEN
+#  include <stop_token>
+#endif
+
 CYTHRAD_NAMESPACE_BEGIN
 
+namespace detail
+{
+#if CYTHREAD_HAS_STD_STOP_TOKEN
+    using stop_token = std::stop_token;
+    using stop_source = std::stop_source;
+#else
+    class stop_state
+    {
+    public:
+        void request_stop() noexcept { m_flag.store(true, std::memory_order_release); }
+        [[nodiscard]] bool stop_requested() const noexcept { return m_flag.load(std::memory_order_acquire); }
+    private:
+        std::atomic<bool> m_flag{ false };
+    };
+
+    class stop_token
+    {
+    public:
+        stop_token() noexcept = default;
+        explicit stop_token(std::shared_ptr<stop_state> state) noexcept : m_state(std::move(state)) {}
+        [[nodiscard]] bool stop_requested() const noexcept
+        {
+            return m_state ? m_state->stop_requested() : false;
+        }
+    private:
+        std::shared_ptr<stop_state> m_state;
+        friend class stop_source;
+    };
+
+    class stop_source
+    {
+    public:
+        stop_source()
+            : m_state(std::make_shared<stop_state>())
+        {
+        }
+
+        stop_token get_token() const noexcept { return stop_token(m_state); }
+        void request_stop() noexcept
+        {
+            if (m_state)
+            {
+                m_state->request_stop();
+            }
+        }
+    private:
+        std::shared_ptr<stop_state> m_state;
+    };
+#endif
+} // namespace detail
+
+using CYStopToken = detail::stop_token;
+using CYStopSource = detail::stop_source;
+
 /**
  * Platform ID.
  */
@@ -153,6 +239,100 @@ enum class CYProcessorAffinity : uint8_t
     AFFINITY_PROCESSOR_UNDEFINED,
 };
 
+/**
+ * Thread pool shutdown mode.
+ */
+enum class CYShutdownMode : uint8_t
+{
+    SHUTDOWN_MODE_IMMEDIATE         = 0,		// Terminate workers, pending tasks are dropped silently
+    SHUTDOWN_MODE_DRAIN             = 1,		// Finish every queued task, then terminate workers
+    SHUTDOWN_MODE_CANCEL_PENDING    = 2,		// Drop pending tasks through the cancel callback, then terminate
+    SHUTDOWN_MODE_DRAIN_DEADLINE    = 3,		// Drain until the deadline, then cancel whatever is left
+};
+
+/**
+ * When a worker resets its scratch arena.
+ */
+enum class CYArenaResetMode : uint8_t
+{
+    RESET_PER_TASK                  = 0,		// After every task
+    RESET_PER_FRAME                 = 1,		// Before the first task of a new frame, see AdvanceScratchFrame
+};
+
+/**
+ * How a pool creates its workers.
+ */
+enum class CYWorkerSpawnMode : uint8_t
+{
+    SPAWN_MODE_EAGER                = 0,		// Every worker, one after another, during CreateThreadPool
+    SPAWN_MODE_PARALLEL             = 1,		// Every worker, spread over several spawning threads, during CreateThreadPool
+    SPAWN_MODE_LAZY                 = 2,		// One worker whenever a task finds none idle, up to the maximum
+};
+
+/**
+ * Counter a worker reads around every task when the pool samples them.
+ */
+enum class CYPerfCounter : uint8_t
+{
+    PERF_COUNTER_CYCLES             = 0,		// CPU cycles, hardware
+    PERF_COUNTER_INSTRUCTIONS       = 1,		// Retired instructions, hardware
+    PERF_COUNTER_CACHE_MISSES       = 2,		// Last level cache misses, hardware
+    PERF_COUNTER_CONTEXT_SWITCHES   = 3,		// Context switches, software
+    PERF_COUNTER_TASK_CLOCK         = 4,		// Nanoseconds on a CPU, software, stands in for cycles without hardware counters
+    PERF_COUNTER_CPU_TIME           = 5,		// Nanoseconds of thread CPU time, from the thread CPU clock
+    PERF_COUNTER_WALL_TIME          = 6,		// Nanoseconds of wall time, read together with the CPU time
+    PERF_COUNTER_COUNT              = 7,
+};
+
+/**
+ * Kind of a queued task record.
+ */
+enum class CYTaskKind : uint8_t
+{
+    TASK_KIND_FUNCTION              = 0,		// CYThreadTask held by a pooled node
+    TASK_KIND_OBJECT                = 1,		// ICYIThreadableObject linked through its own hook
+};
+
+/**
+ * Order in which queued function and object tasks are handed out.
+ */
+enum class CYTaskOrder : uint8_t
+{
+    TASK_ORDER_FIFO                 = 0,		// Oldest task first, whatever its kind
+    TASK_ORDER_OBJECTS_FIRST        = 1,		// Every object task before any function task
+};
+
+/**
+ * Timer handle returned by the delayed and periodic submit functions.
+ */
+using CYTimerId = uint64_t;
+constexpr CYTimerId CYTHREAD_INVALID_TIMER_ID = 0;
+
+/**
+ * Affinity key of a task without worker preference.
+ */
+constexpr uint64_t CYTHREAD_NO_AFFINITY_KEY = UINT64_MAX;
+
+/**
+ * Stack bytes every worker touches in Prewarm unless told otherwise.
+ */
+constexpr size_t CYTHREAD_PREWARM_STACK_SIZE = 64 * 1024;
+
+/**
+ * Tag of a task, attributes its load and latency to a subsystem.
+ */
+using CYTaskTag = uint32_t;
+
+/**
+ * Tag of untagged tasks.
+ */
+constexpr CYTaskTag CYTHREAD_NO_TAG = 0;
+
+/**
+ * Set in every tag interned by CYTaskTagRegistry, numeric tags must leave it clear.
+ */
+constexpr CYTaskTag CYTHREAD_INTERNED_TAG_BIT = 0x80000000u;
+
 /**
  * Thread Task Struct.
  */
@@ -162,6 +342,12 @@ struct CYTHREAD_API CYThreadTask
      * Threads execution callback.
      */
     std::function<void(void*, bool)> funTaskToExecute;
+
+    /**
+     * Cancellable execution callback, used instead of funTaskToExecute when set.
+     * The token is signalled when the task is asked to stop early.
+     */
+    std::function<void(void*, const CYStopToken&)> funCancellableTaskToExecute;
     
     /**
      * Threads execution arguments.
@@ -172,8 +358,43 @@ struct CYTHREAD_API CYThreadTask
      * Reserved deletion flag.
      */
     bool bDelete{ false };
+
+    /**
+     * Tasks with the same key prefer the same worker, CYTHREAD_NO_AFFINITY_KEY for none.
+     */
+    uint64_t nAffinityKey{ CYTHREAD_NO_AFFINITY_KEY };
+
+    /**
+     * Tag the pool keeps statistics for, CYTHREAD_NO_TAG for none.
+     */
+    CYTaskTag nTag{ CYTHREAD_NO_TAG };
 };
 
+/**
+ * Compact task procedure, receives the context the task was submitted with.
+ */
+using CYCompactTaskProc = void (*)(void* pContext);
+
+/**
+ * Compact Task Struct.
+ * A function pointer plus its context, two pointers wide. Compact tasks are queued in segmented
+ * arrays of their own and carry no group, affinity or stop token.
+ */
+struct CYCompactTask
+{
+    /**
+     * Task procedure.
+     */
+    CYCompactTaskProc pfnTask{ nullptr };
+
+    /**
+     * Context handed to the procedure.
+     */
+    void* pContext{ nullptr };
+};
+
+static_assert(sizeof(CYCompactTask) == 2 * sizeof(void*), "CYCompactTask must stay two pointers wide");
+
 CYTHRAD_NAMESPACE_END
 
 #endif // __CY_THREAD_DEFINE_HPP__
\ No newline at end of file
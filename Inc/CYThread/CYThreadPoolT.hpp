@@ -0,0 +1,567 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_THREAD_POOL_T_HPP__
+#define __CY_THREAD_POOL_T_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Runs a queued task, specialized for the task types the library knows about.
+ * Any other type is called as a plain callable.
+ */
+template <class Task>
+struct CYTaskInvoker
+{
+    static void Invoke(Task& objTask, const CYStopToken& objStopToken)
+    {
+        (void)objStopToken;
+        objTask();
+    }
+};
+
+template <>
+struct CYTaskInvoker<CYThreadTask>
+{
+    static void Invoke(CYThreadTask& objTask, const CYStopToken& objStopToken)
+    {
+        if (objTask.funCancellableTaskToExecute)
+        {
+            objTask.funCancellableTaskToExecute(objTask.pArgList, objStopToken);
+        }
+        else if (objTask.funTaskToExecute)
+        {
+            objTask.funTaskToExecute(objTask.pArgList, objTask.bDelete);
+        }
+    }
+};
+
+template <>
+struct CYTaskInvoker<ICYIThreadableObject*>
+{
+    static void Invoke(ICYIThreadableObject* pObject, const CYStopToken& objStopToken)
+    {
+        if (pObject)
+        {
+            pObject->TaskToExecute(objStopToken);
+        }
+    }
+};
+
+/**
+ * Queue Policy, oldest task first.
+ */
+template <class Task>
+class CYFifoQueuePolicy
+{
+public:
+    using TaskType = Task;
+
+    void Push(Task&& objTask)
+    {
+        m_lstTask.push_back(std::move(objTask));
+    }
+
+    /**
+     * Remove the next task.
+     * @note The queue must not be empty.
+     */
+    [[nodiscard]] Task Pop()
+    {
+        Task objTask = std::move(m_lstTask.front());
+        m_lstTask.pop_front();
+        return objTask;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return m_lstTask.empty();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return m_lstTask.size();
+    }
+
+private:
+    std::deque<Task> m_lstTask;
+};
+
+/**
+ * Queue Policy, newest task first.
+ * The task a worker picks up is the one whose data is most likely still in cache.
+ */
+template <class Task>
+class CYLifoQueuePolicy
+{
+public:
+    using TaskType = Task;
+
+    void Push(Task&& objTask)
+    {
+        m_lstTask.push_back(std::move(objTask));
+    }
+
+    /**
+     * Remove the next task.
+     * @note The queue must not be empty.
+     */
+    [[nodiscard]] Task Pop()
+    {
+        Task objTask = std::move(m_lstTask.back());
+        m_lstTask.pop_back();
+        return objTask;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return m_lstTask.empty();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return m_lstTask.size();
+    }
+
+private:
+    std::vector<Task> m_lstTask;
+};
+
+/**
+ * Idle Policy, an idle worker blocks on a condition variable right away.
+ */
+class CYBlockingIdlePolicy
+{
+public:
+    /**
+     * Wait until there is work.
+     * @param objLock Pool lock, held on entry and on return.
+     * @param funReady Checked under the lock.
+     * @param funHint Lock free estimate of funReady, unused here.
+     */
+    template <class ReadyOp, class HintOp>
+    void Wait(std::unique_lock<std::mutex>& objLock, ReadyOp funReady, HintOp funHint)
+    {
+        (void)funHint;
+        m_cvWork.wait(objLock, funReady);
+    }
+
+    void NotifyOne() noexcept
+    {
+        m_cvWork.notify_one();
+    }
+
+    void NotifyAll() noexcept
+    {
+        m_cvWork.notify_all();
+    }
+
+private:
+    std::condition_variable m_cvWork;
+};
+
+/**
+ * Idle Policy, an idle worker spins on the pending count before it blocks.
+ * Trades CPU time for wake up latency when tasks arrive in quick succession.
+ */
+template <int SPIN_COUNT = 4096>
+class CYSpinIdlePolicy
+{
+public:
+    /**
+     * Wait until there is work.
+     * @param objLock Pool lock, held on entry and on return.
+     * @param funReady Checked under the lock.
+     * @param funHint Lock free estimate of funReady, polled while spinning.
+     */
+    template <class ReadyOp, class HintOp>
+    void Wait(std::unique_lock<std::mutex>& objLock, ReadyOp funReady, HintOp funHint)
+    {
+        if (funReady())
+        {
+            return;
+        }
+
+        objLock.unlock();
+        for (int nSpin = 0; nSpin < SPIN_COUNT && !funHint(); ++nSpin)
+        {
+        }
+        objLock.lock();
+        m_cvWork.wait(objLock, funReady);
+    }
+
+    void NotifyOne() noexcept
+    {
+        m_cvWork.notify_one();
+    }
+
+    void NotifyAll() noexcept
+    {
+        m_cvWork.notify_all();
+    }
+
+private:
+    std::condition_variable m_cvWork;
+};
+
+/**
+ * Instrumentation, every hook is empty and compiles away.
+ */
+struct CYNullInstrumentation
+{
+    void OnSubmit() noexcept {}
+    void OnReject() noexcept {}
+    void OnTaskBegin(size_t nWorker) noexcept { (void)nWorker; }
+    void OnTaskEnd(size_t nWorker) noexcept { (void)nWorker; }
+};
+
+/**
+ * Instrumentation, counts submitted, rejected and executed tasks.
+ */
+class CYCountingInstrumentation
+{
+public:
+    void OnSubmit() noexcept
+    {
+        m_nSubmitted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnReject() noexcept
+    {
+        m_nRejected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnTaskBegin(size_t nWorker) noexcept
+    {
+        (void)nWorker;
+    }
+
+    void OnTaskEnd(size_t nWorker) noexcept
+    {
+        (void)nWorker;
+        m_nExecuted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t GetSubmittedCount() const noexcept
+    {
+        return m_nSubmitted.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t GetRejectedCount() const noexcept
+    {
+        return m_nRejected.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t GetExecutedCount() const noexcept
+    {
+        return m_nExecuted.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> m_nSubmitted{ 0 };
+    std::atomic<uint64_t> m_nRejected{ 0 };
+    std::atomic<uint64_t> m_nExecuted{ 0 };
+};
+
+/**
+ * Header Only Thread Pool.
+ * The queue, the idle behaviour and the instrumentation are compile time parameters, so submit
+ * and dispatch contain no virtual calls and inline into the caller. Covers the latency critical
+ * subset of ICYThreadPool: plain tasks, a task limit and the shutdown modes; groups, timers,
+ * affinity and the other ICYThreadPool features stay with the library pool.
+ * @note With ICYIThreadableObject* as task type TaskToExecute is still a virtual call.
+ */
+template <class QueuePolicy = CYFifoQueuePolicy<CYThreadTask>, class IdlePolicy = CYBlockingIdlePolicy, class Instrumentation = CYNullInstrumentation>
+class CYThreadPoolT
+{
+public:
+    using TaskType = typename QueuePolicy::TaskType;
+
+    CYThreadPoolT() = default;
+
+    ~CYThreadPoolT()
+    {
+        (void)Shutdown(CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE);
+    }
+
+    CYThreadPoolT(const CYThreadPoolT&) = delete;
+    CYThreadPoolT& operator=(const CYThreadPoolT&) = delete;
+    CYThreadPoolT(CYThreadPoolT&&) noexcept = delete;
+    CYThreadPoolT& operator=(CYThreadPoolT&&) noexcept = delete;
+
+public:
+    /**
+     * Start the workers.
+     * @param nMaxThread Number of workers.
+     * @param nMaxTasks Queued tasks before submissions are rejected, 0 for no limit.
+     * @return True if the workers were started, false if the pool already runs.
+     */
+    bool CreateThreadPool(int nMaxThread, size_t nMaxTasks = 0)
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        if (!m_lstWorker.empty() || nMaxThread <= 0)
+        {
+            return false;
+        }
+
+        m_nMaxTasks = nMaxTasks;
+        m_bStopping.store(false, std::memory_order_relaxed);
+        m_objStopSource = CYStopSource();
+        m_lstWorker.reserve(static_cast<size_t>(nMaxThread));
+        for (int i = 0; i < nMaxThread; ++i)
+        {
+            m_lstWorker.emplace_back(&CYThreadPoolT::WorkerLoop, this, static_cast<size_t>(i));
+        }
+        return true;
+    }
+
+    /**
+     * Queue a task.
+     * @param objTask Task to execute.
+     * @return True if queued, false if the pool is stopping or the task limit is reached.
+     */
+    bool SubmitTask(TaskType objTask)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_objMutex);
+            if (m_bStopping.load(std::memory_order_relaxed) || (m_nMaxTasks != 0 && m_objQueue.Size() >= m_nMaxTasks))
+            {
+                m_objInstrumentation.OnReject();
+                return false;
+            }
+            m_objQueue.Push(std::move(objTask));
+            m_nPending.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_objInstrumentation.OnSubmit();
+        m_objIdle.NotifyOne();
+        return true;
+    }
+
+    /**
+     * Stop the pool.
+     * @param eMode How queued tasks are treated, SHUTDOWN_MODE_DRAIN_DEADLINE drains until nTimeoutMs.
+     * @param nTimeoutMs Drain deadline in milliseconds.
+     * @param funOnCancelled Called for every task that is dropped, after the lock is released.
+     * @return True if the pool was running.
+     * @note Called from one of its workers, every other worker is joined and the calling one is left
+     *       to a later Shutdown() or the destructor, which must then run on another thread.
+     */
+    template <class CancelOp = std::nullptr_t>
+    bool Shutdown(CYShutdownMode eMode, uint32_t nTimeoutMs = 0, CancelOp funOnCancelled = nullptr)
+    {
+        QueuePolicy objCancelled;
+        {
+            std::unique_lock<std::mutex> lock(m_objMutex);
+            if (m_lstWorker.empty() || m_bStopping.load(std::memory_order_relaxed))
+            {
+                // Stopped already, a worker left behind by an earlier call is joined now.
+                lock.unlock();
+                JoinWorkers();
+                return false;
+            }
+
+            m_bStopping.store(true, std::memory_order_relaxed);
+            if (eMode == CYShutdownMode::SHUTDOWN_MODE_DRAIN_DEADLINE)
+            {
+                (void)m_cvDrained.wait_for(lock, std::chrono::milliseconds(nTimeoutMs), [this] { return m_objQueue.Empty(); });
+            }
+            if (eMode != CYShutdownMode::SHUTDOWN_MODE_DRAIN)
+            {
+                while (!m_objQueue.Empty())
+                {
+                    objCancelled.Push(m_objQueue.Pop());
+                }
+                m_nPending.store(0, std::memory_order_relaxed);
+                m_objStopSource.request_stop();
+            }
+        }
+        m_objIdle.NotifyAll();
+        JoinWorkers();
+
+        if constexpr (!std::is_same_v<CancelOp, std::nullptr_t>)
+        {
+            if (eMode != CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE)
+            {
+                while (!objCancelled.Empty())
+                {
+                    TaskType objTask = objCancelled.Pop();
+                    funOnCancelled(objTask);
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Get the number of queued tasks.
+     * @return Tasks that did not start yet.
+     */
+    [[nodiscard]] size_t GetPendingTaskCount() const noexcept
+    {
+        return m_nPending.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the number of workers.
+     * @return Worker count.
+     */
+    [[nodiscard]] int GetMaxThreadCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        return static_cast<int>(m_lstWorker.size());
+    }
+
+    /**
+     * Get the index of the calling worker.
+     * @return Worker index, -1 if the caller is not a worker of this pool.
+     */
+    [[nodiscard]] int GetCurrentWorkerIndex() const noexcept
+    {
+        return s_pCurrentPool == this ? static_cast<int>(s_nCurrentWorker) : -1;
+    }
+
+    /**
+     * Get the instrumentation.
+     * @return Instrumentation instance shared by all workers.
+     */
+    [[nodiscard]] Instrumentation& GetInstrumentation() noexcept
+    {
+        return m_objInstrumentation;
+    }
+
+private:
+    /**
+     * Join every worker but the calling one, a thread cannot join itself. The workers are
+     * forgotten once all of them are joined, the pool can be started again then.
+     */
+    void JoinWorkers() noexcept
+    {
+        std::lock_guard<std::mutex> objJoinLock(m_objJoinMutex);
+        const int nCurrentWorker = GetCurrentWorkerIndex();
+        for (size_t i = 0; i < m_lstWorker.size(); ++i)
+        {
+            if (static_cast<int>(i) != nCurrentWorker && m_lstWorker[i].joinable())
+            {
+                m_lstWorker[i].join();
+            }
+        }
+
+        if (nCurrentWorker < 0)
+        {
+            std::lock_guard<std::mutex> lock(m_objMutex);
+            m_lstWorker.clear();
+        }
+    }
+
+    /**
+     * Worker body, runs queued tasks until the pool stops and the queue is empty.
+     * @param nWorker Worker index.
+     */
+    void WorkerLoop(size_t nWorker)
+    {
+        s_pCurrentPool = this;
+        s_nCurrentWorker = nWorker;
+        const CYStopToken objStopToken = m_objStopSource.get_token();
+
+        std::unique_lock<std::mutex> lock(m_objMutex);
+        for (;;)
+        {
+            m_objIdle.Wait(lock,
+                [this] { return !m_objQueue.Empty() || m_bStopping.load(std::memory_order_relaxed); },
+                [this] { return m_nPending.load(std::memory_order_relaxed) != 0 || m_bStopping.load(std::memory_order_relaxed); });
+            if (m_objQueue.Empty())
+            {
+                break;
+            }
+
+            TaskType objTask = m_objQueue.Pop();
+            m_nPending.fetch_sub(1, std::memory_order_relaxed);
+            if (m_objQueue.Empty() && m_bStopping.load(std::memory_order_relaxed))
+            {
+                m_cvDrained.notify_all();
+            }
+            lock.unlock();
+
+            m_objInstrumentation.OnTaskBegin(nWorker);
+            CYTaskInvoker<TaskType>::Invoke(objTask, objStopToken);
+            m_objInstrumentation.OnTaskEnd(nWorker);
+
+            lock.lock();
+        }
+
+        s_pCurrentPool = nullptr;
+    }
+
+private:
+    mutable std::mutex m_objMutex;
+    QueuePolicy m_objQueue;
+    IdlePolicy m_objIdle;
+    [[no_unique_address]] Instrumentation m_objInstrumentation;
+    std::condition_variable m_cvDrained;
+    std::vector<std::thread> m_lstWorker;
+    std::mutex m_objJoinMutex;
+    CYStopSource m_objStopSource;
+    size_t m_nMaxTasks{ 0 };
+
+    /**
+     * Mirrors the queue size, read without the lock by GetPendingTaskCount and spinning workers.
+     */
+    std::atomic<size_t> m_nPending{ 0 };
+    std::atomic<bool> m_bStopping{ false };
+
+    static inline thread_local const CYThreadPoolT* s_pCurrentPool{ nullptr };
+    static inline thread_local size_t s_nCurrentWorker{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_THREAD_POOL_T_HPP__
@@ -0,0 +1,152 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_WORKER_LOCAL_HPP__
+#define __CY_WORKER_LOCAL_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <vector>
+#include <utility>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Cache line size used to pad per-worker data.
+ */
+constexpr size_t CYTHREAD_CACHE_LINE_SIZE = 64;
+
+/**
+ * Worker Local Storage.
+ * Holds one instance of T per worker of a pool, each on its own cache line, plus one instance
+ * for threads that are not workers. A task only touches the instance of the worker running it,
+ * so no locks or shared atomics are needed; Combine() and Enumerate() reduce the instances once
+ * the tasks are done.
+ * @note The extra instance is shared by all non-worker threads, they must not use it concurrently.
+ */
+template <class T>
+class CYWorkerLocal
+{
+public:
+    /**
+     * Constructor.
+     * @param pThreadPool Pool whose workers own the instances.
+     * @param objInitial Value every instance starts with.
+     */
+    explicit CYWorkerLocal(ICYThreadPool* pThreadPool, const T& objInitial = T())
+        : m_pThreadPool(pThreadPool)
+        , m_lstSlot(static_cast<size_t>(pThreadPool ? pThreadPool->GetMaxThreadCount() : 0) + 1, CYSlot{ objInitial })
+    {
+    }
+
+    CYWorkerLocal(const CYWorkerLocal&) = delete;
+    CYWorkerLocal& operator=(const CYWorkerLocal&) = delete;
+
+public:
+    /**
+     * Get the instance of the calling worker.
+     * @return Instance of the worker, or the shared non-worker instance.
+     */
+    [[nodiscard]] T& Local() noexcept
+    {
+        const int nWorkerIndex = m_pThreadPool ? m_pThreadPool->GetCurrentWorkerIndex() : -1;
+        const size_t nSlot = nWorkerIndex >= 0 && static_cast<size_t>(nWorkerIndex) + 1 < m_lstSlot.size()
+            ? static_cast<size_t>(nWorkerIndex) : m_lstSlot.size() - 1;
+        return m_lstSlot[nSlot].objValue;
+    }
+
+    /**
+     * Fold all instances into one value.
+     * @param objInitial Start value of the fold.
+     * @param funCombine Binary operation, called as funCombine(accumulated, instance).
+     * @return Folded value.
+     * @note Call once the tasks that write the instances are finished.
+     */
+    template <class CombineOp>
+    [[nodiscard]] T Combine(T objInitial, CombineOp funCombine) const
+    {
+        for (const auto& objSlot : m_lstSlot)
+        {
+            objInitial = funCombine(std::move(objInitial), objSlot.objValue);
+        }
+        return objInitial;
+    }
+
+    /**
+     * Visit every instance.
+     * @param funVisit Called as funVisit(nSlot, instance), the last slot is the non-worker instance.
+     * @note Call once the tasks that write the instances are finished.
+     */
+    template <class VisitOp>
+    void Enumerate(VisitOp funVisit)
+    {
+        for (size_t nSlot = 0; nSlot < m_lstSlot.size(); ++nSlot)
+        {
+            funVisit(nSlot, m_lstSlot[nSlot].objValue);
+        }
+    }
+
+    /**
+     * Get the number of instances, one per worker plus the non-worker instance.
+     * @return Instance count.
+     */
+    [[nodiscard]] size_t GetSize() const noexcept
+    {
+        return m_lstSlot.size();
+    }
+
+private:
+    /**
+     * Instance padded to a full cache line so neighbouring workers never share one.
+     */
+    struct alignas(CYTHREAD_CACHE_LINE_SIZE) CYSlot
+    {
+        T objValue;
+    };
+
+    ICYThreadPool* m_pThreadPool{ nullptr };
+    std::vector<CYSlot> m_lstSlot;
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_WORKER_LOCAL_HPP__
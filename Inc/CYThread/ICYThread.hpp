@@ -44,10 +44,17 @@
 #define __I_CY_THREAD_HPP__
 
 #include "CYThreadDefine.hpp"
+#include "CYBarrier.hpp"
+#include "CYScratchArena.hpp"
+#include "CYLatencyHistogram.hpp"
 
 #include <thread>
+#include <chrono>
 #include <atomic>
 #include <functional>
+#include <memory_resource>
+#include <iosfwd>
+#include <vector>
 #include <stdexcept>
 
 #ifdef _WIN32
@@ -59,6 +66,9 @@
 
 CYTHRAD_NAMESPACE_BEGIN
 
+class CYTaskGroup;
+class CYThreadPool;
+
 /**
  * Thread Execution Properties.
  */
@@ -202,6 +212,74 @@ protected:
     int						m_nTasksIdealCore{ 0 };
 };
 
+class ICYIThreadableObject;
+
+/**
+ * Tagged record of a queued task, function and object tasks wait in the same queue through it.
+ */
+struct CYTaskRecord
+{
+    CYTaskRecord* pPrev{ nullptr };
+    CYTaskRecord* pNext{ nullptr };
+
+    /**
+     * Links among the queued records of the same group, so cancelling a group only visits its own records.
+     */
+    CYTaskRecord* pGroupPrev{ nullptr };
+    CYTaskRecord* pGroupNext{ nullptr };
+
+    /**
+     * Group the task was submitted through.
+     */
+    CYTaskGroup* pTaskGroup{ nullptr };
+
+    /**
+     * Dispatch passes that skipped the task while waiting for its preferred worker.
+     */
+    uint32_t nAffinitySkips{ 0 };
+
+    /**
+     * Steady clock time in nanoseconds at which the task was queued, 0 for a task queued again.
+     */
+    uint64_t nEnqueueNs{ 0 };
+
+    /**
+     * What the record is embedded in.
+     */
+    CYTaskKind eKind{ CYTaskKind::TASK_KIND_FUNCTION };
+
+    /**
+     * Tag of the task, CYTHREAD_NO_TAG for none.
+     */
+    CYTaskTag nTag{ CYTHREAD_NO_TAG };
+
+    /**
+     * Set once a dispatch pass found no worker for the task.
+     */
+    bool bMissed{ false };
+};
+
+/**
+ * Links of an object queued in a pool, so queueing an object never allocates.
+ * The links belong to the pool, copying or moving an object never copies them.
+ */
+struct CYObjectQueueHook : CYTaskRecord
+{
+    CYObjectQueueHook() noexcept { eKind = CYTaskKind::TASK_KIND_OBJECT; }
+    CYObjectQueueHook(const CYObjectQueueHook&) noexcept : CYObjectQueueHook() {}
+    CYObjectQueueHook& operator=(const CYObjectQueueHook&) noexcept { return *this; }
+
+    /**
+     * The object while it is queued, nullptr otherwise.
+     */
+    ICYIThreadableObject* pObject{ nullptr };
+
+    /**
+     * Claimed by the submitting thread before it links the object, an object is queued at most once.
+     */
+    std::atomic<bool> bQueued{ false };
+};
+
 /**
  * Thread Object.
  */
@@ -222,6 +300,17 @@ public:
      */
     virtual void TaskToExecute() = 0;
 
+    /**
+     * Cancellable variant called by the pool, override it to observe stop requests.
+     * @param objStopToken Signalled by TerminateWorkingThread, group cancellation or shutdown.
+     * @note Forwards to TaskToExecute(), which every object still has to provide.
+     */
+    virtual void TaskToExecute(const CYStopToken& objStopToken)
+    {
+        (void)objStopToken;
+        TaskToExecute();
+    }
+
     /**
      * Function member to retrieve the id for an object for access through object registry.
      */
@@ -238,6 +327,44 @@ public:
         return &m_objTaskExecutionProps;
     }
 
+    /**
+     * Objects with the same key prefer the same worker, CYTHREAD_NO_AFFINITY_KEY sticks to the last worker.
+     */
+    [[nodiscard]] virtual uint64_t GetAffinityKey() const
+    {
+        return CYTHREAD_NO_AFFINITY_KEY;
+    }
+
+    /**
+     * Tag the pool keeps statistics for, it must not change while the object is queued or running.
+     */
+    [[nodiscard]] virtual CYTaskTag GetTag() const
+    {
+        return CYTHREAD_NO_TAG;
+    }
+
+    /**
+     * Index of the worker that last ran the object, -1 if it never ran.
+     */
+    [[nodiscard]] int GetLastWorker() const noexcept
+    {
+        return m_nLastWorker;
+    }
+
+private:
+    friend class CYThreadPool;
+    friend class CYTaskScope;
+
+    /**
+     * Written by the pool when it dispatches the object.
+     */
+    int m_nLastWorker{ -1 };
+
+    /**
+     * Links into the queue of the pool while the object is pending.
+     */
+    CYObjectQueueHook m_objQueueHook;
+
 protected:
     /**
      * Tasks execution properties.
@@ -250,6 +377,189 @@ protected:
     uint32_t m_nObjectId;
 };
 
+/**
+ * Callback invoked for every pending task dropped by a cancelling shutdown.
+ * Exactly one of pTask / pObject is non-null.
+ */
+using CYCancelledTaskCallback = std::function<void(const CYThreadTask* pTask, ICYIThreadableObject* pObject)>;
+
+/**
+ * Worker lifecycle hook, runs on the worker thread itself.
+ */
+using CYWorkerHook = std::function<void(int nWorkerIndex)>;
+
+/**
+ * Thread Pool Creation Options.
+ */
+struct CYTHREAD_API CYThreadPoolOptions
+{
+    /**
+     * Runs on every worker before it takes its first task.
+     */
+    CYWorkerHook funOnWorkerStart;
+
+    /**
+     * Runs on every worker after its last task, right before the thread exits.
+     */
+    CYWorkerHook funOnWorkerStop;
+
+    /**
+     * When the workers reset their scratch arena.
+     */
+    CYArenaResetMode eScratchResetMode{ CYArenaResetMode::RESET_PER_TASK };
+
+    /**
+     * Size of the first block of every scratch arena.
+     */
+    size_t nScratchBlockSize{ CYScratchArena::DEFAULT_BLOCK_SIZE };
+
+    /**
+     * Order in which queued function and object tasks are handed out.
+     */
+    CYTaskOrder eTaskOrder{ CYTaskOrder::TASK_ORDER_FIFO };
+
+    /**
+     * How the workers are created.
+     */
+    CYWorkerSpawnMode eSpawnMode{ CYWorkerSpawnMode::SPAWN_MODE_EAGER };
+
+    /**
+     * Trace events kept per worker, the oldest are overwritten. 0 leaves tracing off.
+     */
+    size_t nTraceCapacity{ 0 };
+
+    /**
+     * Read per-worker performance counters around every task, see GetPerfStats.
+     */
+    bool bPerfCounters{ false };
+
+    /**
+     * Read thread CPU time and wall time around every task, see GetPerfStats.
+     */
+    bool bCpuTime{ false };
+
+    /**
+     * Memory resource of the pool-internal queues, task nodes, timers and batches.
+     * nullptr uses std::pmr::get_default_resource(), the resource must outlive the pool.
+     */
+    std::pmr::memory_resource* pMemoryResource{ nullptr };
+};
+
+/**
+ * Thread Pool Metrics.
+ * Snapshot of the counters and histograms every worker keeps for itself, merged when read.
+ * Queue wait runs from queueing until a worker takes the task, execution from start to return.
+ * @note Compact tasks are counted, but carry no queue time and share the execution time of their chunk.
+ */
+struct CYTHREAD_API CYThreadPoolMetrics
+{
+    uint64_t nSubmitted{ 0 };
+    uint64_t nStarted{ 0 };
+    uint64_t nCompleted{ 0 };
+    uint64_t nRejected{ 0 };
+
+    /**
+     * Tasks of every kind waiting in the queues when the snapshot was taken.
+     */
+    size_t nQueueDepth{ 0 };
+
+    /**
+     * Queue wait and execution time in nanoseconds.
+     */
+    CYLatencyHistogram objQueueWait;
+    CYLatencyHistogram objExecution;
+};
+
+/**
+ * Task Performance Counters.
+ * Sums of the counter deltas a worker read around every task of one type.
+ * @note Counters the system refused to open stay 0, their bit in nCounterMask is clear.
+ */
+struct CYTHREAD_API CYTaskPerfStats
+{
+    /**
+     * Type name of the task object or callable, as reported by std::type_info::name().
+     */
+    const char* pszTaskType{ nullptr };
+    uint64_t nTaskCount{ 0 };
+    uint64_t arrCounter[static_cast<size_t>(CYPerfCounter::PERF_COUNTER_COUNT)]{};
+
+    /**
+     * Bit (1 << counter) is set for every counter measured on all tasks of the type.
+     */
+    uint32_t nCounterMask{ 0 };
+
+    [[nodiscard]] bool HasCounter(CYPerfCounter eCounter) const noexcept
+    {
+        return (nCounterMask & (1u << static_cast<uint32_t>(eCounter))) != 0;
+    }
+
+    [[nodiscard]] uint64_t GetCounter(CYPerfCounter eCounter) const noexcept
+    {
+        return arrCounter[static_cast<size_t>(eCounter)];
+    }
+
+    /**
+     * Get the share of wall time the tasks spent on a CPU.
+     * @return CPU time divided by wall time, low for tasks that block on I/O or locks, 0 without CPU time.
+     */
+    [[nodiscard]] double GetCpuRatio() const noexcept
+    {
+        const uint64_t nWallTimeNs = GetCounter(CYPerfCounter::PERF_COUNTER_WALL_TIME);
+        return nWallTimeNs ? static_cast<double>(GetCounter(CYPerfCounter::PERF_COUNTER_CPU_TIME)) / static_cast<double>(nWallTimeNs) : 0.0;
+    }
+};
+
+/**
+ * Task Tag Statistics.
+ * Snapshot of the counters a pool keeps for one tag, times are sums in nanoseconds.
+ * @note CPU time is only recorded when the pool reads it, see CYThreadPoolOptions::bCpuTime.
+ */
+struct CYTHREAD_API CYTaskTagStats
+{
+    CYTaskTag nTag{ CYTHREAD_NO_TAG };
+    uint64_t nSubmitted{ 0 };
+    uint64_t nCompleted{ 0 };
+    uint64_t nCancelled{ 0 };
+    uint64_t nRejected{ 0 };
+
+    /**
+     * Tasks queued or running when the snapshot was taken.
+     */
+    uint64_t nPending{ 0 };
+    uint64_t nRunning{ 0 };
+
+    uint64_t nQueueWaitNs{ 0 };
+    uint64_t nMaxQueueWaitNs{ 0 };
+    uint64_t nExecutionNs{ 0 };
+    uint64_t nCpuTimeNs{ 0 };
+
+    /**
+     * Most tasks of the tag running at once, 0 for no limit.
+     */
+    uint32_t nConcurrencyLimit{ 0 };
+
+    [[nodiscard]] uint64_t GetMeanQueueWaitNs() const noexcept
+    {
+        const uint64_t nStarted = nCompleted + nRunning;
+        return nStarted ? nQueueWaitNs / nStarted : 0;
+    }
+
+    [[nodiscard]] uint64_t GetMeanExecutionNs() const noexcept
+    {
+        return nCompleted ? nExecutionNs / nCompleted : 0;
+    }
+
+    /**
+     * Get the share of execution time the tasks spent on a CPU.
+     * @return CPU time divided by execution time, 0 without CPU time.
+     */
+    [[nodiscard]] double GetCpuRatio() const noexcept
+    {
+        return nExecutionNs ? static_cast<double>(nCpuTimeNs) / static_cast<double>(nExecutionNs) : 0.0;
+    }
+};
+
 /**
  * Thread Pool Interface.
  */
@@ -270,6 +580,11 @@ public:
      */
     virtual bool CreateThreadPool(const CYPlatformId& eThreadType, int iMaxThread = 10) = 0;
 
+    /**
+     * Create thread pool with specified platform, max threads and creation options.
+     */
+    virtual bool CreateThreadPool(const CYPlatformId& eThreadType, int iMaxThread, const CYThreadPoolOptions& objOptions) = 0;
+
     /**
      * Submit a objTask to the pool.
      */
@@ -280,6 +595,86 @@ public:
      */
     virtual bool SubmitTask(ICYIThreadableObject* pInvokingObject) = 0;
 
+    /**
+     * Submit a objTask on behalf of a task group.
+     */
+    virtual bool SubmitTask(const CYThreadTask& objTask, CYTaskGroup* pTaskGroup) = 0;
+
+    /**
+     * Submit an object objTask on behalf of a task group.
+     */
+    virtual bool SubmitTask(ICYIThreadableObject* pInvokingObject, CYTaskGroup* pTaskGroup) = 0;
+
+    /**
+     * Discard the queued tasks of a cancelled group and signal the running ones.
+     */
+    virtual void CancelTaskGroup(CYTaskGroup* pTaskGroup) noexcept = 0;
+
+    /**
+     * Run the oldest queued task on the calling thread.
+     */
+    virtual bool ExecutePendingTask() noexcept = 0;
+
+    /**
+     * Submit a compact objTask, a function pointer plus its context.
+     */
+    virtual bool SubmitCompactTask(CYCompactTaskProc pfnTask, void* pContext) noexcept = 0;
+
+    /**
+     * Submit compact tasks in bulk.
+     */
+    virtual size_t SubmitCompactTasks(const CYCompactTask* pTasks, size_t nCount) noexcept = 0;
+
+    /**
+     * Submit a objTask once the delay has elapsed.
+     */
+    virtual CYTimerId SubmitAfter(std::chrono::milliseconds nDelay, const CYThreadTask& objTask) = 0;
+
+    /**
+     * Submit a objTask at the given time point.
+     */
+    virtual CYTimerId SubmitAt(std::chrono::steady_clock::time_point tpWhen, const CYThreadTask& objTask) = 0;
+
+    /**
+     * Submit a objTask every period until the timer is cancelled.
+     */
+    virtual CYTimerId SubmitEvery(std::chrono::milliseconds nPeriod, const CYThreadTask& objTask) = 0;
+
+    /**
+     * Cancel a delayed or periodic objTask that has not fired yet.
+     */
+    virtual bool CancelTimer(CYTimerId nTimerId) noexcept = 0;
+
+    /**
+     * Coalesce consecutive tiny tasks into batches that a worker runs back-to-back.
+     */
+    virtual void SetTaskBatching(bool bEnable, uint32_t nMaxLatencyUs = 1000) noexcept = 0;
+
+    /**
+     * Submit a objTask that only the given worker may run.
+     */
+    virtual bool SubmitToWorker(int nWorkerIndex, const CYThreadTask& objTask) noexcept = 0;
+
+    /**
+     * Get the index of the worker running the calling thread, -1 outside the pool's workers.
+     */
+    virtual int GetCurrentWorkerIndex() const noexcept = 0;
+
+    /**
+     * Run a kernel on every worker at once and wait until all of them returned.
+     */
+    virtual bool RunOnAllWorkers(const CYParallelKernel& funKernel) = 0;
+
+    /**
+     * Start a new scratch frame, every worker resets its arena before its next task.
+     */
+    virtual void AdvanceScratchFrame() noexcept = 0;
+
+    /**
+     * Create missing workers, touch their stacks and fill their caches ahead of the first tasks.
+     */
+    virtual bool Prewarm(size_t nStackBytes = CYTHREAD_PREWARM_STACK_SIZE) noexcept = 0;
+
     /**
      * Check if any threads are working.
      */
@@ -305,6 +700,41 @@ public:
      */
     virtual int GetTasksMissedCount() const noexcept = 0;
 
+    /**
+     * Get submitted, started, completed and rejected counts, queue depth and latency histograms.
+     */
+    virtual CYThreadPoolMetrics GetMetrics() const noexcept = 0;
+
+    /**
+     * Write the recorded submit, dispatch, task and idle events as Chrome trace JSON.
+     */
+    virtual bool WriteTrace(std::ostream& objStream) const noexcept = 0;
+
+    /**
+     * Get the performance counters and CPU time of the finished tasks, summed per task type.
+     */
+    virtual std::vector<CYTaskPerfStats> GetPerfStats() const noexcept = 0;
+
+    /**
+     * Get counts, latencies and CPU time of every tag seen so far.
+     */
+    virtual std::vector<CYTaskTagStats> GetTagStats() const noexcept = 0;
+
+    /**
+     * Wait until no task of the tag is queued or running, returns 0 when idle and 1 on timeout.
+     */
+    virtual uint32_t WaitForTag(CYTaskTag nTag, uint32_t nTimeoutMs = UINT32_MAX) noexcept = 0;
+
+    /**
+     * Drop the queued tasks of a tag and signal the running ones, returns the number dropped.
+     */
+    virtual size_t CancelTag(CYTaskTag nTag) noexcept = 0;
+
+    /**
+     * Limit how many tasks of a tag run at once, 0 removes the limit.
+     */
+    virtual bool SetTagConcurrency(CYTaskTag nTag, uint32_t nMaxRunning) noexcept = 0;
+
     /**
      * Get nAvailable thread count.
      */
@@ -346,7 +776,7 @@ public:
     virtual void ResumeWorkingThread(ICYIThreadableObject* pInvokingObject) noexcept = 0;
 
     /**
-     * Terminate specific working thread.
+     * Terminate specific working thread: drop it if still queued, otherwise signal its stop token.
      */
     virtual void TerminateWorkingThread(ICYIThreadableObject* pInvokingObject) noexcept = 0;
 
@@ -359,6 +789,11 @@ public:
      * Wait for thread completion.
      */
     virtual uint32_t WaitForSingleObject(ICYIThreadableObject* pInvokingObject, uint32_t timeout) const noexcept = 0;
+
+    /**
+     * Shutdown the pool using the given mode.
+     */
+    virtual bool Shutdown(CYShutdownMode eMode, uint32_t nTimeoutMs = 0, const CYCancelledTaskCallback& funOnCancelled = nullptr) noexcept = 0;
 };
 
 CYTHRAD_NAMESPACE_END
@@ -0,0 +1,48 @@
+#include "CYThreadPCH.hpp"
+#include "CYThread/CYBarrier.hpp"
+#include <thread>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Constructor.
+ * @param nParticipants Threads that have to arrive before the barrier opens.
+ */
+CYBarrier::CYBarrier(int nParticipants) noexcept
+    : m_nParticipants(nParticipants)
+    , m_nRemaining(nParticipants)
+{
+}
+
+/**
+ * Arrive at the barrier and wait until every participant arrived.
+ * @note Spins briefly before it blocks, phases are usually short.
+ */
+void CYBarrier::ArriveAndWait() noexcept
+{
+    // The global sense cannot flip before this participant arrived, so reading it here is safe.
+    const bool bLocalSense = !m_bSense.load(std::memory_order_relaxed);
+
+    if (m_nRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        m_nRemaining.store(m_nParticipants, std::memory_order_relaxed);
+        m_bSense.store(bLocalSense, std::memory_order_release);
+        m_bSense.notify_all();
+        return;
+    }
+
+    for (int nSpin = 0; nSpin < SPIN_COUNT; ++nSpin)
+    {
+        if (m_bSense.load(std::memory_order_acquire) == bLocalSense)
+        {
+            return;
+        }
+    }
+
+    while (m_bSense.load(std::memory_order_acquire) != bLocalSense)
+    {
+        m_bSense.wait(!bLocalSense, std::memory_order_acquire);
+    }
+}
+
+CYTHRAD_NAMESPACE_END
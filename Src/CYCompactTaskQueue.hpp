@@ -0,0 +1,293 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_COMPACT_TASK_QUEUE_HPP__
+#define __CY_COMPACT_TASK_QUEUE_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Compact Task Queue.
+ * FIFO of CYCompactTask descriptors stored in fixed-size segments, so a backlog of millions of
+ * tasks costs two pointers per task and is read sequentially while dispatching. One drained
+ * segment is kept as a spare, a queue that fills and empties repeatedly does not allocate.
+ * @note Not thread-safe, the owning pool serializes access.
+ */
+class CYCompactTaskQueue
+{
+public:
+    /**
+     * Descriptors per segment.
+     */
+    static constexpr size_t SEGMENT_SIZE = 4096;
+
+    CYCompactTaskQueue() = default;
+
+    ~CYCompactTaskQueue()
+    {
+        FreeChain(m_pHead);
+        FreeChain(m_pSpare);
+    }
+
+    CYCompactTaskQueue(const CYCompactTaskQueue&) = delete;
+    CYCompactTaskQueue& operator=(const CYCompactTaskQueue&) = delete;
+
+public:
+    /**
+     * Set the memory resource segments are allocated from.
+     * @param pMemoryResource Memory resource, nullptr for std::pmr::get_default_resource().
+     * @return True if applied, false once the queue has allocated, it keeps its resource then.
+     */
+    bool SetMemoryResource(std::pmr::memory_resource* pMemoryResource) noexcept
+    {
+        if (m_pHead || m_pSpare)
+        {
+            return false;
+        }
+        m_pMemoryResource = pMemoryResource ? pMemoryResource : std::pmr::get_default_resource();
+        return true;
+    }
+
+    /**
+     * Get the memory resource segments are allocated from.
+     * @return Memory resource.
+     */
+    [[nodiscard]] std::pmr::memory_resource* GetMemoryResource() const noexcept
+    {
+        return m_pMemoryResource;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_nSize; }
+    [[nodiscard]] bool Empty() const noexcept { return m_nSize == 0; }
+
+    /**
+     * Append descriptors at the back.
+     * @param pTasks Descriptors to append.
+     * @param nCount Number of descriptors.
+     * @return Number appended, less than nCount only if the system is out of memory.
+     */
+    size_t Push(const CYCompactTask* pTasks, size_t nCount) noexcept
+    {
+        size_t nPushed = 0;
+        while (nPushed < nCount)
+        {
+            if (!m_pTail || m_pTail->nWrite == SEGMENT_SIZE)
+            {
+                CYSegment* pSegment = AcquireSegment();
+                if (!pSegment)
+                {
+                    break;
+                }
+                if (m_pTail)
+                {
+                    m_pTail->pNext = pSegment;
+                }
+                else
+                {
+                    m_pHead = pSegment;
+                }
+                m_pTail = pSegment;
+            }
+
+            const size_t nCopy = std::min(nCount - nPushed, SEGMENT_SIZE - m_pTail->nWrite);
+            std::copy_n(pTasks + nPushed, nCopy, m_pTail->arrTask + m_pTail->nWrite);
+            m_pTail->nWrite += nCopy;
+            nPushed += nCopy;
+        }
+        m_nSize += nPushed;
+        return nPushed;
+    }
+
+    /**
+     * Take descriptors from the front.
+     * @param pTasks Receives the descriptors, oldest first.
+     * @param nMaxCount Capacity of pTasks.
+     * @return Number taken, zero if the queue is empty.
+     */
+    size_t Pop(CYCompactTask* pTasks, size_t nMaxCount) noexcept
+    {
+        size_t nPopped = 0;
+        while (nPopped < nMaxCount && m_pHead)
+        {
+            const size_t nCopy = std::min(nMaxCount - nPopped, m_pHead->nWrite - m_pHead->nRead);
+            std::copy_n(m_pHead->arrTask + m_pHead->nRead, nCopy, pTasks + nPopped);
+            m_pHead->nRead += nCopy;
+            nPopped += nCopy;
+
+            // A drained segment goes back right away, a later push starts a fresh one.
+            if (m_pHead->nRead == m_pHead->nWrite)
+            {
+                CYSegment* pSegment = m_pHead;
+                m_pHead = pSegment->pNext;
+                if (!m_pHead)
+                {
+                    m_pTail = nullptr;
+                }
+                ReleaseSegment(pSegment);
+            }
+        }
+        m_nSize -= nPopped;
+        return nPopped;
+    }
+
+    /**
+     * Move every descriptor of another queue to the back of this one.
+     * @param lstOther Queue to empty, it must use the same memory resource.
+     */
+    void SpliceBack(CYCompactTaskQueue& lstOther) noexcept
+    {
+        if (!lstOther.m_pHead)
+        {
+            return;
+        }
+        if (m_pTail)
+        {
+            // Segments are read up to nWrite, a partly filled tail may sit in the middle.
+            m_pTail->pNext = lstOther.m_pHead;
+        }
+        else
+        {
+            m_pHead = lstOther.m_pHead;
+        }
+        m_pTail = lstOther.m_pTail;
+        m_nSize += lstOther.m_nSize;
+
+        lstOther.m_pHead = lstOther.m_pTail = nullptr;
+        lstOther.m_nSize = 0;
+    }
+
+    /**
+     * Keep a spare segment ready, so the first push does not allocate.
+     */
+    void Reserve() noexcept
+    {
+        if (!m_pSpare)
+        {
+            m_pSpare = AcquireSegment();
+        }
+    }
+
+    /**
+     * Drop every descriptor.
+     */
+    void Clear() noexcept
+    {
+        while (m_pHead)
+        {
+            CYSegment* pSegment = m_pHead;
+            m_pHead = pSegment->pNext;
+            ReleaseSegment(pSegment);
+        }
+        m_pTail = nullptr;
+        m_nSize = 0;
+    }
+
+private:
+    /**
+     * Segment of descriptors, read from nRead up to nWrite.
+     */
+    struct CYSegment
+    {
+        CYSegment* pNext{ nullptr };
+        size_t nRead{ 0 };
+        size_t nWrite{ 0 };
+        CYCompactTask arrTask[SEGMENT_SIZE];
+    };
+
+    [[nodiscard]] CYSegment* AcquireSegment() noexcept
+    {
+        if (CYSegment* pSegment = m_pSpare)
+        {
+            m_pSpare = nullptr;
+            return pSegment;
+        }
+
+        try
+        {
+            return ::new (m_pMemoryResource->allocate(sizeof(CYSegment), alignof(CYSegment))) CYSegment;
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+    void ReleaseSegment(CYSegment* pSegment) noexcept
+    {
+        if (!m_pSpare)
+        {
+            pSegment->pNext = nullptr;
+            pSegment->nRead = pSegment->nWrite = 0;
+            m_pSpare = pSegment;
+            return;
+        }
+        pSegment->~CYSegment();
+        m_pMemoryResource->deallocate(pSegment, sizeof(CYSegment), alignof(CYSegment));
+    }
+
+    void FreeChain(CYSegment* pSegment) noexcept
+    {
+        while (pSegment)
+        {
+            CYSegment* pNext = pSegment->pNext;
+            pSegment->~CYSegment();
+            m_pMemoryResource->deallocate(pSegment, sizeof(CYSegment), alignof(CYSegment));
+            pSegment = pNext;
+        }
+    }
+
+    std::pmr::memory_resource* m_pMemoryResource{ std::pmr::get_default_resource() };
+    CYSegment* m_pHead{ nullptr };
+    CYSegment* m_pTail{ nullptr };
+    CYSegment* m_pSpare{ nullptr };
+    size_t m_nSize{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_COMPACT_TASK_QUEUE_HPP__
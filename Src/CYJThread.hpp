@@ -47,35 +47,6 @@
 
 #include <thread>
 
-#if defined(__has_include)
-#  if __has_include(<stop_token>)
-#    if defined(__APPLE__)
-#      if (defined(__MAC_OS_X_VERSION_MIN_REQUIRED) && __MAC_OS_X_VERSION_MIN_REQUIRED >= 110000) || \
-          (defined(__IPHONE_OS_VERSION_MIN_REQUIRED) && __IPHONE_OS_VERSION_MIN_REQUIRED >= 140000) || \
-          (defined(__TV_OS_VERSION_MIN_REQUIRED) && __TV_OS_VERSION_MIN_REQUIRED >= 140000) || \
-          (defined(__WATCH_OS_VERSION_MIN_REQUIRED) && __WATCH_OS_VERSION_MIN_REQUIRED >= 70000)
-#        define CYTHREAD_HAS_STD_STOP_TOKEN 1
-#      else
-#        define CYTHREAD_HAS_STD_STOP_TOKEN 0
-#      endif
-#    else
-#      define CYTHREAD_HAS_STD_STOP_TOKEN 1
-#    endif
-#  else
-#    define CYTHREAD_HAS_STD_STOP_TOKEN 0
-#  endif
-#else
-#  define CYTHREAD_HAS_STD_STOP_TOKEN 1
-#endif
-
-#if defined(__ANDROID__) && !defined(CYTHREAD_FORCE_STD_STOP_TOKEN)
-#  undef CYTHREAD_HAS_STD_STOP_TOKEN
-#  define CYTHREAD_HAS_STD_STOP_TOKEN 0
-#endif
-
-#if CYTHREAD_HAS_STD_STOP_TOKEN
-#  include <stop_token>
-#endif
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -86,60 +57,6 @@
 
 CYTHRAD_NAMESPACE_BEGIN
 
-namespace detail
-{
-#if CYTHREAD_HAS_STD_STOP_TOKEN
-    using stop_token = std::stop_token;
-    using stop_source = std::stop_source;
-#else
-    class stop_state
-    {
-    public:
-        void request_stop() noexcept { m_flag.store(true, std::memory_order_release); }
-        [[nodiscard]] bool stop_requested() const noexcept { return m_flag.load(std::memory_order_acquire); }
-    private:
-        std::atomic<bool> m_flag{ false };
-    };
-
-    class stop_token
-    {
-    public:
-        stop_token() noexcept = default;
-        explicit stop_token(std::shared_ptr<stop_state> state) noexcept : m_state(std::move(state)) {}
-        [[nodiscard]] bool stop_requested() const noexcept
-        {
-            return m_state ? m_state->stop_requested() : false;
-        }
-    private:
-        std::shared_ptr<stop_state> m_state;
-        friend class stop_source;
-    };
-
-    class stop_source
-    {
-    public:
-        stop_source()
-            : m_state(std::make_shared<stop_state>())
-        {
-        }
-
-        stop_token get_token() const noexcept { return stop_token(m_state); }
-        void request_stop() noexcept
-        {
-            if (m_state)
-            {
-                m_state->request_stop();
-            }
-        }
-    private:
-        std::shared_ptr<stop_state> m_state;
-    };
-#endif
-} // namespace detail
-
-using CYStopToken = detail::stop_token;
-using CYStopSource = detail::stop_source;
-
 #if 0 //defined(CYTHREAD_WIN_OS)
 using CYJThread = std::jthread;
 #else
@@ -0,0 +1,273 @@
+#include "CYThreadPCH.hpp"
+#include "CYPerfCounters.hpp"
+#include "CYPoolMetrics.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+CYTHRAD_NAMESPACE_BEGIN
+
+namespace
+{
+#if defined(__linux__)
+    /**
+     * Open one counter of the calling thread.
+     * @return Descriptor, -1 if the counter is not available.
+     */
+    int OpenCounter(uint32_t nType, uint64_t nConfig, int nGroupFd) noexcept
+    {
+        perf_event_attr objAttr;
+        std::memset(&objAttr, 0, sizeof(objAttr));
+        objAttr.size = sizeof(objAttr);
+        objAttr.type = nType;
+        objAttr.config = nConfig;
+        objAttr.exclude_hv = 1;
+        objAttr.read_format = PERF_FORMAT_GROUP;
+
+        // Without the privilege to count kernel time only user time is counted.
+        int nFd = static_cast<int>(syscall(SYS_perf_event_open, &objAttr, 0, -1, nGroupFd, 0));
+        if (nFd < 0)
+        {
+            objAttr.exclude_kernel = 1;
+            nFd = static_cast<int>(syscall(SYS_perf_event_open, &objAttr, 0, -1, nGroupFd, 0));
+        }
+        return nFd;
+    }
+#endif
+}
+
+/**
+ * Constructor.
+ * @param bPerfEvents True to open the perf_event_open counters.
+ * @param bCpuTime True to read CPU time and wall time.
+ * @param pMemoryResource Resource the per-type sums are allocated from.
+ */
+CYPerfCounters::CYPerfCounters(bool bPerfEvents, bool bCpuTime, std::pmr::memory_resource* pMemoryResource)
+    : m_bPerfEvents(bPerfEvents)
+    , m_bCpuTime(bCpuTime)
+    , m_mapStats(pMemoryResource)
+{
+    std::fill(std::begin(m_arrFd), std::end(m_arrFd), -1);
+}
+
+/**
+ * Destructor.
+ */
+CYPerfCounters::~CYPerfCounters()
+{
+    Close();
+}
+
+/**
+ * Open the counters for the calling thread.
+ * @return True if at least one counter could be opened.
+ */
+bool CYPerfCounters::Open() noexcept
+{
+    Close();
+    if (m_bCpuTime)
+    {
+        m_nCounterMask |= 1u << static_cast<uint32_t>(CYPerfCounter::PERF_COUNTER_CPU_TIME);
+        m_nCounterMask |= 1u << static_cast<uint32_t>(CYPerfCounter::PERF_COUNTER_WALL_TIME);
+    }
+#if defined(__linux__)
+    struct CounterDesc
+    {
+        uint32_t nType;
+        uint64_t nConfig;
+    };
+    // Hardware counters first, so that one of them leads the group when it exists.
+    static constexpr CounterDesc arrDesc[] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+    };
+
+    for (size_t nCounter = 0; m_bPerfEvents && nCounter < std::size(arrDesc); ++nCounter)
+    {
+        m_arrFd[nCounter] = OpenCounter(arrDesc[nCounter].nType, arrDesc[nCounter].nConfig, m_nGroupFd);
+        if (m_arrFd[nCounter] < 0)
+        {
+            continue;
+        }
+        if (m_nGroupFd < 0)
+        {
+            m_nGroupFd = m_arrFd[nCounter];
+        }
+        m_nCounterMask |= 1u << nCounter;
+    }
+#endif
+    return IsOpen();
+}
+
+/**
+ * Close the counters, the sums are kept.
+ */
+void CYPerfCounters::Close() noexcept
+{
+#if defined(__linux__)
+    // Members first, the group leader goes last.
+    for (size_t nCounter = COUNTER_COUNT; nCounter-- > 0;)
+    {
+        if (m_arrFd[nCounter] >= 0 && m_arrFd[nCounter] != m_nGroupFd)
+        {
+            ::close(m_arrFd[nCounter]);
+        }
+    }
+    if (m_nGroupFd >= 0)
+    {
+        ::close(m_nGroupFd);
+    }
+#endif
+    std::fill(std::begin(m_arrFd), std::end(m_arrFd), -1);
+    m_nGroupFd = -1;
+    m_nCounterMask = 0;
+    m_pSampleType = nullptr;
+}
+
+/**
+ * Read the counters before a task.
+ * @param objTaskType Type of the task object or callable.
+ */
+void CYPerfCounters::BeginSample(const std::type_info& objTaskType) noexcept
+{
+    m_pSampleType = IsOpen() && Read(m_arrStart) ? &objTaskType : nullptr;
+}
+
+/**
+ * Read the counters after the task and add the deltas to the sums of its type.
+ */
+void CYPerfCounters::EndSample() noexcept
+{
+    if (!m_pSampleType)
+    {
+        return;
+    }
+
+    uint64_t arrEnd[COUNTER_COUNT];
+    const bool bRead = Read(arrEnd);
+    const std::type_info& objTaskType = *m_pSampleType;
+    m_pSampleType = nullptr;
+    if (!bRead)
+    {
+        return;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        auto& objStats = m_mapStats[std::type_index(objTaskType)];
+        objStats.pszTaskType = objTaskType.name();
+        objStats.nCounterMask = m_nCounterMask;
+        ++objStats.nTaskCount;
+        for (size_t nCounter = 0; nCounter < COUNTER_COUNT; ++nCounter)
+        {
+            objStats.arrCounter[nCounter] += arrEnd[nCounter] - m_arrStart[nCounter];
+        }
+    }
+    catch (const std::exception&)
+    {
+    }
+}
+
+/**
+ * Add the sums of this worker to a per-type collection.
+ * @param mapStats Sums per task type, merged into.
+ */
+void CYPerfCounters::Collect(std::unordered_map<std::type_index, CYTaskPerfStats>& mapStats) const
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    for (const auto& [objType, objStats] : m_mapStats)
+    {
+        auto& objTotal = mapStats[objType];
+        // A counter only counts for the type if every worker that ran it had the counter.
+        objTotal.nCounterMask = objTotal.nTaskCount ? objTotal.nCounterMask & objStats.nCounterMask : objStats.nCounterMask;
+        objTotal.pszTaskType = objStats.pszTaskType;
+        objTotal.nTaskCount += objStats.nTaskCount;
+        for (size_t nCounter = 0; nCounter < COUNTER_COUNT; ++nCounter)
+        {
+            objTotal.arrCounter[nCounter] += objStats.arrCounter[nCounter];
+        }
+    }
+}
+
+/**
+ * Read every open counter.
+ * @param arrValue Receives the values, in CYPerfCounter order.
+ * @return True if the group could be read.
+ */
+bool CYPerfCounters::Read(uint64_t (&arrValue)[COUNTER_COUNT]) const noexcept
+{
+    std::fill(std::begin(arrValue), std::end(arrValue), 0);
+    if (m_nCounterMask & (1u << static_cast<uint32_t>(CYPerfCounter::PERF_COUNTER_CPU_TIME)))
+    {
+        arrValue[static_cast<size_t>(CYPerfCounter::PERF_COUNTER_CPU_TIME)] = GetThreadCpuTimeNs();
+        arrValue[static_cast<size_t>(CYPerfCounter::PERF_COUNTER_WALL_TIME)] = CYPoolMetrics::GetTimeNs();
+    }
+
+#if defined(__linux__)
+    if (m_nGroupFd < 0)
+    {
+        return true;
+    }
+
+    // PERF_FORMAT_GROUP: the number of counters, then their values in the order they joined.
+    uint64_t arrBuffer[COUNTER_COUNT + 1];
+    const ssize_t nBytes = ::read(m_nGroupFd, arrBuffer, sizeof(arrBuffer));
+    if (nBytes < static_cast<ssize_t>(sizeof(uint64_t)))
+    {
+        return false;
+    }
+
+    size_t nValue = 1;
+    for (size_t nCounter = 0; nCounter < COUNTER_COUNT; ++nCounter)
+    {
+        if ((PERF_EVENT_MASK & m_nCounterMask & (1u << nCounter)) && nValue <= arrBuffer[0])
+        {
+            arrValue[nCounter] = arrBuffer[nValue++];
+        }
+    }
+#endif
+    return true;
+}
+
+/**
+ * Get the CPU time of the calling thread.
+ * @return Nanoseconds.
+ */
+uint64_t CYPerfCounters::GetThreadCpuTimeNs() noexcept
+{
+#if defined(_WIN32)
+    FILETIME ftCreation, ftExit, ftKernel, ftUser;
+    if (!GetThreadTimes(::GetCurrentThread(), &ftCreation, &ftExit, &ftKernel, &ftUser))
+    {
+        return 0;
+    }
+    const uint64_t nKernel = (static_cast<uint64_t>(ftKernel.dwHighDateTime) << 32) | ftKernel.dwLowDateTime;
+    const uint64_t nUser = (static_cast<uint64_t>(ftUser.dwHighDateTime) << 32) | ftUser.dwLowDateTime;
+    return (nKernel + nUser) * 100;
+#else
+    timespec objTime{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &objTime) != 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(objTime.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(objTime.tv_nsec);
+#endif
+}
+
+CYTHRAD_NAMESPACE_END
@@ -0,0 +1,173 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_PERF_COUNTERS_HPP__
+#define __CY_PERF_COUNTERS_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Performance Counters of one worker.
+ * Opened on the worker thread with perf_event_open as one group, so a single read returns every
+ * counter. Hardware counters are often missing in virtual machines, the software counters for
+ * task clock and context switches are opened regardless and stand in for them.
+ * The thread CPU clock and the wall clock are read next to the group, their ratio shows tasks
+ * that block instead of computing.
+ * @note Only Linux has perf counters, the CPU time is available everywhere.
+ */
+class CYPerfCounters
+{
+public:
+    static constexpr size_t COUNTER_COUNT = static_cast<size_t>(CYPerfCounter::PERF_COUNTER_COUNT);
+
+    /**
+     * Constructor.
+     * @param bPerfEvents True to open the perf_event_open counters.
+     * @param bCpuTime True to read CPU time and wall time.
+     * @param pMemoryResource Resource the per-type sums are allocated from.
+     */
+    CYPerfCounters(bool bPerfEvents, bool bCpuTime, std::pmr::memory_resource* pMemoryResource = std::pmr::get_default_resource());
+    ~CYPerfCounters();
+
+    CYPerfCounters(const CYPerfCounters&) = delete;
+    CYPerfCounters& operator=(const CYPerfCounters&) = delete;
+
+public:
+    /**
+     * Open the counters for the calling thread.
+     * @return True if at least one counter could be opened.
+     */
+    bool Open() noexcept;
+
+    /**
+     * Close the counters, the sums are kept.
+     */
+    void Close() noexcept;
+
+    /**
+     * Check if any counter is open.
+     * @return True if tasks are sampled.
+     */
+    [[nodiscard]] bool IsOpen() const noexcept
+    {
+        return m_nCounterMask != 0;
+    }
+
+    /**
+     * Read the counters before a task.
+     * @param objTaskType Type of the task object or callable.
+     */
+    void BeginSample(const std::type_info& objTaskType) noexcept;
+
+    /**
+     * Read the counters after the task and add the deltas to the sums of its type.
+     */
+    void EndSample() noexcept;
+
+    /**
+     * Drop the running sample, for pool tasks that run other tasks.
+     */
+    void CancelSample() noexcept
+    {
+        m_pSampleType = nullptr;
+    }
+
+    /**
+     * Add the sums of this worker to a per-type collection.
+     * @param mapStats Sums per task type, merged into.
+     */
+    void Collect(std::unordered_map<std::type_index, CYTaskPerfStats>& mapStats) const;
+
+    /**
+     * Get the CPU time of the calling thread.
+     * @return Nanoseconds.
+     */
+    [[nodiscard]] static uint64_t GetThreadCpuTimeNs() noexcept;
+
+private:
+    /**
+     * Read every open counter.
+     * @param arrValue Receives the values, in CYPerfCounter order.
+     * @return True if the group could be read.
+     */
+    bool Read(uint64_t (&arrValue)[COUNTER_COUNT]) const noexcept;
+
+private:
+    /**
+     * Descriptors in CYPerfCounter order, -1 if not open. The first open one leads the group.
+     */
+    int m_arrFd[COUNTER_COUNT];
+    int m_nGroupFd{ -1 };
+    uint32_t m_nCounterMask{ 0 };
+    bool m_bPerfEvents{ false };
+    bool m_bCpuTime{ false };
+
+    /**
+     * Mask of the counters read by perf_event_open.
+     */
+    static constexpr uint32_t PERF_EVENT_MASK = (1u << static_cast<uint32_t>(CYPerfCounter::PERF_COUNTER_CPU_TIME)) - 1;
+
+    /**
+     * Running sample.
+     */
+    const std::type_info* m_pSampleType{ nullptr };
+    uint64_t m_arrStart[COUNTER_COUNT]{};
+
+    /**
+     * Sums per task type, written by the worker and read by GetPerfStats.
+     */
+    mutable std::mutex m_objMutex;
+    std::pmr::unordered_map<std::type_index, CYTaskPerfStats> m_mapStats;
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_PERF_COUNTERS_HPP__
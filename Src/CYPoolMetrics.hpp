@@ -0,0 +1,265 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_POOL_METRICS_HPP__
+#define __CY_POOL_METRICS_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Metrics of one worker, on cache lines of its own.
+ * Only relaxed increments, a reader merging the slots sees each counter move forward on its own.
+ */
+struct alignas(64) CYWorkerMetrics
+{
+    std::atomic<uint64_t> nSubmitted{ 0 };
+    std::atomic<uint64_t> nStarted{ 0 };
+    std::atomic<uint64_t> nCompleted{ 0 };
+    std::atomic<uint64_t> nRejected{ 0 };
+    std::atomic<uint64_t> arrQueueWait[CYLatencyHistogram::BUCKET_COUNT]{};
+    std::atomic<uint64_t> arrExecution[CYLatencyHistogram::BUCKET_COUNT]{};
+
+    void OnSubmit(uint64_t nCount = 1) noexcept
+    {
+        nSubmitted.fetch_add(nCount, std::memory_order_relaxed);
+    }
+
+    void OnReject() noexcept
+    {
+        nRejected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Count tasks a worker took out of a queue.
+     * @param nWaitNs Time they spent queued, 0 if unknown.
+     * @param nCount Number of tasks.
+     */
+    void OnStart(uint64_t nWaitNs, uint64_t nCount = 1) noexcept
+    {
+        nStarted.fetch_add(nCount, std::memory_order_relaxed);
+        if (nWaitNs)
+        {
+            arrQueueWait[CYLatencyHistogram::GetBucketIndex(nWaitNs)].fetch_add(nCount, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Count finished tasks.
+     * @param nExecutionNs Execution time of each task.
+     * @param nCount Number of tasks.
+     */
+    void OnComplete(uint64_t nExecutionNs, uint64_t nCount = 1) noexcept
+    {
+        nCompleted.fetch_add(nCount, std::memory_order_relaxed);
+        arrExecution[CYLatencyHistogram::GetBucketIndex(nExecutionNs)].fetch_add(nCount, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Pool Metrics.
+ * One CYWorkerMetrics per worker plus a shared one for threads that are not workers, merged into
+ * a CYThreadPoolMetrics snapshot on read. The slots come from the memory resource of the pool.
+ */
+class CYPoolMetrics
+{
+public:
+    CYPoolMetrics() = default;
+
+    ~CYPoolMetrics()
+    {
+        Release();
+    }
+
+    CYPoolMetrics(const CYPoolMetrics&) = delete;
+    CYPoolMetrics& operator=(const CYPoolMetrics&) = delete;
+
+public:
+    /**
+     * Get the steady clock time used for every measurement.
+     * @return Nanoseconds, never 0.
+     */
+    [[nodiscard]] static uint64_t GetTimeNs() noexcept
+    {
+        const auto nNow = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        return static_cast<uint64_t>(nNow) | 1;
+    }
+
+    /**
+     * Create the slots.
+     * @param nWorkerCount Number of workers.
+     * @param pMemoryResource Resource the slots are allocated from.
+     * @note Must be called before the workers start, it is a no-op once the slots exist.
+     */
+    void SetWorkerCount(size_t nWorkerCount, std::pmr::memory_resource* pMemoryResource)
+    {
+        if (m_pSlot)
+        {
+            return;
+        }
+        m_pMemoryResource = pMemoryResource;
+        void* pStorage = m_pMemoryResource->allocate(sizeof(CYWorkerMetrics) * (nWorkerCount + 1), alignof(CYWorkerMetrics));
+        m_pSlot = static_cast<CYWorkerMetrics*>(pStorage);
+        std::uninitialized_value_construct_n(m_pSlot, nWorkerCount + 1);
+        m_nWorkerCount = nWorkerCount;
+    }
+
+    /**
+     * Get the slot of a worker.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @return Slot, nullptr before SetWorkerCount.
+     */
+    [[nodiscard]] CYWorkerMetrics* GetSlot(size_t nWorker) const noexcept
+    {
+        if (!m_pSlot)
+        {
+            return nullptr;
+        }
+        return &m_pSlot[nWorker < m_nWorkerCount ? nWorker : m_nWorkerCount];
+    }
+
+    /**
+     * Count queued tasks.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param nCount Number of tasks.
+     */
+    void OnSubmit(size_t nWorker, uint64_t nCount = 1) const noexcept
+    {
+        if (auto pSlot = GetSlot(nWorker))
+        {
+            pSlot->OnSubmit(nCount);
+        }
+    }
+
+    /**
+     * Count a task the pool refused.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     */
+    void OnReject(size_t nWorker) const noexcept
+    {
+        if (auto pSlot = GetSlot(nWorker))
+        {
+            pSlot->OnReject();
+        }
+    }
+
+    /**
+     * Count a record taken out of the queue.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param objRecord Record, one queued again after it started once is not counted twice.
+     */
+    void OnStart(size_t nWorker, const CYTaskRecord& objRecord) const noexcept
+    {
+        if (auto pSlot = GetSlot(nWorker); pSlot && objRecord.nEnqueueNs)
+        {
+            pSlot->OnStart(GetTimeNs() - objRecord.nEnqueueNs);
+        }
+    }
+
+    /**
+     * Count finished tasks.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param nExecutionNs Execution time of each task.
+     * @param nCount Number of tasks.
+     */
+    void OnComplete(size_t nWorker, uint64_t nExecutionNs, uint64_t nCount = 1) const noexcept
+    {
+        if (auto pSlot = GetSlot(nWorker))
+        {
+            pSlot->OnComplete(nExecutionNs, nCount);
+        }
+    }
+
+    /**
+     * Merge every slot into a snapshot.
+     * @param objMetrics Receives the counts and histograms, its queue depth is left alone.
+     */
+    void Collect(CYThreadPoolMetrics& objMetrics) const noexcept
+    {
+        for (size_t nSlot = 0; m_pSlot && nSlot <= m_nWorkerCount; ++nSlot)
+        {
+            const auto& objSlot = m_pSlot[nSlot];
+            objMetrics.nSubmitted += objSlot.nSubmitted.load(std::memory_order_relaxed);
+            objMetrics.nStarted += objSlot.nStarted.load(std::memory_order_relaxed);
+            objMetrics.nCompleted += objSlot.nCompleted.load(std::memory_order_relaxed);
+            objMetrics.nRejected += objSlot.nRejected.load(std::memory_order_relaxed);
+            for (size_t nIndex = 0; nIndex < CYLatencyHistogram::BUCKET_COUNT; ++nIndex)
+            {
+                if (const uint64_t nCount = objSlot.arrQueueWait[nIndex].load(std::memory_order_relaxed))
+                {
+                    objMetrics.objQueueWait.AddToBucket(nIndex, nCount);
+                }
+                if (const uint64_t nCount = objSlot.arrExecution[nIndex].load(std::memory_order_relaxed))
+                {
+                    objMetrics.objExecution.AddToBucket(nIndex, nCount);
+                }
+            }
+        }
+    }
+
+private:
+    void Release() noexcept
+    {
+        if (m_pSlot)
+        {
+            std::destroy_n(m_pSlot, m_nWorkerCount + 1);
+            m_pMemoryResource->deallocate(m_pSlot, sizeof(CYWorkerMetrics) * (m_nWorkerCount + 1), alignof(CYWorkerMetrics));
+            m_pSlot = nullptr;
+        }
+    }
+
+private:
+    std::pmr::memory_resource* m_pMemoryResource{ nullptr };
+    CYWorkerMetrics* m_pSlot{ nullptr };
+    size_t m_nWorkerCount{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_POOL_METRICS_HPP__
@@ -0,0 +1,383 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_POOL_TRACE_HPP__
+#define __CY_POOL_TRACE_HPP__
+
+#include "CYThread/ICYThread.hpp"
+#include "CYPoolMetrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Trace Event Type.
+ */
+enum class CYTraceEventType : uint32_t
+{
+    TRACE_EVENT_SUBMIT = 0,        // Tasks queued, argument is the count
+    TRACE_EVENT_DISPATCH = 1,      // Task handed to a worker, argument is the worker index
+    TRACE_EVENT_TASK = 2,          // Task ran, span from begin to end
+    TRACE_EVENT_IDLE = 3,          // Worker parked, span from park to wake
+};
+
+/**
+ * Trace Ring.
+ * Fixed number of events, the oldest ones are overwritten. Writers claim a slot with one atomic
+ * increment and publish it with a sequence number, so a reader never sees a half written event.
+ */
+class alignas(64) CYTraceRing
+{
+public:
+    /**
+     * Record an event.
+     * @param eType Event type.
+     * @param nThread Thread id shown in the trace.
+     * @param nTimeNs Time stamp, start of the span for span events.
+     * @param nDurationNs Length of the span, 0 for instant events.
+     * @param nArg Argument of the event.
+     */
+    void Record(CYTraceEventType eType, uint32_t nThread, uint64_t nTimeNs, uint64_t nDurationNs, uint64_t nArg) noexcept
+    {
+        const uint64_t nIndex = m_nHead.fetch_add(1, std::memory_order_relaxed);
+        auto& objEvent = m_pEvent[nIndex & (m_nCapacity - 1)];
+        objEvent.nSequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        objEvent.nTimeNs.store(nTimeNs, std::memory_order_relaxed);
+        objEvent.nDurationNs.store(nDurationNs, std::memory_order_relaxed);
+        objEvent.nArg.store(nArg, std::memory_order_relaxed);
+        objEvent.nTypeAndThread.store(static_cast<uint64_t>(eType) << 32 | nThread, std::memory_order_relaxed);
+        objEvent.nSequence.store(nIndex + 1, std::memory_order_release);
+    }
+
+private:
+    friend class CYPoolTrace;
+
+    struct Event
+    {
+        std::atomic<uint64_t> nSequence{ 0 };
+        std::atomic<uint64_t> nTimeNs{ 0 };
+        std::atomic<uint64_t> nDurationNs{ 0 };
+        std::atomic<uint64_t> nArg{ 0 };
+        std::atomic<uint64_t> nTypeAndThread{ 0 };
+    };
+
+    std::atomic<uint64_t> m_nHead{ 0 };
+    Event* m_pEvent{ nullptr };
+    size_t m_nCapacity{ 0 };
+};
+
+/**
+ * Pool Trace.
+ * One CYTraceRing per worker plus a shared one for threads that are not workers, written out as
+ * Chrome trace JSON on demand. The rings come from the memory resource of the pool.
+ */
+class CYPoolTrace
+{
+public:
+    CYPoolTrace() = default;
+
+    ~CYPoolTrace()
+    {
+        Release();
+    }
+
+    CYPoolTrace(const CYPoolTrace&) = delete;
+    CYPoolTrace& operator=(const CYPoolTrace&) = delete;
+
+public:
+    /**
+     * Create the rings.
+     * @param nWorkerCount Number of workers.
+     * @param nCapacity Events kept per ring, rounded up to a power of two, 0 leaves tracing off.
+     * @param pMemoryResource Resource the rings are allocated from.
+     * @note Must be called before the workers start, it is a no-op once the rings exist.
+     */
+    void SetWorkerCount(size_t nWorkerCount, size_t nCapacity, std::pmr::memory_resource* pMemoryResource)
+    {
+        if (m_pRing || nCapacity == 0)
+        {
+            return;
+        }
+        size_t nRounded = 1;
+        while (nRounded < nCapacity)
+        {
+            nRounded <<= 1;
+        }
+
+        m_pMemoryResource = pMemoryResource;
+        m_pRing = static_cast<CYTraceRing*>(m_pMemoryResource->allocate(sizeof(CYTraceRing) * (nWorkerCount + 1), alignof(CYTraceRing)));
+        std::uninitialized_value_construct_n(m_pRing, nWorkerCount + 1);
+        m_nWorkerCount = nWorkerCount;
+        for (size_t nRing = 0; nRing <= nWorkerCount; ++nRing)
+        {
+            try
+            {
+                auto pEvent = static_cast<CYTraceRing::Event*>(m_pMemoryResource->allocate(sizeof(CYTraceRing::Event) * nRounded, alignof(CYTraceRing::Event)));
+                std::uninitialized_value_construct_n(pEvent, nRounded);
+                m_pRing[nRing].m_pEvent = pEvent;
+                m_pRing[nRing].m_nCapacity = nRounded;
+            }
+            catch (...)
+            {
+                Release();
+                throw;
+            }
+        }
+    }
+
+    /**
+     * Check if tracing is on.
+     * @return True once the rings exist.
+     */
+    [[nodiscard]] bool IsEnabled() const noexcept
+    {
+        return m_pRing != nullptr;
+    }
+
+    /**
+     * Get the ring of a worker.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @return Ring, nullptr while tracing is off.
+     */
+    [[nodiscard]] CYTraceRing* GetRing(size_t nWorker) const noexcept
+    {
+        if (!m_pRing)
+        {
+            return nullptr;
+        }
+        return &m_pRing[nWorker < m_nWorkerCount ? nWorker : m_nWorkerCount];
+    }
+
+    /**
+     * Get the thread id a worker is shown with, other threads get ids above every worker.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @return Thread id.
+     */
+    [[nodiscard]] static uint32_t GetThreadId(size_t nWorker) noexcept
+    {
+        if (nWorker != SIZE_MAX)
+        {
+            return static_cast<uint32_t>(nWorker + 1);
+        }
+        static std::atomic<uint32_t> s_nNextId{ EXTERNAL_THREAD_ID };
+        thread_local const uint32_t t_nId = s_nNextId.fetch_add(1, std::memory_order_relaxed);
+        return t_nId;
+    }
+
+    /**
+     * Record an instant event of the calling thread.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param eType Event type.
+     * @param nArg Argument of the event.
+     */
+    void Record(size_t nWorker, CYTraceEventType eType, uint64_t nArg) const noexcept
+    {
+        if (auto pRing = GetRing(nWorker))
+        {
+            pRing->Record(eType, GetThreadId(nWorker), CYPoolMetrics::GetTimeNs(), 0, nArg);
+        }
+    }
+
+    /**
+     * Record a span of the calling thread that ends now.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param eType Event type.
+     * @param nStartNs Start of the span.
+     */
+    void RecordSpan(size_t nWorker, CYTraceEventType eType, uint64_t nStartNs) const noexcept
+    {
+        if (auto pRing = GetRing(nWorker))
+        {
+            pRing->Record(eType, GetThreadId(nWorker), nStartNs, CYPoolMetrics::GetTimeNs() - nStartNs, 0);
+        }
+    }
+
+    /**
+     * Write the events still held by the rings as Chrome trace JSON.
+     * @param objStream Output stream.
+     * @return True if tracing is on and the stream took the trace.
+     * @note Events recorded while writing are skipped or written whole, never torn.
+     */
+    bool WriteJson(std::ostream& objStream) const
+    {
+        if (!m_pRing)
+        {
+            return false;
+        }
+
+        // Time stamps are relative to the oldest event, Chrome expects microseconds.
+        uint64_t nBaseNs = UINT64_MAX;
+        ForEachEvent([&](CYTraceEventType, uint32_t, uint64_t nTimeNs, uint64_t, uint64_t) {
+            nBaseNs = std::min(nBaseNs, nTimeNs);
+        });
+
+        const char* pszSeparator = "";
+        objStream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        for (size_t nWorker = 0; nWorker < m_nWorkerCount; ++nWorker)
+        {
+            objStream << pszSeparator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GetThreadId(nWorker)
+                << ",\"args\":{\"name\":\"worker " << nWorker << "\"}}";
+            pszSeparator = ",";
+        }
+
+        ForEachEvent([&](CYTraceEventType eType, uint32_t nThread, uint64_t nTimeNs, uint64_t nDurationNs, uint64_t nArg) {
+            objStream << pszSeparator << "{\"name\":\"" << GetEventName(eType) << "\",\"pid\":1,\"tid\":" << nThread << ",\"ts\":";
+            WriteMicroseconds(objStream, nTimeNs - nBaseNs);
+            switch (eType)
+            {
+            case CYTraceEventType::TRACE_EVENT_TASK:
+            case CYTraceEventType::TRACE_EVENT_IDLE:
+                objStream << ",\"ph\":\"X\",\"dur\":";
+                WriteMicroseconds(objStream, nDurationNs);
+                break;
+            case CYTraceEventType::TRACE_EVENT_SUBMIT:
+                objStream << ",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"count\":" << nArg << "}";
+                break;
+            case CYTraceEventType::TRACE_EVENT_DISPATCH:
+                objStream << ",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"worker\":" << nArg << "}";
+                break;
+            }
+            objStream << "}";
+            pszSeparator = ",";
+        });
+        objStream << "]}";
+        return static_cast<bool>(objStream);
+    }
+
+private:
+    /**
+     * Thread ids of threads that are not workers start here.
+     */
+    static constexpr uint32_t EXTERNAL_THREAD_ID = 1000;
+
+    /**
+     * Call a function for every complete event held by the rings.
+     * @param funVisit Receives type, thread id, time, duration and argument.
+     */
+    template <typename Visitor>
+    void ForEachEvent(Visitor&& funVisit) const
+    {
+        for (size_t nRing = 0; nRing <= m_nWorkerCount; ++nRing)
+        {
+            const auto& objRing = m_pRing[nRing];
+            const uint64_t nHead = objRing.m_nHead.load(std::memory_order_acquire);
+            const uint64_t nFirst = nHead > objRing.m_nCapacity ? nHead - objRing.m_nCapacity : 0;
+            for (uint64_t nIndex = nFirst; nIndex < nHead; ++nIndex)
+            {
+                const auto& objEvent = objRing.m_pEvent[nIndex & (objRing.m_nCapacity - 1)];
+                if (objEvent.nSequence.load(std::memory_order_acquire) != nIndex + 1)
+                {
+                    continue;
+                }
+                const uint64_t nTimeNs = objEvent.nTimeNs.load(std::memory_order_relaxed);
+                const uint64_t nDurationNs = objEvent.nDurationNs.load(std::memory_order_relaxed);
+                const uint64_t nArg = objEvent.nArg.load(std::memory_order_relaxed);
+                const uint64_t nTypeAndThread = objEvent.nTypeAndThread.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (objEvent.nSequence.load(std::memory_order_relaxed) != nIndex + 1)
+                {
+                    continue;
+                }
+                funVisit(static_cast<CYTraceEventType>(nTypeAndThread >> 32), static_cast<uint32_t>(nTypeAndThread), nTimeNs, nDurationNs, nArg);
+            }
+        }
+    }
+
+    [[nodiscard]] static const char* GetEventName(CYTraceEventType eType) noexcept
+    {
+        switch (eType)
+        {
+        case CYTraceEventType::TRACE_EVENT_SUBMIT:
+            return "submit";
+        case CYTraceEventType::TRACE_EVENT_DISPATCH:
+            return "dispatch";
+        case CYTraceEventType::TRACE_EVENT_TASK:
+            return "task";
+        case CYTraceEventType::TRACE_EVENT_IDLE:
+            return "idle";
+        }
+        return "unknown";
+    }
+
+    static void WriteMicroseconds(std::ostream& objStream, uint64_t nNs)
+    {
+        const uint64_t nFraction = nNs % 1000;
+        objStream << nNs / 1000 << '.' << static_cast<char>('0' + nFraction / 100) << static_cast<char>('0' + nFraction / 10 % 10)
+            << static_cast<char>('0' + nFraction % 10);
+    }
+
+    void Release() noexcept
+    {
+        if (!m_pRing)
+        {
+            return;
+        }
+        for (size_t nRing = 0; nRing <= m_nWorkerCount; ++nRing)
+        {
+            auto& objRing = m_pRing[nRing];
+            if (objRing.m_pEvent)
+            {
+                std::destroy_n(objRing.m_pEvent, objRing.m_nCapacity);
+                m_pMemoryResource->deallocate(objRing.m_pEvent, sizeof(CYTraceRing::Event) * objRing.m_nCapacity, alignof(CYTraceRing::Event));
+            }
+        }
+        std::destroy_n(m_pRing, m_nWorkerCount + 1);
+        m_pMemoryResource->deallocate(m_pRing, sizeof(CYTraceRing) * (m_nWorkerCount + 1), alignof(CYTraceRing));
+        m_pRing = nullptr;
+    }
+
+private:
+    std::pmr::memory_resource* m_pMemoryResource{ nullptr };
+    CYTraceRing* m_pRing{ nullptr };
+    size_t m_nWorkerCount{ 0 };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_POOL_TRACE_HPP__
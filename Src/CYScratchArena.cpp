@@ -0,0 +1,178 @@
+#include "CYThreadPCH.hpp"
+#include "CYThread/CYScratchArena.hpp"
+#include "CYThread.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+namespace
+{
+    /**
+     * Round a pointer up to an alignment.
+     */
+    char* AlignUp(char* pCursor, size_t nAlign) noexcept
+    {
+        const auto nAddress = reinterpret_cast<uintptr_t>(pCursor);
+        return pCursor + ((nAlign - (nAddress & (nAlign - 1))) & (nAlign - 1));
+    }
+}
+
+/**
+ * Constructor.
+ * @param nBlockSize Size of the first block, allocated on first use.
+ */
+CYScratchArena::CYScratchArena(size_t nBlockSize) noexcept
+    : m_nBlockSize(nBlockSize)
+{
+}
+
+CYScratchArena::~CYScratchArena()
+{
+    FreeBlocksAfter(nullptr);
+}
+
+/**
+ * Get the arena of the calling worker.
+ * @return The arena, nullptr if the caller is not a pool worker.
+ */
+CYScratchArena* CYScratchArena::GetCurrent() noexcept
+{
+    auto pCurrent = CYThread::GetCurrentThread();
+    return pCurrent ? &pCurrent->GetScratchArena() : nullptr;
+}
+
+/**
+ * Allocate raw memory.
+ * @param nSize Bytes to allocate.
+ * @param nAlign Alignment, a power of two.
+ * @return The memory, nullptr if the system is out of memory.
+ */
+void* CYScratchArena::Allocate(size_t nSize, size_t nAlign) noexcept
+{
+    if (m_pCursor)
+    {
+        char* pMemory = AlignUp(m_pCursor, nAlign);
+        if (pMemory <= m_pEnd && nSize <= static_cast<size_t>(m_pEnd - pMemory))
+        {
+            m_pCursor = pMemory + nSize;
+            return pMemory;
+        }
+    }
+
+    if (!AddBlock(nSize, nAlign))
+    {
+        return nullptr;
+    }
+
+    // A fresh block always holds the request.
+    char* pMemory = AlignUp(m_pCursor, nAlign);
+    m_pCursor = pMemory + nSize;
+    return pMemory;
+}
+
+/**
+ * Drop every allocation made after a position.
+ * @param objMark Position returned by GetMark().
+ */
+void CYScratchArena::Rewind(const CYScratchMark& objMark) noexcept
+{
+    if (!m_pBlock)
+    {
+        return;
+    }
+
+    auto pKeep = static_cast<CYBlock*>(objMark.pBlock);
+    if (!pKeep)
+    {
+        // Marked before the first allocation, keep the oldest block for reuse.
+        for (pKeep = m_pBlock; pKeep->pPrev; pKeep = pKeep->pPrev)
+        {
+        }
+    }
+
+    FreeBlocksAfter(pKeep);
+    m_pCursor = objMark.pBlock ? objMark.pCursor : GetBlockBegin(m_pBlock);
+}
+
+/**
+ * Drop every allocation.
+ * @note If the last cycle needed several blocks they are merged, so the next one needs a single block.
+ */
+void CYScratchArena::Reset() noexcept
+{
+    if (!m_pBlock)
+    {
+        return;
+    }
+
+    if (m_pBlock->pPrev)
+    {
+        m_nBlockSize = std::max(m_nBlockSize, m_nCapacity);
+        FreeBlocksAfter(nullptr);
+        return;
+    }
+
+    m_pCursor = GetBlockBegin(m_pBlock);
+}
+
+/**
+ * Get the bytes handed out since the last reset, padding included.
+ * @return Used bytes.
+ */
+size_t CYScratchArena::GetUsed() const noexcept
+{
+    return m_pBlock ? m_pBlock->nUsedBefore + static_cast<size_t>(m_pCursor - GetBlockBegin(m_pBlock)) : 0;
+}
+
+/**
+ * Chain a new block able to hold the allocation.
+ * @param nSize Bytes of the allocation that did not fit.
+ * @param nAlign Alignment of the allocation.
+ * @return True if success, false if the system is out of memory.
+ */
+bool CYScratchArena::AddBlock(size_t nSize, size_t nAlign) noexcept
+{
+    if (nSize > SIZE_MAX - sizeof(CYBlock) - nAlign)
+    {
+        return false;
+    }
+
+    const size_t nDataSize = std::max(m_nBlockSize, nSize + nAlign);
+    auto pBlock = static_cast<CYBlock*>(std::malloc(sizeof(CYBlock) + nDataSize));
+    if (!pBlock)
+    {
+        return false;
+    }
+
+    pBlock->pPrev = m_pBlock;
+    pBlock->nSize = nDataSize;
+    pBlock->nUsedBefore = GetUsed();
+
+    m_pBlock = pBlock;
+    m_pCursor = GetBlockBegin(pBlock);
+    m_pEnd = m_pCursor + nDataSize;
+    m_nCapacity += nDataSize;
+    return true;
+}
+
+/**
+ * Free the blocks newer than pKeep.
+ * @param pKeep Block that becomes the current one, nullptr frees every block.
+ */
+void CYScratchArena::FreeBlocksAfter(CYBlock* pKeep) noexcept
+{
+    while (m_pBlock && m_pBlock != pKeep)
+    {
+        CYBlock* pPrev = m_pBlock->pPrev;
+        m_nCapacity -= m_pBlock->nSize;
+        std::free(m_pBlock);
+        m_pBlock = pPrev;
+    }
+
+    m_pCursor = m_pBlock ? GetBlockBegin(m_pBlock) : nullptr;
+    m_pEnd = m_pBlock ? m_pCursor + m_pBlock->nSize : nullptr;
+}
+
+CYTHRAD_NAMESPACE_END
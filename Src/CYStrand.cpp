@@ -0,0 +1,374 @@
+#include "CYThreadPCH.hpp"
+#include "CYThread/CYStrand.hpp"
+#include "CYTaskNodePool.hpp"
+#include <chrono>
+#include <thread>
+#include <utility>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+namespace
+{
+    /**
+     * Free list index of the calling thread, SIZE_MAX unless it is a worker of the pool.
+     */
+    size_t GetCurrentWorker(const ICYThreadPool* pThreadPool) noexcept
+    {
+        const int nWorkerIndex = pThreadPool->GetCurrentWorkerIndex();
+        return nWorkerIndex >= 0 ? static_cast<size_t>(nWorkerIndex) : SIZE_MAX;
+    }
+}
+
+/**
+ * Recycler of the queue nodes, the record's pNext doubles as the queue link.
+ */
+class CYStrand::CYNodePool : public CYTaskNodePool<CYThreadTask>
+{
+};
+
+/**
+ * Shared by the copies of one runner task. Once the pool accepted the runner, dropping every copy
+ * without running it parks the runner so that the queued tasks are not lost.
+ */
+class CYStrand::CYRunnerTicket
+{
+public:
+    explicit CYRunnerTicket(CYStrand* pStrand) noexcept
+        : m_pStrand(pStrand)
+    {
+    }
+
+    ~CYRunnerTicket()
+    {
+        if (m_bArmed && !m_bStarted)
+        {
+            m_pStrand->ParkRunner();
+        }
+    }
+
+    CYRunnerTicket(const CYRunnerTicket&) = delete;
+    CYRunnerTicket& operator=(const CYRunnerTicket&) = delete;
+
+    /**
+     * Called by the scheduling thread once the pool accepted the runner.
+     */
+    void Arm() noexcept
+    {
+        m_bArmed = true;
+    }
+
+    /**
+     * Called by the worker that runs the runner.
+     */
+    void Start() noexcept
+    {
+        m_bStarted = true;
+    }
+
+private:
+    CYStrand* m_pStrand{ nullptr };
+    bool m_bArmed{ false };
+    bool m_bStarted{ false };
+};
+
+/**
+ * Constructor.
+ * @param pThreadPool Pool the strand runs on.
+ */
+CYStrand::CYStrand(ICYThreadPool* pThreadPool)
+    : m_pThreadPool(pThreadPool)
+    , m_ptrNodePool(std::make_unique<CYNodePool>())
+{
+    if (m_pThreadPool && m_pThreadPool->GetMaxThreadCount() > 0)
+    {
+        m_ptrNodePool->SetWorkerCount(static_cast<size_t>(m_pThreadPool->GetMaxThreadCount()));
+    }
+}
+
+CYStrand::~CYStrand()
+{
+    (void)Wait();
+}
+
+/**
+ * Queue a objTask behind the earlier tasks of the strand.
+ * @param objTask Task object.
+ * @return True once the task is queued, false if the strand has no pool or no node for it.
+ * @note If the pool refuses the runner the task still stays queued, see IsRunnerDeferred(). It
+ *       runs once a later SubmitTask() or Wait() gets a runner onto the pool, or on the thread
+ *       calling Wait() if the pool keeps refusing. An exception thrown by a task is swallowed so
+ *       that the tasks behind it still run.
+ */
+bool CYStrand::SubmitTask(const CYThreadTask& objTask)
+{
+    if (!m_pThreadPool) return false;
+
+    // Copy before taking a node, a throwing copy then leaves nothing behind.
+    CYThreadTask objQueuedTask = objTask;
+    const CYTaskTag nTag = objTask.nTag;
+    auto pNode = m_ptrNodePool->Acquire(GetCurrentWorker(m_pThreadPool));
+    if (!pNode) return false;
+    pNode->objValue = std::move(objQueuedTask);
+    Push(pNode);
+
+    // Only the submission that wakes an idle strand schedules a runner, unless the pool refused
+    // the last one, then the queue is still waiting for somebody to schedule it.
+    if (m_nPendingTasks.fetch_add(1, std::memory_order_acq_rel) == 0)
+    {
+        m_nRunnerTag = nTag;
+    }
+    else if (!ClaimParkedRunner())
+    {
+        return true;
+    }
+
+    // The task is queued either way, a refused runner is parked for Wait() and later submissions.
+    ScheduleOrPark();
+    return true;
+}
+
+/**
+ * Wait until every queued task of the strand has run.
+ * @param nTimeoutMs Timeout in milliseconds, UINT32_MAX waits forever.
+ * @return 0 if the strand is idle, 1 on timeout.
+ */
+uint32_t CYStrand::Wait(uint32_t nTimeoutMs) noexcept
+{
+    const auto tpDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(nTimeoutMs);
+    std::unique_lock<std::mutex> lock(m_objMutex);
+    auto funReady = [this] {
+        return m_nPendingTasks.load(std::memory_order_acquire) == 0 || m_bRunnerParked.load(std::memory_order_acquire);
+    };
+
+    for (;;)
+    {
+        if (nTimeoutMs == UINT32_MAX)
+        {
+            m_objCondVar.wait(lock, funReady);
+        }
+        else if (!m_objCondVar.wait_until(lock, tpDeadline, funReady))
+        {
+            return 1;
+        }
+
+        if (m_nPendingTasks.load(std::memory_order_acquire) == 0)
+        {
+            return 0;
+        }
+
+        // The pool refused the runner, try once more and run the queue here if it still does.
+        lock.unlock();
+        if (ClaimParkedRunner() && !ScheduleRunner())
+        {
+            RunTasks(CYStopToken{});
+        }
+        lock.lock();
+    }
+}
+
+/**
+ * Push a node, safe from any thread.
+ */
+void CYStrand::Push(CYTaskRecord* pNode) noexcept
+{
+    std::atomic_ref<CYTaskRecord*>(pNode->pNext).store(nullptr, std::memory_order_relaxed);
+    CYTaskRecord* pPrev = m_pHead.exchange(pNode, std::memory_order_acq_rel);
+    std::atomic_ref<CYTaskRecord*>(pPrev->pNext).store(pNode, std::memory_order_release);
+}
+
+/**
+ * Pop the oldest node, only called by the runner.
+ * @return Node, nullptr if a producer has not finished linking it yet.
+ */
+CYTaskRecord* CYStrand::Pop() noexcept
+{
+    CYTaskRecord* pTail = m_pTail;
+    CYTaskRecord* pNext = std::atomic_ref<CYTaskRecord*>(pTail->pNext).load(std::memory_order_acquire);
+
+    if (pTail == &m_objStub)
+    {
+        if (!pNext)
+        {
+            return nullptr;
+        }
+        m_pTail = pNext;
+        pTail = pNext;
+        pNext = std::atomic_ref<CYTaskRecord*>(pNext->pNext).load(std::memory_order_acquire);
+    }
+
+    if (pNext)
+    {
+        m_pTail = pNext;
+        return pTail;
+    }
+
+    if (pTail != m_pHead.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    // pTail is the last node, put the stub behind it so it can be handed out.
+    Push(&m_objStub);
+    pNext = std::atomic_ref<CYTaskRecord*>(pTail->pNext).load(std::memory_order_acquire);
+    if (pNext)
+    {
+        m_pTail = pNext;
+        return pTail;
+    }
+    return nullptr;
+}
+
+/**
+ * Hand the runner to the pool.
+ * @return True if the pool accepted it.
+ */
+bool CYStrand::ScheduleRunner() noexcept
+{
+    try
+    {
+        auto ptrTicket = std::make_shared<CYRunnerTicket>(this);
+        CYThreadTask objRunner;
+        objRunner.nTag = m_nRunnerTag;
+        objRunner.funCancellableTaskToExecute = [this, ptrTicket](void*, const CYStopToken& objStopToken) {
+            ptrTicket->Start();
+            RunTasks(objStopToken);
+        };
+
+        if (m_pThreadPool->SubmitTask(objRunner))
+        {
+            ptrTicket->Arm();
+            return true;
+        }
+        return false;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+/**
+ * Hand the runner to the pool, remembering a refusal so that the queue is not lost.
+ */
+void CYStrand::ScheduleOrPark() noexcept
+{
+    // The queued tasks stay where they are, Wait() and later submissions pick the runner up.
+    if (!ScheduleRunner())
+    {
+        ParkRunner();
+    }
+}
+
+/**
+ * Note that tasks are queued without a runner and wake Wait().
+ */
+void CYStrand::ParkRunner() noexcept
+{
+    // Notified under the lock, the ticket of a dropped runner may be the last to touch the strand.
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    m_bRunnerParked.store(true, std::memory_order_release);
+    m_objCondVar.notify_all();
+}
+
+/**
+ * Take over a runner the pool refused earlier.
+ * @return True if the caller is the runner now.
+ */
+bool CYStrand::ClaimParkedRunner() noexcept
+{
+    return m_bRunnerParked.load(std::memory_order_acquire) && m_bRunnerParked.exchange(false, std::memory_order_acq_rel);
+}
+
+/**
+ * Run queued tasks on a worker until the strand is idle or the batch is used up.
+ * @param objStopToken Token of the runner task.
+ */
+void CYStrand::RunTasks(const CYStopToken& objStopToken) noexcept
+{
+    const size_t nWorker = GetCurrentWorker(m_pThreadPool);
+    for (;;)
+    {
+        const CYTaskTag nRunnerTag = m_nRunnerTag;
+        for (int nRun = 0; nRun < RUNNER_BATCH; ++nRun)
+        {
+            // The pending count says a node exists, a producer may still be linking it.
+            CYTaskRecord* pRecord = std::exchange(m_pCarriedNode, nullptr);
+            while (!pRecord && !(pRecord = Pop()))
+            {
+                std::this_thread::yield();
+            }
+
+            // The pool accounts the runner to its tag, a task of another tag needs a runner of its own.
+            auto pNode = static_cast<CYNodePool::Node*>(pRecord);
+            auto& objTask = pNode->objValue;
+            if (objTask.nTag != nRunnerTag)
+            {
+                m_pCarriedNode = pRecord;
+                break;
+            }
+
+            try
+            {
+                if (objTask.funCancellableTaskToExecute)
+                {
+                    objTask.funCancellableTaskToExecute(objTask.pArgList, objStopToken);
+                }
+                else if (objTask.funTaskToExecute)
+                {
+                    objTask.funTaskToExecute(objTask.pArgList, objTask.bDelete);
+                }
+            }
+            catch (...)
+            {
+                // The runner is noexcept and the strand has no one to report to, the next task still runs.
+            }
+            m_ptrNodePool->Release(pNode, nWorker);
+
+            if (FinishTask())
+            {
+                return;
+            }
+        }
+
+        // Give the worker back so other strands and tasks get their turn, the strand keeps its
+        // single runner because the pending count never dropped to zero. The next runner takes
+        // the tag of the task it starts with.
+        while (!m_pCarriedNode && !(m_pCarriedNode = Pop()))
+        {
+            std::this_thread::yield();
+        }
+        m_nRunnerTag = static_cast<CYNodePool::Node*>(m_pCarriedNode)->objValue.nTag;
+        if (ScheduleRunner())
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * Account one finished or dropped task.
+ * @return True if the strand became idle.
+ */
+bool CYStrand::FinishTask() noexcept
+{
+    size_t nPending = m_nPendingTasks.load(std::memory_order_relaxed);
+    while (nPending > 1)
+    {
+        if (m_nPendingTasks.compare_exchange_weak(nPending, nPending - 1, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+    }
+
+    // The last decrement happens under the lock so a waiter cannot free the strand between
+    // the count reaching zero and the notification.
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    if (m_nPendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        m_objCondVar.notify_all();
+        return true;
+    }
+    return false;
+}
+
+CYTHRAD_NAMESPACE_END
@@ -0,0 +1,364 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TAG_TABLE_HPP__
+#define __CY_TAG_TABLE_HPP__
+
+#include "CYThread/ICYThread.hpp"
+#include "CYPoolMetrics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Counters of one tag, on cache lines of its own.
+ */
+struct alignas(64) CYTagEntry
+{
+    std::atomic<CYTaskTag> nTag{ CYTHREAD_NO_TAG };
+    std::atomic<uint32_t> nConcurrencyLimit{ 0 };
+    std::atomic<uint64_t> nSubmitted{ 0 };
+    std::atomic<uint64_t> nCompleted{ 0 };
+    std::atomic<uint64_t> nCancelled{ 0 };
+    std::atomic<uint64_t> nRejected{ 0 };
+    std::atomic<uint64_t> nPending{ 0 };
+    std::atomic<uint64_t> nRunning{ 0 };
+    std::atomic<uint64_t> nQueueWaitNs{ 0 };
+    std::atomic<uint64_t> nMaxQueueWaitNs{ 0 };
+    std::atomic<uint64_t> nExecutionNs{ 0 };
+    std::atomic<uint64_t> nCpuTimeNs{ 0 };
+};
+
+/**
+ * Tag Table.
+ * Fixed open-addressing table of tag counters. A tag claims its slot with one compare-exchange
+ * the first time it is seen and keeps it for the lifetime of the pool, so lookups and updates
+ * never lock. Waiters for a tag share one condition variable, signalled when a tag drains.
+ * @note Tags beyond the capacity are not tracked, their tasks run without statistics and limits.
+ */
+class CYTagTable
+{
+public:
+    /**
+     * Number of tags a pool tracks.
+     */
+    static constexpr size_t CAPACITY = 256;
+
+    CYTagTable() = default;
+
+    ~CYTagTable()
+    {
+        if (m_pEntry)
+        {
+            std::destroy_n(m_pEntry, CAPACITY);
+            m_pMemoryResource->deallocate(m_pEntry, sizeof(CYTagEntry) * CAPACITY, alignof(CYTagEntry));
+        }
+    }
+
+    CYTagTable(const CYTagTable&) = delete;
+    CYTagTable& operator=(const CYTagTable&) = delete;
+
+public:
+    /**
+     * Create the slots.
+     * @param pMemoryResource Resource the slots are allocated from.
+     * @note Must be called before the workers start, it is a no-op once the slots exist.
+     */
+    void Create(std::pmr::memory_resource* pMemoryResource)
+    {
+        if (m_pEntry)
+        {
+            return;
+        }
+        m_pMemoryResource = pMemoryResource;
+        m_pEntry = static_cast<CYTagEntry*>(m_pMemoryResource->allocate(sizeof(CYTagEntry) * CAPACITY, alignof(CYTagEntry)));
+        std::uninitialized_value_construct_n(m_pEntry, CAPACITY);
+    }
+
+    /**
+     * Get the counters of a tag.
+     * @param nTag Tag.
+     * @param bInsert True to claim a slot for a tag seen for the first time.
+     * @return Counters, nullptr for untagged tasks, unknown tags or a full table.
+     */
+    [[nodiscard]] CYTagEntry* GetEntry(CYTaskTag nTag, bool bInsert = true) const noexcept
+    {
+        if (nTag == CYTHREAD_NO_TAG || !m_pEntry)
+        {
+            return nullptr;
+        }
+
+        // Fibonacci hashing spreads consecutive numeric tags.
+        size_t nSlot = static_cast<size_t>((static_cast<uint64_t>(nTag) * 0x9E3779B97F4A7C15ull) >> 56) & (CAPACITY - 1);
+        for (size_t nProbe = 0; nProbe < CAPACITY; ++nProbe, nSlot = (nSlot + 1) & (CAPACITY - 1))
+        {
+            auto& objEntry = m_pEntry[nSlot];
+            CYTaskTag nSlotTag = objEntry.nTag.load(std::memory_order_acquire);
+            if (nSlotTag == nTag)
+            {
+                return &objEntry;
+            }
+            if (nSlotTag != CYTHREAD_NO_TAG)
+            {
+                continue;
+            }
+            if (!bInsert)
+            {
+                return nullptr;
+            }
+            if (objEntry.nTag.compare_exchange_strong(nSlotTag, nTag, std::memory_order_acq_rel) || nSlotTag == nTag)
+            {
+                return &objEntry;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Count queued tasks.
+     * @param nTag Tag of the tasks.
+     * @param nCount Number of tasks.
+     */
+    void OnSubmit(CYTaskTag nTag, uint64_t nCount) const noexcept
+    {
+        if (auto pEntry = GetEntry(nTag))
+        {
+            pEntry->nSubmitted.fetch_add(nCount, std::memory_order_relaxed);
+            pEntry->nPending.fetch_add(nCount, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Count a task the pool refused.
+     * @param nTag Tag of the task.
+     */
+    void OnReject(CYTaskTag nTag) const noexcept
+    {
+        if (auto pEntry = GetEntry(nTag))
+        {
+            pEntry->nRejected.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Count a record taken out of the queue to run, the caller holds the pool lock.
+     * @param objRecord Record, its queue wait is added unless it was queued again.
+     */
+    void OnStart(const CYTaskRecord& objRecord) const noexcept
+    {
+        auto pEntry = GetEntry(objRecord.nTag, false);
+        if (!pEntry)
+        {
+            return;
+        }
+        pEntry->nRunning.fetch_add(1, std::memory_order_relaxed);
+        if (objRecord.nEnqueueNs)
+        {
+            const uint64_t nWaitNs = CYPoolMetrics::GetTimeNs() - objRecord.nEnqueueNs;
+            pEntry->nQueueWaitNs.fetch_add(nWaitNs, std::memory_order_relaxed);
+            uint64_t nMaxNs = pEntry->nMaxQueueWaitNs.load(std::memory_order_relaxed);
+            while (nWaitNs > nMaxNs && !pEntry->nMaxQueueWaitNs.compare_exchange_weak(nMaxNs, nWaitNs, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    /**
+     * Count a task that returned.
+     * @param nTag Tag of the task.
+     * @param nExecutionNs Wall time of the task.
+     * @param nCpuTimeNs CPU time of the task, 0 if not measured.
+     */
+    void OnFinish(CYTaskTag nTag, uint64_t nExecutionNs, uint64_t nCpuTimeNs) const noexcept
+    {
+        if (auto pEntry = GetEntry(nTag, false))
+        {
+            pEntry->nCompleted.fetch_add(1, std::memory_order_relaxed);
+            pEntry->nExecutionNs.fetch_add(nExecutionNs, std::memory_order_relaxed);
+            pEntry->nCpuTimeNs.fetch_add(nCpuTimeNs, std::memory_order_relaxed);
+            pEntry->nRunning.fetch_sub(1, std::memory_order_relaxed);
+            ReleasePending(*pEntry, 1);
+        }
+    }
+
+    /**
+     * Count tasks dropped without running.
+     * @param nTag Tag of the tasks.
+     * @param nCount Number of tasks.
+     * @param bStarted True if the tasks were already counted as running.
+     */
+    void OnCancel(CYTaskTag nTag, uint64_t nCount, bool bStarted) const noexcept
+    {
+        auto pEntry = GetEntry(nTag, false);
+        if (!pEntry || nCount == 0)
+        {
+            return;
+        }
+        pEntry->nCancelled.fetch_add(nCount, std::memory_order_relaxed);
+        if (bStarted)
+        {
+            pEntry->nRunning.fetch_sub(nCount, std::memory_order_relaxed);
+        }
+        ReleasePending(*pEntry, nCount);
+    }
+
+    /**
+     * Check if a tag already runs as many tasks as it may.
+     * @param nTag Tag.
+     * @return True if another task of the tag must stay queued.
+     */
+    [[nodiscard]] bool IsThrottled(CYTaskTag nTag) const noexcept
+    {
+        auto pEntry = GetEntry(nTag, false);
+        if (!pEntry)
+        {
+            return false;
+        }
+        const uint32_t nLimit = pEntry->nConcurrencyLimit.load(std::memory_order_relaxed);
+        return nLimit != 0 && pEntry->nRunning.load(std::memory_order_relaxed) >= nLimit;
+    }
+
+    /**
+     * Limit how many tasks of a tag run at once.
+     * @param nTag Tag.
+     * @param nMaxRunning Limit, 0 for none.
+     * @return False if the tag cannot be tracked.
+     */
+    bool SetConcurrencyLimit(CYTaskTag nTag, uint32_t nMaxRunning) const noexcept
+    {
+        auto pEntry = GetEntry(nTag);
+        if (!pEntry)
+        {
+            return false;
+        }
+        pEntry->nConcurrencyLimit.store(nMaxRunning, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Wait until no task of a tag is queued or running.
+     * @param nTag Tag.
+     * @param nTimeoutMs Timeout in milliseconds, UINT32_MAX waits forever.
+     * @return 0 if the tag is idle, 1 on timeout.
+     */
+    uint32_t Wait(CYTaskTag nTag, uint32_t nTimeoutMs) const noexcept
+    {
+        auto pEntry = GetEntry(nTag, false);
+        if (!pEntry)
+        {
+            return 0;
+        }
+
+        std::unique_lock<std::mutex> lock(m_objMutex);
+        auto funIdle = [pEntry] { return pEntry->nPending.load(std::memory_order_acquire) == 0; };
+        if (nTimeoutMs == UINT32_MAX)
+        {
+            m_objCondVar.wait(lock, funIdle);
+            return 0;
+        }
+        return m_objCondVar.wait_for(lock, std::chrono::milliseconds(nTimeoutMs), funIdle) ? 0 : 1;
+    }
+
+    /**
+     * Take a snapshot of every tag seen so far.
+     * @param lstStats Receives one entry per tag.
+     */
+    void Collect(std::vector<CYTaskTagStats>& lstStats) const
+    {
+        for (size_t nSlot = 0; m_pEntry && nSlot < CAPACITY; ++nSlot)
+        {
+            const auto& objEntry = m_pEntry[nSlot];
+            const CYTaskTag nTag = objEntry.nTag.load(std::memory_order_acquire);
+            if (nTag == CYTHREAD_NO_TAG)
+            {
+                continue;
+            }
+
+            CYTaskTagStats objStats;
+            objStats.nTag = nTag;
+            objStats.nSubmitted = objEntry.nSubmitted.load(std::memory_order_relaxed);
+            objStats.nCompleted = objEntry.nCompleted.load(std::memory_order_relaxed);
+            objStats.nCancelled = objEntry.nCancelled.load(std::memory_order_relaxed);
+            objStats.nRejected = objEntry.nRejected.load(std::memory_order_relaxed);
+            objStats.nPending = objEntry.nPending.load(std::memory_order_relaxed);
+            objStats.nRunning = objEntry.nRunning.load(std::memory_order_relaxed);
+            objStats.nQueueWaitNs = objEntry.nQueueWaitNs.load(std::memory_order_relaxed);
+            objStats.nMaxQueueWaitNs = objEntry.nMaxQueueWaitNs.load(std::memory_order_relaxed);
+            objStats.nExecutionNs = objEntry.nExecutionNs.load(std::memory_order_relaxed);
+            objStats.nCpuTimeNs = objEntry.nCpuTimeNs.load(std::memory_order_relaxed);
+            objStats.nConcurrencyLimit = objEntry.nConcurrencyLimit.load(std::memory_order_relaxed);
+            lstStats.push_back(objStats);
+        }
+    }
+
+private:
+    /**
+     * Take tasks off the pending count and wake the waiters once the tag drained.
+     */
+    void ReleasePending(CYTagEntry& objEntry, uint64_t nCount) const noexcept
+    {
+        if (objEntry.nPending.fetch_sub(nCount, std::memory_order_acq_rel) == nCount)
+        {
+            // Under the lock, so a waiter cannot miss the wake-up between its check and its wait.
+            std::lock_guard<std::mutex> lock(m_objMutex);
+            m_objCondVar.notify_all();
+        }
+    }
+
+private:
+    std::pmr::memory_resource* m_pMemoryResource{ nullptr };
+    CYTagEntry* m_pEntry{ nullptr };
+    mutable std::mutex m_objMutex;
+    mutable std::condition_variable m_objCondVar;
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_TAG_TABLE_HPP__
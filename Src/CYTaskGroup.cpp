@@ -0,0 +1,177 @@
+#include "CYThreadPCH.hpp"
+#include "CYThread/CYTaskGroup.hpp"
+#include <chrono>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Constructor.
+ * @param pThreadPool Pool the group submits to.
+ * @param pParentGroup Optional parent, its Cancel() and Wait() also cover this group.
+ */
+CYTaskGroup::CYTaskGroup(ICYThreadPool* pThreadPool, CYTaskGroup* pParentGroup)
+    : m_pThreadPool(pThreadPool)
+    , m_pParentGroup(pParentGroup)
+{
+    if (m_pParentGroup)
+    {
+        std::lock_guard<std::mutex> lock(m_pParentGroup->m_objChildMutex);
+        m_pNextSibling = m_pParentGroup->m_pFirstChild;
+        if (m_pNextSibling)
+        {
+            m_pNextSibling->m_pPrevSibling = this;
+        }
+        m_pParentGroup->m_pFirstChild = this;
+    }
+}
+
+CYTaskGroup::~CYTaskGroup()
+{
+    (void)Wait();
+
+    // A Cancel() walking the parent's children holds its lock, so it is done with this group once the lock is ours.
+    if (m_pParentGroup)
+    {
+        std::lock_guard<std::mutex> lock(m_pParentGroup->m_objChildMutex);
+        (m_pPrevSibling ? m_pPrevSibling->m_pNextSibling : m_pParentGroup->m_pFirstChild) = m_pNextSibling;
+        if (m_pNextSibling)
+        {
+            m_pNextSibling->m_pPrevSibling = m_pPrevSibling;
+        }
+    }
+}
+
+/**
+ * Submit a objTask through the group.
+ * @param objTask Task object.
+ * @return True if success, false if the group is cancelled or the pool rejected the task.
+ */
+bool CYTaskGroup::SubmitTask(const CYThreadTask& objTask)
+{
+    if (!m_pThreadPool || IsCancelled()) return false;
+    return m_pThreadPool->SubmitTask(objTask, this);
+}
+
+/**
+ * Submit an object objTask through the group.
+ * @param pInvokingObject Object invoking the task.
+ * @return True if success, false if the group is cancelled or the pool rejected the task.
+ */
+bool CYTaskGroup::SubmitTask(ICYIThreadableObject* pInvokingObject)
+{
+    if (!m_pThreadPool || !pInvokingObject || IsCancelled()) return false;
+    return m_pThreadPool->SubmitTask(pInvokingObject, this);
+}
+
+/**
+ * Cancel the group and its child groups.
+ * @note Queued tasks are removed from the pool right away, running tasks get their stop token signalled.
+ */
+void CYTaskGroup::Cancel() noexcept
+{
+    // Child groups observe the flag through IsCancelled(), so a task that races with the
+    // cancellation into the queue is still dropped by the next dispatch pass.
+    m_bCancelled.store(true, std::memory_order_release);
+    if (m_pThreadPool)
+    {
+        m_pThreadPool->CancelTaskGroup(this);
+    }
+}
+
+/**
+ * Check if this group or one of its ancestors was cancelled.
+ * @return True if cancelled, false otherwise.
+ */
+bool CYTaskGroup::IsCancelled() const noexcept
+{
+    for (auto pGroup = this; pGroup; pGroup = pGroup->m_pParentGroup)
+    {
+        if (pGroup->m_bCancelled.load(std::memory_order_acquire))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check if this group is pGroup or nested below it.
+ * @param pGroup Candidate ancestor.
+ * @return True if pGroup is this group or one of its ancestors.
+ */
+bool CYTaskGroup::IsWithin(const CYTaskGroup* pGroup) const noexcept
+{
+    for (auto pCurrent = this; pCurrent; pCurrent = pCurrent->m_pParentGroup)
+    {
+        if (pCurrent == pGroup)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Wait until every task of the group and its child groups finished or was discarded.
+ * @param nTimeoutMs Timeout in milliseconds, UINT32_MAX waits forever.
+ * @return 0 if the group is idle, 1 on timeout.
+ */
+uint32_t CYTaskGroup::Wait(uint32_t nTimeoutMs) noexcept
+{
+    std::unique_lock<std::mutex> lock(m_objMutex);
+    auto funIdle = [this] { return m_nPendingTasks.load(std::memory_order_acquire) == 0; };
+
+    if (nTimeoutMs == UINT32_MAX)
+    {
+        m_objCondVar.wait(lock, funIdle);
+        return 0;
+    }
+    return m_objCondVar.wait_for(lock, std::chrono::milliseconds(nTimeoutMs), funIdle) ? 0 : 1;
+}
+
+/**
+ * Account a task accepted by the pool, called under the pool lock.
+ */
+void CYTaskGroup::OnTaskSubmitted() noexcept
+{
+    for (auto pGroup = this; pGroup; pGroup = pGroup->m_pParentGroup)
+    {
+        pGroup->m_nPendingTasks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Account a task that finished or was discarded.
+ * @note The group may be destroyed by a waiter as soon as this returns.
+ */
+void CYTaskGroup::OnTaskFinished() noexcept
+{
+    auto pGroup = this;
+    while (pGroup)
+    {
+        // Read the parent first, a child reaching zero may be destroyed right away,
+        // while the parent stays alive until its own count drops.
+        auto pParentGroup = pGroup->m_pParentGroup;
+
+        // Every decrement but the last one is a plain CAS.
+        int nPending = pGroup->m_nPendingTasks.load(std::memory_order_relaxed);
+        while (nPending > 1 &&
+            !pGroup->m_nPendingTasks.compare_exchange_weak(nPending, nPending - 1, std::memory_order_acq_rel))
+        {
+        }
+
+        if (nPending <= 1)
+        {
+            // The last decrement happens under the lock so a waiter cannot free the group
+            // between the count reaching zero and the notification.
+            std::lock_guard<std::mutex> lock(pGroup->m_objMutex);
+            if (pGroup->m_nPendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                pGroup->m_objCondVar.notify_all();
+            }
+        }
+        pGroup = pParentGroup;
+    }
+}
+
+CYTHRAD_NAMESPACE_END
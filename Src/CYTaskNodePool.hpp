@@ -0,0 +1,296 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TASK_NODE_POOL_HPP__
+#define __CY_TASK_NODE_POOL_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Queue node holding one pending entry behind its task record.
+ * A node that is not queued chains to the next free node through pNext.
+ */
+template <class T>
+struct CYTaskNode : CYTaskRecord
+{
+    T objValue;
+};
+
+/**
+ * Task Node Pool.
+ * Recycles queue nodes so that submitting and dispatching tasks does not allocate once the pool
+ * is warm. Every worker keeps a private free list that only it touches, threads that are not
+ * workers (and workers whose list is full or empty) go through a shared overflow list. Nodes and
+ * the private lists come from the memory resource of the pool.
+ * @note A worker index must only be passed by the thread running that worker.
+ */
+template <class T>
+class CYTaskNodePool
+{
+public:
+    using Node = CYTaskNode<T>;
+
+    CYTaskNodePool() = default;
+
+    ~CYTaskNodePool()
+    {
+        for (size_t nWorker = 0; nWorker < m_nCacheCount; ++nWorker)
+        {
+            FreeChain(m_pCache[nWorker].pFree);
+        }
+        FreeChain(m_pOverflow);
+
+        if (m_pCache)
+        {
+            std::destroy_n(m_pCache, m_nCacheCount);
+            m_pMemoryResource->deallocate(m_pCache, sizeof(CYWorkerCache) * m_nCacheCount, alignof(CYWorkerCache));
+        }
+    }
+
+    CYTaskNodePool(const CYTaskNodePool&) = delete;
+    CYTaskNodePool& operator=(const CYTaskNodePool&) = delete;
+    CYTaskNodePool(CYTaskNodePool&&) noexcept = delete;
+    CYTaskNodePool& operator=(CYTaskNodePool&&) noexcept = delete;
+
+public:
+    /**
+     * Set the memory resource nodes are allocated from.
+     * @param pMemoryResource Memory resource, nullptr for std::pmr::get_default_resource().
+     * @return True if applied, false once the pool has allocated, it keeps its resource then.
+     */
+    bool SetMemoryResource(std::pmr::memory_resource* pMemoryResource) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_objOverflowMutex);
+        if (m_pCache || m_pOverflow)
+        {
+            return false;
+        }
+        m_pMemoryResource = pMemoryResource ? pMemoryResource : std::pmr::get_default_resource();
+        return true;
+    }
+
+    /**
+     * Get the memory resource nodes are allocated from.
+     * @return Memory resource.
+     */
+    [[nodiscard]] std::pmr::memory_resource* GetMemoryResource() const noexcept
+    {
+        return m_pMemoryResource;
+    }
+
+    /**
+     * Create the private free lists.
+     * @param nWorkerCount Number of workers.
+     * @note Must be called before the workers start, it is a no-op once the lists exist.
+     */
+    void SetWorkerCount(size_t nWorkerCount)
+    {
+        if (m_pCache || nWorkerCount == 0)
+        {
+            return;
+        }
+        void* pStorage = m_pMemoryResource->allocate(sizeof(CYWorkerCache) * nWorkerCount, alignof(CYWorkerCache));
+        m_pCache = static_cast<CYWorkerCache*>(pStorage);
+        std::uninitialized_value_construct_n(m_pCache, nWorkerCount);
+        m_nCacheCount = nWorkerCount;
+    }
+
+    /**
+     * Put nodes on the shared list ahead of time, so a warming pool does not allocate on first use.
+     * @param nCount Nodes to add.
+     */
+    void Reserve(size_t nCount) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_objOverflowMutex);
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex)
+        {
+            Node* pNode = AllocateNode();
+            if (!pNode)
+            {
+                return;
+            }
+            pNode->pNext = m_pOverflow;
+            m_pOverflow = pNode;
+        }
+    }
+
+    /**
+     * Get the nodes a worker moves from the shared list when its own list runs dry.
+     * @return Refill count.
+     */
+    [[nodiscard]] static constexpr size_t GetRefillCount() noexcept
+    {
+        return REFILL_COUNT;
+    }
+
+    /**
+     * Take a node.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @return Node with a default constructed value, nullptr if the system is out of memory.
+     */
+    [[nodiscard]] Node* Acquire(size_t nWorker) noexcept
+    {
+        if (nWorker < m_nCacheCount)
+        {
+            auto& objCache = m_pCache[nWorker];
+            if (!objCache.pFree)
+            {
+                // Refill in bulk so the shared list is locked once per REFILL_COUNT nodes.
+                std::lock_guard<std::mutex> lock(m_objOverflowMutex);
+                while (m_pOverflow && objCache.nCount < REFILL_COUNT)
+                {
+                    Node* pNode = m_pOverflow;
+                    m_pOverflow = static_cast<Node*>(pNode->pNext);
+                    pNode->pNext = objCache.pFree;
+                    objCache.pFree = pNode;
+                    ++objCache.nCount;
+                }
+            }
+
+            if (Node* pNode = objCache.pFree)
+            {
+                objCache.pFree = static_cast<Node*>(pNode->pNext);
+                --objCache.nCount;
+                pNode->pNext = nullptr;
+                return pNode;
+            }
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_objOverflowMutex);
+            if (Node* pNode = m_pOverflow)
+            {
+                m_pOverflow = static_cast<Node*>(pNode->pNext);
+                pNode->pNext = nullptr;
+                return pNode;
+            }
+        }
+
+        return AllocateNode();
+    }
+
+    /**
+     * Give a node back, its value is reset first so captured state is released right away.
+     * @param pNode Node returned by Acquire().
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     */
+    void Release(Node* pNode, size_t nWorker) noexcept
+    {
+        static_cast<CYTaskRecord&>(*pNode) = CYTaskRecord{};
+        pNode->objValue = T{};
+
+        if (nWorker < m_nCacheCount && m_pCache[nWorker].nCount < CACHE_LIMIT)
+        {
+            auto& objCache = m_pCache[nWorker];
+            pNode->pNext = objCache.pFree;
+            objCache.pFree = pNode;
+            ++objCache.nCount;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_objOverflowMutex);
+        pNode->pNext = m_pOverflow;
+        m_pOverflow = pNode;
+    }
+
+private:
+    /**
+     * Nodes a private free list holds before they spill to the shared list.
+     */
+    static constexpr size_t CACHE_LIMIT = 256;
+
+    /**
+     * Nodes moved from the shared list when a private list runs dry.
+     */
+    static constexpr size_t REFILL_COUNT = 32;
+
+    /**
+     * Private free list of one worker, on its own cache line.
+     */
+    struct alignas(64) CYWorkerCache
+    {
+        Node* pFree{ nullptr };
+        size_t nCount{ 0 };
+    };
+
+    [[nodiscard]] Node* AllocateNode() noexcept
+    {
+        try
+        {
+            return ::new (m_pMemoryResource->allocate(sizeof(Node), alignof(Node))) Node;
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+    void FreeChain(Node* pNode) noexcept
+    {
+        while (pNode)
+        {
+            Node* pNext = static_cast<Node*>(pNode->pNext);
+            pNode->~Node();
+            m_pMemoryResource->deallocate(pNode, sizeof(Node), alignof(Node));
+            pNode = pNext;
+        }
+    }
+
+    std::pmr::memory_resource* m_pMemoryResource{ std::pmr::get_default_resource() };
+    CYWorkerCache* m_pCache{ nullptr };
+    size_t m_nCacheCount{ 0 };
+    std::mutex m_objOverflowMutex;
+    Node* m_pOverflow{ nullptr };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_TASK_NODE_POOL_HPP__
@@ -0,0 +1,417 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TASK_QUEUE_HPP__
+#define __CY_TASK_QUEUE_HPP__
+
+#include "CYTaskNodePool.hpp"
+#include "CYPoolMetrics.hpp"
+#include "CYThread/CYTaskGroup.hpp"
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Function task held by a queue node, the group and the skip count live in its task record.
+ */
+struct CYQueuedTask
+{
+    CYThreadTask objTask;
+    size_t nPinnedWorker{ SIZE_MAX };
+
+    /**
+     * Part of a RunOnAllWorkers() region, whose caller blocks until it ran, so it is never cancelled.
+     */
+    bool bRegion{ false };
+};
+
+/**
+ * Task Queue.
+ * One doubly linked queue of task records for both kinds of tasks. Function tasks are held by
+ * pooled nodes, object tasks are linked through the CYObjectQueueHook of the object, so queueing
+ * either kind does not allocate once the node pool is warm. Entries are pushed to the front, the
+ * back holds the oldest one. A record the dispatch pass could not place is marked missed and stays
+ * where it is, nothing moves between lists.
+ * @note Not thread-safe, the owning pool serializes access.
+ */
+class CYTaskQueue
+{
+public:
+    using Node = CYTaskNode<CYQueuedTask>;
+    using Pool = CYTaskNodePool<CYQueuedTask>;
+
+    /**
+     * Forward iterator over the records, front to back.
+     */
+    class iterator
+    {
+    public:
+        iterator() noexcept = default;
+        explicit iterator(CYTaskRecord* pRecord) noexcept : m_pRecord(pRecord) {}
+
+        CYTaskRecord& operator*() const noexcept { return *m_pRecord; }
+        CYTaskRecord* operator->() const noexcept { return m_pRecord; }
+        iterator& operator++() noexcept { m_pRecord = m_pRecord->pNext; return *this; }
+        bool operator==(const iterator& objOther) const noexcept { return m_pRecord == objOther.m_pRecord; }
+        bool operator!=(const iterator& objOther) const noexcept { return m_pRecord != objOther.m_pRecord; }
+
+        [[nodiscard]] CYTaskRecord* GetRecord() const noexcept { return m_pRecord; }
+
+    private:
+        CYTaskRecord* m_pRecord{ nullptr };
+    };
+
+    /**
+     * Constructor.
+     * @param objPool Pool the function nodes come from and go back to, must outlive the queue.
+     * @param bTrackGroups True to link the records into the queued list of their group, only the
+     *        queue a group cancels from may track them.
+     */
+    explicit CYTaskQueue(Pool& objPool, bool bTrackGroups = false) noexcept
+        : m_objPool(objPool)
+        , m_bTrackGroups(bTrackGroups)
+    {
+    }
+
+    ~CYTaskQueue()
+    {
+        Clear(SIZE_MAX);
+    }
+
+    CYTaskQueue(const CYTaskQueue&) = delete;
+    CYTaskQueue& operator=(const CYTaskQueue&) = delete;
+
+public:
+    iterator begin() const noexcept { return iterator(m_pFront); }
+    iterator end() const noexcept { return iterator(); }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_arrCount[0] + m_arrCount[1]; }
+    [[nodiscard]] bool Empty() const noexcept { return m_pFront == nullptr; }
+
+    /**
+     * Get the number of queued records of one kind.
+     * @param eKind Task kind.
+     * @return Record count.
+     */
+    [[nodiscard]] size_t GetCount(CYTaskKind eKind) const noexcept
+    {
+        return m_arrCount[static_cast<size_t>(eKind)];
+    }
+
+    /**
+     * Get the number of queued records of one kind a dispatch pass could not place.
+     * @param eKind Task kind.
+     * @return Missed record count.
+     */
+    [[nodiscard]] size_t GetMissedCount(CYTaskKind eKind) const noexcept
+    {
+        return m_arrMissed[static_cast<size_t>(eKind)];
+    }
+
+    /**
+     * Get the number of queued records of one kind no dispatch pass has looked at yet.
+     * @param eKind Task kind.
+     * @return Fresh record count.
+     */
+    [[nodiscard]] size_t GetFreshCount(CYTaskKind eKind) const noexcept
+    {
+        return GetCount(eKind) - GetMissedCount(eKind);
+    }
+
+    /**
+     * Get the oldest record, walk towards newer records through pPrev.
+     * @return Back record, nullptr if empty.
+     */
+    [[nodiscard]] CYTaskRecord* GetBack() const noexcept { return m_pBack; }
+
+    /**
+     * Get the node of a function record.
+     */
+    [[nodiscard]] static Node* GetNode(CYTaskRecord* pRecord) noexcept
+    {
+        return static_cast<Node*>(pRecord);
+    }
+
+    /**
+     * Get the hook of an object record.
+     */
+    [[nodiscard]] static CYObjectQueueHook* GetHook(CYTaskRecord* pRecord) noexcept
+    {
+        return static_cast<CYObjectQueueHook*>(pRecord);
+    }
+
+    /**
+     * Queue a function task at the front.
+     * @param objValue Entry to move into the node.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param pTaskGroup Group the task was submitted through, may be nullptr.
+     * @return True if success, false if the system is out of memory.
+     */
+    bool PushFront(CYQueuedTask&& objValue, size_t nWorker, CYTaskGroup* pTaskGroup = nullptr) noexcept
+    {
+        Node* pNode = m_objPool.Acquire(nWorker);
+        if (!pNode)
+        {
+            return false;
+        }
+        pNode->objValue = std::move(objValue);
+        pNode->pTaskGroup = pTaskGroup;
+        pNode->nTag = pNode->objValue.objTask.nTag;
+        LinkFront(pNode);
+        return true;
+    }
+
+    /**
+     * Link a newly submitted record at the front and stamp its queue time.
+     * @param pRecord Pooled node or object hook, filled by the caller.
+     */
+    void LinkFront(CYTaskRecord* pRecord) noexcept
+    {
+        pRecord->nEnqueueNs = CYPoolMetrics::GetTimeNs();
+        LinkGroup(pRecord);
+        pRecord->pPrev = nullptr;
+        pRecord->pNext = m_pFront;
+        if (m_pFront)
+        {
+            m_pFront->pPrev = pRecord;
+        }
+        else
+        {
+            m_pBack = pRecord;
+        }
+        m_pFront = pRecord;
+        ++m_arrCount[static_cast<size_t>(pRecord->eKind)];
+        if (pRecord->bMissed)
+        {
+            ++m_arrMissed[static_cast<size_t>(pRecord->eKind)];
+        }
+    }
+
+    /**
+     * Link a record at the back, ahead of everything queued.
+     * @param pRecord Pooled node or object hook, filled by the caller.
+     */
+    void LinkBack(CYTaskRecord* pRecord) noexcept
+    {
+        LinkGroup(pRecord);
+        pRecord->pNext = nullptr;
+        pRecord->pPrev = m_pBack;
+        if (m_pBack)
+        {
+            m_pBack->pNext = pRecord;
+        }
+        else
+        {
+            m_pFront = pRecord;
+        }
+        m_pBack = pRecord;
+        ++m_arrCount[static_cast<size_t>(pRecord->eKind)];
+        if (pRecord->bMissed)
+        {
+            ++m_arrMissed[static_cast<size_t>(pRecord->eKind)];
+        }
+    }
+
+    /**
+     * Mark a record the dispatch pass could not place.
+     * @param pRecord Record of this queue.
+     */
+    void MarkMissed(CYTaskRecord* pRecord) noexcept
+    {
+        if (!pRecord->bMissed)
+        {
+            pRecord->bMissed = true;
+            ++m_arrMissed[static_cast<size_t>(pRecord->eKind)];
+        }
+    }
+
+    /**
+     * Remove a record. A function node goes back to the pool, an object hook is reset and the
+     * object's claim released, after which it may be submitted again.
+     * @param pRecord Record of this queue.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     */
+    void Erase(CYTaskRecord* pRecord, size_t nWorker) noexcept
+    {
+        Unlink(pRecord);
+        if (pRecord->eKind == CYTaskKind::TASK_KIND_FUNCTION)
+        {
+            m_objPool.Release(GetNode(pRecord), nWorker);
+            return;
+        }
+
+        auto pHook = GetHook(pRecord);
+        pHook->pObject = nullptr;
+        pHook->pTaskGroup = nullptr;
+        pHook->nAffinitySkips = 0;
+        pHook->nEnqueueNs = 0;
+        pHook->nTag = CYTHREAD_NO_TAG;
+        pHook->bMissed = false;
+        pHook->bQueued.store(false, std::memory_order_release);
+    }
+
+    /**
+     * Remove the records matching a predicate.
+     * @param funPred Predicate called with each record.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     */
+    template <class Pred>
+    void EraseIf(Pred funPred, size_t nWorker) noexcept
+    {
+        for (CYTaskRecord* pRecord = m_pFront; pRecord; )
+        {
+            CYTaskRecord* pNext = pRecord->pNext;
+            if (funPred(*pRecord))
+            {
+                Erase(pRecord, nWorker);
+            }
+            pRecord = pNext;
+        }
+    }
+
+    /**
+     * Append every record of another queue at the back, keeping their order.
+     * @param lstSource Queue that is emptied, it must share the node pool.
+     */
+    void SpliceBack(CYTaskQueue& lstSource) noexcept
+    {
+        if (!lstSource.m_pFront)
+        {
+            return;
+        }
+
+        // Records leaving the tracking queue leave their groups' lists, records entering it join them.
+        if (m_bTrackGroups != lstSource.m_bTrackGroups)
+        {
+            for (auto pRecord = lstSource.m_pFront; pRecord; pRecord = pRecord->pNext)
+            {
+                m_bTrackGroups ? LinkGroup(pRecord) : lstSource.UnlinkGroup(pRecord);
+            }
+        }
+
+        if (m_pBack)
+        {
+            m_pBack->pNext = lstSource.m_pFront;
+            lstSource.m_pFront->pPrev = m_pBack;
+        }
+        else
+        {
+            m_pFront = lstSource.m_pFront;
+        }
+        m_pBack = lstSource.m_pBack;
+        for (size_t nKind = 0; nKind < 2; ++nKind)
+        {
+            m_arrCount[nKind] += lstSource.m_arrCount[nKind];
+            m_arrMissed[nKind] += lstSource.m_arrMissed[nKind];
+            lstSource.m_arrCount[nKind] = lstSource.m_arrMissed[nKind] = 0;
+        }
+
+        lstSource.m_pFront = lstSource.m_pBack = nullptr;
+    }
+
+    /**
+     * Remove every record.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     */
+    void Clear(size_t nWorker) noexcept
+    {
+        while (m_pFront)
+        {
+            Erase(m_pFront, nWorker);
+        }
+    }
+
+private:
+    void LinkGroup(CYTaskRecord* pRecord) noexcept
+    {
+        auto pTaskGroup = pRecord->pTaskGroup;
+        if (!m_bTrackGroups || !pTaskGroup)
+        {
+            return;
+        }
+        pRecord->pGroupPrev = nullptr;
+        pRecord->pGroupNext = pTaskGroup->m_pQueuedRecord;
+        if (pRecord->pGroupNext)
+        {
+            pRecord->pGroupNext->pGroupPrev = pRecord;
+        }
+        pTaskGroup->m_pQueuedRecord = pRecord;
+    }
+
+    void UnlinkGroup(CYTaskRecord* pRecord) noexcept
+    {
+        auto pTaskGroup = pRecord->pTaskGroup;
+        if (!m_bTrackGroups || !pTaskGroup)
+        {
+            return;
+        }
+        (pRecord->pGroupPrev ? pRecord->pGroupPrev->pGroupNext : pTaskGroup->m_pQueuedRecord) = pRecord->pGroupNext;
+        if (pRecord->pGroupNext)
+        {
+            pRecord->pGroupNext->pGroupPrev = pRecord->pGroupPrev;
+        }
+        pRecord->pGroupPrev = pRecord->pGroupNext = nullptr;
+    }
+
+    void Unlink(CYTaskRecord* pRecord) noexcept
+    {
+        UnlinkGroup(pRecord);
+        (pRecord->pPrev ? pRecord->pPrev->pNext : m_pFront) = pRecord->pNext;
+        (pRecord->pNext ? pRecord->pNext->pPrev : m_pBack) = pRecord->pPrev;
+        pRecord->pPrev = pRecord->pNext = nullptr;
+        --m_arrCount[static_cast<size_t>(pRecord->eKind)];
+        if (pRecord->bMissed)
+        {
+            --m_arrMissed[static_cast<size_t>(pRecord->eKind)];
+        }
+    }
+
+    Pool& m_objPool;
+    CYTaskRecord* m_pFront{ nullptr };
+    CYTaskRecord* m_pBack{ nullptr };
+    size_t m_arrCount[2]{ 0, 0 };
+    size_t m_arrMissed[2]{ 0, 0 };
+    bool m_bTrackGroups{ false };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_TASK_QUEUE_HPP__
@@ -0,0 +1,220 @@
+#include "CYThreadPCH.hpp"
+#include "CYThread/CYTaskScope.hpp"
+#include <memory>
+#include <utility>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+namespace
+{
+/**
+ * Queue claim of an object submitted through a scope, released once the object starts or its
+ * scope task is dropped without running.
+ */
+class CYObjectClaim
+{
+public:
+    CYObjectClaim() noexcept = default;
+    CYObjectClaim(const CYObjectClaim&) = delete;
+    CYObjectClaim& operator=(const CYObjectClaim&) = delete;
+
+    ~CYObjectClaim()
+    {
+        Release();
+    }
+
+    /**
+     * Claim the object's queue hook.
+     * @param bQueued Claim flag of the hook.
+     * @return True if claimed, false if the object is queued already.
+     */
+    bool Acquire(std::atomic<bool>& bQueued) noexcept
+    {
+        if (bQueued.exchange(true, std::memory_order_acquire))
+        {
+            return false;
+        }
+        m_pQueued = &bQueued;
+        return true;
+    }
+
+    /**
+     * Release the claim, the object may be submitted again.
+     */
+    void Release() noexcept
+    {
+        if (auto pQueued = std::exchange(m_pQueued, nullptr))
+        {
+            pQueued->store(false, std::memory_order_release);
+        }
+    }
+
+private:
+    std::atomic<bool>* m_pQueued{ nullptr };
+};
+} // namespace
+
+/**
+ * Constructor.
+ * @param pThreadPool Pool the scope submits to.
+ * @param pParentGroup Optional group, its Cancel() also cancels the tasks of the scope.
+ */
+CYTaskScope::CYTaskScope(ICYThreadPool* pThreadPool, CYTaskGroup* pParentGroup)
+    : m_pThreadPool(pThreadPool)
+    , m_objTaskGroup(pThreadPool, pParentGroup)
+    , m_nUncaughtExceptions(std::uncaught_exceptions())
+{
+}
+
+/**
+ * Destructor, joins the outstanding tasks.
+ * @note Rethrows a captured exception unless the scope is left by another exception.
+ */
+CYTaskScope::~CYTaskScope() noexcept(false)
+{
+    WaitIdle();
+
+    std::exception_ptr ptrException;
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        ptrException = std::exchange(m_ptrException, nullptr);
+    }
+
+    if (ptrException && std::uncaught_exceptions() <= m_nUncaughtExceptions)
+    {
+        std::rethrow_exception(ptrException);
+    }
+}
+
+/**
+ * Spawn a objTask in the scope.
+ * @param objTask Task object.
+ * @return True if success, false if the scope is cancelled or the pool rejected the task.
+ */
+bool CYTaskScope::SubmitTask(const CYThreadTask& objTask)
+{
+    CYThreadTask objScopeTask;
+    objScopeTask.pArgList = objTask.pArgList;
+    objScopeTask.bDelete = objTask.bDelete;
+    objScopeTask.nAffinityKey = objTask.nAffinityKey;
+    objScopeTask.nTag = objTask.nTag;
+    objScopeTask.funCancellableTaskToExecute = [this, funTask = objTask.funTaskToExecute, bDelete = objTask.bDelete,
+        funCancellableTask = objTask.funCancellableTaskToExecute](void* pArgList, const CYStopToken& objStopToken) {
+        try
+        {
+            if (funCancellableTask)
+            {
+                funCancellableTask(pArgList, objStopToken);
+            }
+            else if (funTask)
+            {
+                funTask(pArgList, bDelete);
+            }
+        }
+        catch (...)
+        {
+            CaptureException(std::current_exception());
+        }
+    };
+    return m_objTaskGroup.SubmitTask(objScopeTask);
+}
+
+/**
+ * Spawn an object objTask in the scope.
+ * @param pInvokingObject Object invoking the task.
+ * @return True if success, false if the scope is cancelled, the object is still queued or the pool rejected the task.
+ * @note The object runs through a scope task, so cancel the scope rather than calling
+ *       TerminateWorkingThread on the object. It counts as queued until that task starts.
+ */
+bool CYTaskScope::SubmitTask(ICYIThreadableObject* pInvokingObject)
+{
+    if (!pInvokingObject) return false;
+
+    // The scope task holds the object's queue claim like a queued object, so the object cannot be
+    // queued twice at once. The last copy of the task releases it if the task never runs.
+    auto ptrClaim = std::make_shared<CYObjectClaim>();
+    if (!ptrClaim->Acquire(pInvokingObject->m_objQueueHook.bQueued))
+    {
+        return false;
+    }
+
+    CYThreadTask objScopeTask;
+    objScopeTask.nAffinityKey = pInvokingObject->GetAffinityKey();
+    objScopeTask.nTag = pInvokingObject->GetTag();
+    objScopeTask.funCancellableTaskToExecute = [this, pInvokingObject, ptrClaim](void*, const CYStopToken& objStopToken) {
+        ptrClaim->Release();
+        try
+        {
+            pInvokingObject->TaskToExecute(objStopToken);
+        }
+        catch (...)
+        {
+            CaptureException(std::current_exception());
+        }
+    };
+    return m_objTaskGroup.SubmitTask(objScopeTask);
+}
+
+/**
+ * Cancel the tasks of the scope.
+ */
+void CYTaskScope::Cancel() noexcept
+{
+    m_objTaskGroup.Cancel();
+}
+
+/**
+ * Wait for every task of the scope, helping to execute queued tasks when called on a worker.
+ * @note Rethrows the first exception thrown by a task of the scope.
+ */
+void CYTaskScope::Join()
+{
+    WaitIdle();
+
+    std::exception_ptr ptrException;
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        ptrException = std::exchange(m_ptrException, nullptr);
+    }
+
+    if (ptrException)
+    {
+        std::rethrow_exception(ptrException);
+    }
+}
+
+/**
+ * Wait until the scope is idle without rethrowing.
+ */
+void CYTaskScope::WaitIdle() noexcept
+{
+    // A worker of the scope's pool blocking here keeps its slot while the children may still sit
+    // in the queue, so it runs queued tasks itself until the scope drains. A worker of another
+    // pool only waits, it must not run this pool's tasks on its own thread.
+    if (m_pThreadPool && m_pThreadPool->GetCurrentWorkerIndex() >= 0)
+    {
+        while (m_objTaskGroup.GetPendingCount() != 0)
+        {
+            if (!m_pThreadPool->ExecutePendingTask())
+            {
+                (void)m_objTaskGroup.Wait(1);
+            }
+        }
+    }
+    (void)m_objTaskGroup.Wait();
+}
+
+/**
+ * Keep the first exception thrown by a task.
+ * @param ptrException Exception to keep.
+ */
+void CYTaskScope::CaptureException(std::exception_ptr ptrException) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    if (!m_ptrException)
+    {
+        m_ptrException = std::move(ptrException);
+    }
+}
+
+CYTHRAD_NAMESPACE_END
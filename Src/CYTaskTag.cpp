@@ -0,0 +1,92 @@
+#include "CYThreadPCH.hpp"
+#include "CYThread/CYTaskTag.hpp"
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+namespace
+{
+    /**
+     * Interned names, the deque keeps every name in place as it grows.
+     */
+    struct TagNames
+    {
+        std::mutex objMutex;
+        std::deque<std::string> lstName;
+        std::unordered_map<std::string_view, CYTaskTag> mapTag;
+    };
+
+    TagNames& GetTagNames() noexcept
+    {
+        static TagNames s_objNames;
+        return s_objNames;
+    }
+}
+
+/**
+ * Get the tag of a name, interning it on first use.
+ * @param pszName Tag name.
+ * @return Tag, CYTHREAD_NO_TAG for an empty name or when out of memory.
+ */
+CYTaskTag CYTaskTagRegistry::Intern(const char* pszName) noexcept
+{
+    if (!pszName || !*pszName)
+    {
+        return CYTHREAD_NO_TAG;
+    }
+
+    auto& objNames = GetTagNames();
+    std::lock_guard<std::mutex> lock(objNames.objMutex);
+    if (auto it = objNames.mapTag.find(pszName); it != objNames.mapTag.end())
+    {
+        return it->second;
+    }
+    if (objNames.lstName.size() >= ~CYTHREAD_INTERNED_TAG_BIT)
+    {
+        return CYTHREAD_NO_TAG;
+    }
+
+    try
+    {
+        const CYTaskTag nTag = CYTHREAD_INTERNED_TAG_BIT | static_cast<CYTaskTag>(objNames.lstName.size() + 1);
+        objNames.lstName.emplace_back(pszName);
+        try
+        {
+            objNames.mapTag.emplace(objNames.lstName.back(), nTag);
+        }
+        catch (...)
+        {
+            objNames.lstName.pop_back();
+            throw;
+        }
+        return nTag;
+    }
+    catch (const std::exception&)
+    {
+        return CYTHREAD_NO_TAG;
+    }
+}
+
+/**
+ * Get the name of an interned tag.
+ * @param nTag Tag returned by Intern().
+ * @return Name, valid for the lifetime of the process, nullptr for tags that were not interned.
+ */
+const char* CYTaskTagRegistry::GetName(CYTaskTag nTag) noexcept
+{
+    if (!(nTag & CYTHREAD_INTERNED_TAG_BIT))
+    {
+        return nullptr;
+    }
+
+    auto& objNames = GetTagNames();
+    const size_t nIndex = static_cast<size_t>(nTag & ~CYTHREAD_INTERNED_TAG_BIT);
+    std::lock_guard<std::mutex> lock(objNames.objMutex);
+    return nIndex != 0 && nIndex <= objNames.lstName.size() ? objNames.lstName[nIndex - 1].c_str() : nullptr;
+}
+
+CYTHRAD_NAMESPACE_END
@@ -10,6 +10,14 @@
 
 CYTHRAD_NAMESPACE_BEGIN
 
+namespace
+{
+    /**
+     * Worker owning the calling thread.
+     */
+    thread_local CYThread* t_pCurrentThread = nullptr;
+}
+
 CYThread::CYThread() = default;
 
 CYThread::~CYThread()
@@ -38,6 +46,8 @@ bool CYThread::CreateThread(const CYThreadProperties& objProps)
 {
     try
     {
+        // Hold the lock so the worker cannot observe m_ptrThread before it is assigned.
+        std::lock_guard<std::mutex> lock(m_objMutex);
         m_ptrThread = std::make_unique<CYJThread>([this]() {
             ExecuteThread();
             });
@@ -65,17 +75,58 @@ void CYThread::ChangeThreadProperties(const CYThreadTask& objAttributes)
  */
 void CYThread::ChangeThreadPropertiesandResume(const CYThreadTask& objAttributes)
 {
-    m_nChangedThreadsTask.fetch_add(1, std::memory_order_release);
-    //m_objThreadsTask = objAttributes;
-    m_objNextThreadsTask = objAttributes;
+    ChangeThreadPropertiesandResume(objAttributes, nullptr);
+}
+
+void CYThread::ChangeThreadPropertiesandResume(ICYIThreadableObject* pAttributes)
+{
+    ChangeThreadPropertiesandResume(pAttributes, nullptr, pAttributes ? pAttributes->GetTag() : CYTHREAD_NO_TAG);
+}
+
+/**
+ * Hand a group task to the thread and then execute it.
+ * @param objAttributes - The task to execute.
+ * @param pTaskGroup - The group the task was submitted through, may be nullptr.
+ */
+void CYThread::ChangeThreadPropertiesandResume(const CYThreadTask& objAttributes, CYTaskGroup* pTaskGroup)
+{
+    ChangeThreadPropertiesandResume(CYThreadTask(objAttributes), pTaskGroup);
+}
+
+/**
+ * Hand a group task to the thread without copying it and then execute it.
+ * @param objAttributes - The task to execute, moved into the thread.
+ * @param pTaskGroup - The group the task was submitted through, may be nullptr.
+ */
+void CYThread::ChangeThreadPropertiesandResume(CYThreadTask&& objAttributes, CYTaskGroup* pTaskGroup)
+{
+    {
+        // Publish the task before the counter so the worker never observes a half-written slot.
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        m_objNextThreadsTask = std::move(objAttributes);
+        m_pNextTaskGroup = pTaskGroup;
+        m_nChangedThreadsTask.fetch_add(1, std::memory_order_release);
+    }
     SetThreadAvail(CYThreadStatus::STATUS_THREAD_EXECUTING);
     ResumeThread();
 }
 
-void CYThread::ChangeThreadPropertiesandResume(ICYIThreadableObject* pAttributes)
+/**
+ * Hand a group object task to the thread and then execute it.
+ * @param pAttributes - The object to execute.
+ * @param pTaskGroup - The group the object was submitted through, may be nullptr.
+ * @param nTag - Tag of the object, taken when it was queued so the worker never asks the object again.
+ */
+void CYThread::ChangeThreadPropertiesandResume(ICYIThreadableObject* pAttributes, CYTaskGroup* pTaskGroup, CYTaskTag nTag)
 {
-    m_nChangedThreadsObject.fetch_add(1, std::memory_order_release);
-    m_pNextThreadsObject = pAttributes;
+    {
+        // RequestTaskStop inspects the next object under the same lock.
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        m_pNextThreadsObject = pAttributes;
+        m_pNextTaskGroup = pTaskGroup;
+        m_nNextObjectTag = nTag;
+        m_nChangedThreadsObject.fetch_add(1, std::memory_order_release);
+    }
     SetThreadAvail(CYThreadStatus::STATUS_THREAD_EXECUTING);
     ResumeThread();
 }
@@ -86,50 +137,334 @@ void CYThread::ChangeThreadPropertiesandResume(ICYIThreadableObject* pAttributes
  */
 uint32_t CYThread::ExecuteThread() noexcept
 {
+    {
+        // Wait for CreateThread to finish publishing m_ptrThread.
+        std::lock_guard<std::mutex> lock(m_objMutex);
+    }
+    t_pCurrentThread = this;
+    if (m_ptrPerfCounters)
+    {
+        (void)m_ptrPerfCounters->Open();
+    }
+    RunWorkerHook(m_funOnWorkerStart);
+
     while (m_ptrThread && !m_ptrThread->get_stop_token().stop_requested())
     {
         if (m_nChangedThreadsObject.load(std::memory_order_acquire) != 0)
         {
+            std::lock_guard<std::mutex> lock(m_objMutex);
             m_pThreadsObject = m_pNextThreadsObject;
+            m_pTaskGroup = m_pNextTaskGroup;
+            m_nObjectTag = m_nNextObjectTag;
             m_nChangedThreadsObject.fetch_sub(1, std::memory_order_release);
             m_pNextThreadsObject = nullptr;
+            m_pNextTaskGroup = nullptr;
+            m_nNextObjectTag = CYTHREAD_NO_TAG;
         }
 
         if (m_nChangedThreadsTask.load(std::memory_order_acquire) != 0)
         {
-            m_objThreadsTask = m_objNextThreadsTask;
+            std::lock_guard<std::mutex> lock(m_objMutex);
+            m_objThreadsTask = std::move(m_objNextThreadsTask);
+            m_pTaskGroup = m_pNextTaskGroup;
             m_nChangedThreadsTask.fetch_sub(1, std::memory_order_release);
-            m_objNextThreadsTask = { nullptr };
+            m_objNextThreadsTask = CYThreadTask{};
+            m_pNextTaskGroup = nullptr;
+        }
+
+        PrepareScratchArena();
+
+        // A group cancelled between dispatch and start gives its task up without running it.
+        if (m_pTaskGroup && m_pTaskGroup->IsCancelled())
+        {
+            FinishTask(m_pThreadsObject != nullptr);
         }
 
         if (m_pThreadsObject)
         {
-            ChangeThreadsExecutionProperties(m_pThreadsObject->GetExecutionProps());
-            m_pThreadsObject->TaskToExecute();
-            SetThreadAvail(CYThreadStatus::STATUS_THREAD_PURGING);
-            m_pThreadsObject = nullptr;
+            if (auto pExecutionProps = m_pThreadsObject->GetExecutionProps())
+            {
+                ChangeThreadsExecutionProperties(pExecutionProps);
+            }
+            BeginTask(typeid(*m_pThreadsObject), m_nObjectTag);
+            m_pThreadsObject->TaskToExecute(AcquireTaskStopToken());
+            FinishTask(true);
         }
 
-        if (m_objThreadsTask.funTaskToExecute)
+        if (m_objThreadsTask.funCancellableTaskToExecute)
+        {
+            BeginTask(m_objThreadsTask.funCancellableTaskToExecute.target_type(), m_objThreadsTask.nTag);
+            m_objThreadsTask.funCancellableTaskToExecute(m_objThreadsTask.pArgList, AcquireTaskStopToken());
+            FinishTask(false);
+        }
+        else if (m_objThreadsTask.funTaskToExecute)
         {
             // Use task's execution properties if available, otherwise use default
             //ChangeThreadsExecutionProperties(m_objThreadsTask.pExecutionProps);
+            BeginTask(m_objThreadsTask.funTaskToExecute.target_type(), m_objThreadsTask.nTag);
             m_objThreadsTask.funTaskToExecute(m_objThreadsTask.pArgList, m_objThreadsTask.bDelete);
-            SetThreadAvail(CYThreadStatus::STATUS_THREAD_PURGING);
-            m_objThreadsTask = { nullptr };
+            FinishTask(false);
         }
 
         {
+            const uint64_t nParkNs = m_pTrace ? CYPoolMetrics::GetTimeNs() : 0;
             std::unique_lock<std::mutex> lock(m_objMutex);
             m_bSuspended.store(true, std::memory_order_release);
             m_objCondVar.wait(lock, [this] {
-                return !m_bSuspended.load(std::memory_order_acquire) || m_ptrThread->get_stop_token().stop_requested();
+                // A task handed over before this worker got here must not be lost.
+                return !m_bSuspended.load(std::memory_order_acquire) ||
+                    m_nChangedThreadsObject.load(std::memory_order_acquire) != 0 ||
+                    m_nChangedThreadsTask.load(std::memory_order_acquire) != 0 ||
+                    m_ptrThread->get_stop_token().stop_requested();
                 });
+            if (nParkNs)
+            {
+                m_pTrace->Record(CYTraceEventType::TRACE_EVENT_IDLE, CYPoolTrace::GetThreadId(m_nWorkerIndex), nParkNs, CYPoolMetrics::GetTimeNs() - nParkNs, 0);
+            }
         }
     }
+
+    RunWorkerHook(m_funOnWorkerStop);
+    if (m_ptrPerfCounters)
+    {
+        m_ptrPerfCounters->Close();
+    }
     return 0;
 }
 
+/**
+ * Run a worker hook on this thread.
+ * @param funHook - The hook, may be empty.
+ * @note A throwing hook must not take the worker down.
+ */
+void CYThread::RunWorkerHook(const CYWorkerHook& funHook) noexcept
+{
+    if (!funHook)
+    {
+        return;
+    }
+
+    try
+    {
+        funHook(static_cast<int>(m_nWorkerIndex));
+    }
+    catch (...)
+    {
+    }
+}
+
+/**
+ * Reset the scratch arena if the pool started a new frame.
+ */
+void CYThread::PrepareScratchArena() noexcept
+{
+    if (m_eScratchResetMode != CYArenaResetMode::RESET_PER_FRAME || !m_pScratchFrame)
+    {
+        return;
+    }
+
+    const uint64_t nScratchFrame = m_pScratchFrame->load(std::memory_order_relaxed);
+    if (nScratchFrame != m_nScratchFrame)
+    {
+        m_nScratchFrame = nScratchFrame;
+        m_objScratchArena.Reset();
+    }
+}
+
+/**
+ * Get the worker running on the calling thread.
+ * @return The worker, nullptr if the caller is not a pool thread.
+ */
+CYThread* CYThread::GetCurrentThread() noexcept
+{
+    return t_pCurrentThread;
+}
+
+/**
+ * Get the stop token for the task that is about to run.
+ */
+CYStopToken CYThread::AcquireTaskStopToken() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    return m_objTaskStopSource.get_token();
+}
+
+/**
+ * Mark the current task as finished, record its execution time, trace span and counters, release its scratch memory and recycle a signalled stop source.
+ * @param bObjectTask True if the finished task was an object task.
+ */
+void CYThread::FinishTask(bool bObjectTask) noexcept
+{
+    // The counters first, so that they leave out the bookkeeping below.
+    if (m_ptrPerfCounters)
+    {
+        m_ptrPerfCounters->EndSample();
+    }
+
+    // A task dispatched but given up before it started counts as cancelled.
+    const CYTaskTag nTag = bObjectTask ? m_nObjectTag : m_objThreadsTask.nTag;
+    if (m_pTagTable && nTag != CYTHREAD_NO_TAG)
+    {
+        if (m_nTagStartNs)
+        {
+            const uint64_t nCpuTimeNs = m_bTagCpuTime ? CYPerfCounters::GetThreadCpuTimeNs() - m_nTagCpuStartNs : 0;
+            m_pTagTable->OnFinish(nTag, CYPoolMetrics::GetTimeNs() - m_nTagStartNs, nCpuTimeNs);
+            m_nTagStartNs = 0;
+        }
+        else
+        {
+            m_pTagTable->OnCancel(nTag, 1, true);
+        }
+    }
+
+    if (m_nTaskStartNs || m_nTraceStartNs)
+    {
+        const uint64_t nNow = CYPoolMetrics::GetTimeNs();
+        if (m_nTaskStartNs)
+        {
+            m_pMetrics->OnComplete(nNow - m_nTaskStartNs);
+            m_nTaskStartNs = 0;
+        }
+        if (m_nTraceStartNs)
+        {
+            m_pTrace->Record(CYTraceEventType::TRACE_EVENT_TASK, CYPoolTrace::GetThreadId(m_nWorkerIndex), m_nTraceStartNs, nNow - m_nTraceStartNs, 0);
+            m_nTraceStartNs = 0;
+        }
+    }
+
+    if (m_eScratchResetMode == CYArenaResetMode::RESET_PER_TASK)
+    {
+        m_objScratchArena.Reset();
+    }
+
+    CYTaskGroup* pTaskGroup = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        if (bObjectTask)
+        {
+            m_pThreadsObject = nullptr;
+            m_nObjectTag = CYTHREAD_NO_TAG;
+        }
+        else
+        {
+            m_objThreadsTask = CYThreadTask{};
+        }
+        pTaskGroup = m_pTaskGroup;
+        m_pTaskGroup = nullptr;
+
+        // Only a cancelled task costs a new shared state.
+        if (m_objTaskStopSource.get_token().stop_requested() && !m_ptrThread->get_stop_token().stop_requested())
+        {
+            m_objTaskStopSource = CYStopSource{};
+        }
+    }
+    SetThreadAvail(CYThreadStatus::STATUS_THREAD_PURGING);
+
+    // Last touch of the group, a waiter may release it right after.
+    if (pTaskGroup)
+    {
+        pTaskGroup->OnTaskFinished();
+    }
+
+    if (m_funOnTaskFinished)
+    {
+        m_funOnTaskFinished();
+    }
+}
+
+/**
+ * Signal the stop token handed to the running (or just dispatched) task.
+ * @param pInvokingObject Only signal if this object is the task, nullptr signals whatever task it is.
+ * @return True if a task was signalled.
+ */
+bool CYThread::RequestTaskStop(ICYIThreadableObject* pInvokingObject) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    if (pInvokingObject && pInvokingObject != m_pThreadsObject && pInvokingObject != m_pNextThreadsObject)
+    {
+        return false;
+    }
+
+    m_objTaskStopSource.request_stop();
+    return true;
+}
+
+/**
+ * Signal the stop token of the current task if it belongs to pTaskGroup or one of its children.
+ * @param pTaskGroup - The cancelled group.
+ * @return True if a task was signalled.
+ */
+bool CYThread::RequestGroupStop(const CYTaskGroup* pTaskGroup) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    bool bSignalled = false;
+
+    // Each task run inline has its own source, only the ones of the group are signalled.
+    for (auto pHelped = m_pHelpedTask; pHelped; pHelped = pHelped->pOuter)
+    {
+        if (pHelped->pTaskGroup && pHelped->pTaskGroup->IsWithin(pTaskGroup))
+        {
+            pHelped->objStopSource.request_stop();
+            bSignalled = true;
+        }
+    }
+
+    const bool bCurrent = m_pTaskGroup && m_pTaskGroup->IsWithin(pTaskGroup);
+    const bool bNext = m_pNextTaskGroup && m_pNextTaskGroup->IsWithin(pTaskGroup);
+    if (bCurrent || bNext)
+    {
+        m_objTaskStopSource.request_stop();
+        bSignalled = true;
+    }
+    return bSignalled;
+}
+
+/**
+ * Note a queued task this worker runs inline while its own task waits.
+ * @param objHelped - The helped task, it stays linked until LeaveHelpedTask.
+ * @return Token of the helped task, only cancelling its group signals it.
+ */
+CYStopToken CYThread::EnterHelpedTask(CYHelpedTask& objHelped) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    objHelped.pOuter = std::exchange(m_pHelpedTask, &objHelped);
+    return objHelped.objStopSource.get_token();
+}
+
+/**
+ * Forget the task run inline, before its group is released.
+ * @param objHelped - The task passed to EnterHelpedTask.
+ */
+void CYThread::LeaveHelpedTask(CYHelpedTask& objHelped) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    m_pHelpedTask = objHelped.pOuter;
+}
+
+/**
+ * Signal the stop token of the current task if it carries the tag.
+ * @param nTag - The cancelled tag.
+ * @return True if a task was signalled.
+ */
+bool CYThread::RequestTagStop(CYTaskTag nTag) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    auto funHasTag = [nTag](const ICYIThreadableObject* pObject, CYTaskTag nObjectTag, const CYThreadTask& objTask) {
+        return pObject ? nObjectTag == nTag : objTask.nTag == nTag;
+    };
+    const bool bCurrent = (m_pThreadsObject || m_objThreadsTask.funTaskToExecute || m_objThreadsTask.funCancellableTaskToExecute) &&
+        funHasTag(m_pThreadsObject, m_nObjectTag, m_objThreadsTask);
+    const bool bNext = (m_pNextThreadsObject || m_objNextThreadsTask.funTaskToExecute || m_objNextThreadsTask.funCancellableTaskToExecute) &&
+        funHasTag(m_pNextThreadsObject, m_nNextObjectTag, m_objNextThreadsTask);
+    if (!bCurrent && !bNext)
+    {
+        return false;
+    }
+
+    m_objTaskStopSource.request_stop();
+    return true;
+}
+
 /**
  * Allows the thread to execute (run).
  * @note This method is called by the thread pool, not by the user.
@@ -151,6 +486,8 @@ void CYThread::TerminateThread()
 {
     if (m_ptrThread && m_ptrThread->joinable())
     {
+        // Let a long-running task bail out instead of blocking the join.
+        RequestTaskStop();
         m_ptrThread->request_stop();
         m_objCondVar.notify_one();
         m_ptrThread->join();
@@ -56,7 +56,12 @@
 #include <future>
 #include "CYThreadProperties.hpp"
 #include "CYThread/ICYThread.hpp"
+#include "CYThread/CYTaskGroup.hpp"
 #include "CYJThread.hpp"
+#include "CYPoolMetrics.hpp"
+#include "CYPoolTrace.hpp"
+#include "CYPerfCounters.hpp"
+#include "CYTagTable.hpp"
 
 CYTHRAD_NAMESPACE_BEGIN
 
@@ -126,6 +131,18 @@ private:
     };
 };
 
+/**
+ * A queued task a worker runs inline while its own task waits. Its stop source is its own, so
+ * cancelling the helped task's group leaves the waiting task alone. Nested helps are linked
+ * through pOuter on the worker while they run.
+ */
+struct CYHelpedTask
+{
+    CYTaskGroup* pTaskGroup{ nullptr };
+    CYStopSource objStopSource;
+    CYHelpedTask* pOuter{ nullptr };
+};
+
 class CYThread
 {
 public:
@@ -163,6 +180,28 @@ public:
      */
     virtual void ChangeThreadPropertiesandResume(ICYIThreadableObject* pAttributes);
 
+    /**
+     * Hand a group task to the thread and then execute it.
+     * @param objAttributes - The task to execute.
+     * @param pTaskGroup - The group the task was submitted through, may be nullptr.
+     */
+    void ChangeThreadPropertiesandResume(const CYThreadTask& objAttributes, CYTaskGroup* pTaskGroup);
+
+    /**
+     * Hand a group task to the thread without copying it and then execute it.
+     * @param objAttributes - The task to execute, moved into the thread.
+     * @param pTaskGroup - The group the task was submitted through, may be nullptr.
+     */
+    void ChangeThreadPropertiesandResume(CYThreadTask&& objAttributes, CYTaskGroup* pTaskGroup);
+
+    /**
+     * Hand a group object task to the thread and then execute it.
+     * @param pAttributes - The object to execute.
+     * @param pTaskGroup - The group the object was submitted through, may be nullptr.
+     * @param nTag - Tag of the object, taken when it was queued so the worker never asks the object again.
+     */
+    void ChangeThreadPropertiesandResume(ICYIThreadableObject* pAttributes, CYTaskGroup* pTaskGroup, CYTaskTag nTag);
+
     /**
      * Alter the threads execution properties.
      * @param objExecutionProps - The execution properties of the thread to be changed.
@@ -175,6 +214,164 @@ public:
      */
     virtual uint32_t ExecuteThread() noexcept;
 
+    /**
+     * Get the index of the worker in its pool.
+     * @return Worker index.
+     */
+    [[nodiscard]] size_t GetWorkerIndex() const noexcept
+    {
+        return m_nWorkerIndex;
+    }
+
+    /**
+     * Set the index of the worker in its pool.
+     * @param nWorkerIndex - The index.
+     */
+    void SetWorkerIndex(size_t nWorkerIndex) noexcept
+    {
+        m_nWorkerIndex = nWorkerIndex;
+    }
+
+    /**
+     * Set the hooks run on the worker thread around its task loop.
+     * @param funOnStart - Runs before the first task, may be empty.
+     * @param funOnStop - Runs after the last task, may be empty.
+     * @note Must be called before CreateThread.
+     */
+    void SetWorkerHooks(const CYWorkerHook& funOnStart, const CYWorkerHook& funOnStop)
+    {
+        m_funOnWorkerStart = funOnStart;
+        m_funOnWorkerStop = funOnStop;
+    }
+
+    /**
+     * Set the hook the worker runs on its own thread after each task it finished.
+     * @param funOnTaskFinished - The hook, may be empty.
+     * @note Must be called before CreateThread.
+     */
+    void SetTaskFinishedHook(std::function<void()> funOnTaskFinished)
+    {
+        m_funOnTaskFinished = std::move(funOnTaskFinished);
+    }
+
+    /**
+     * Set how the worker uses its scratch arena.
+     * @param eResetMode - When the arena is reset.
+     * @param nBlockSize - Size of the first block of the arena.
+     * @param pScratchFrame - Frame counter of the pool, read in RESET_PER_FRAME mode.
+     * @note Must be called before CreateThread.
+     */
+    void SetScratchArena(CYArenaResetMode eResetMode, size_t nBlockSize, const std::atomic<uint64_t>* pScratchFrame) noexcept
+    {
+        m_eScratchResetMode = eResetMode;
+        m_objScratchArena.SetBlockSize(nBlockSize);
+        m_pScratchFrame = pScratchFrame;
+    }
+
+    /**
+     * Set the metrics slot the worker records its tasks in.
+     * @param pMetrics - Slot of this worker, nullptr to record nothing.
+     * @note Must be called before CreateThread.
+     */
+    void SetMetrics(CYWorkerMetrics* pMetrics) noexcept
+    {
+        m_pMetrics = pMetrics;
+    }
+
+    /**
+     * Set the trace ring the worker records its tasks and idle spans in.
+     * @param pTrace - Ring of this worker, nullptr to record nothing.
+     * @note Must be called before CreateThread.
+     */
+    void SetTrace(CYTraceRing* pTrace) noexcept
+    {
+        m_pTrace = pTrace;
+    }
+
+    /**
+     * Let the worker read performance counters and CPU time around every task.
+     * @param bPerfEvents - True to read the perf_event_open counters.
+     * @param bCpuTime - True to read CPU time and wall time.
+     * @param pMemoryResource - Resource the per-type sums are allocated from.
+     * @note Must be called before CreateThread, the counters are opened on the worker thread.
+     */
+    void SetPerfCounters(bool bPerfEvents, bool bCpuTime, std::pmr::memory_resource* pMemoryResource)
+    {
+        m_ptrPerfCounters = std::make_unique<CYPerfCounters>(bPerfEvents, bCpuTime, pMemoryResource);
+    }
+
+    /**
+     * Set the tag table the worker records its tagged tasks in.
+     * @param pTagTable - Table of the pool, nullptr to record nothing.
+     * @param bCpuTime - True to read the CPU time of tagged tasks.
+     * @note Must be called before CreateThread.
+     */
+    void SetTagTable(const CYTagTable* pTagTable, bool bCpuTime) noexcept
+    {
+        m_pTagTable = pTagTable;
+        m_bTagCpuTime = bCpuTime;
+    }
+
+    /**
+     * Get the performance counters of the worker.
+     * @return The counters, nullptr if the worker does not sample tasks.
+     */
+    [[nodiscard]] const CYPerfCounters* GetPerfCounters() const noexcept
+    {
+        return m_ptrPerfCounters.get();
+    }
+
+    /**
+     * Get the metrics slot of the worker.
+     * @return The slot, nullptr if the worker records nothing.
+     */
+    [[nodiscard]] CYWorkerMetrics* GetMetrics() const noexcept
+    {
+        return m_pMetrics;
+    }
+
+    /**
+     * Leave the running task out of the metrics, for pool tasks that record the tasks they run themselves.
+     * @note Called on the worker thread.
+     */
+    void ExcludeTaskFromMetrics() noexcept
+    {
+        m_nTaskStartNs = 0;
+        if (m_ptrPerfCounters)
+        {
+            m_ptrPerfCounters->CancelSample();
+        }
+    }
+
+    /**
+     * Get the scratch arena of the worker.
+     * @return The arena.
+     * @note Only the worker thread may use it.
+     */
+    [[nodiscard]] CYScratchArena& GetScratchArena() noexcept
+    {
+        return m_objScratchArena;
+    }
+
+    /**
+     * Release the scratch memory of a task run inline by this worker.
+     * @param objMark - Arena position taken before the task ran.
+     * @note Called on the worker thread, does nothing in RESET_PER_FRAME mode.
+     */
+    void RewindScratchArena(const CYScratchMark& objMark) noexcept
+    {
+        if (m_eScratchResetMode == CYArenaResetMode::RESET_PER_TASK)
+        {
+            m_objScratchArena.Rewind(objMark);
+        }
+    }
+
+    /**
+     * Get the worker running on the calling thread.
+     * @return The worker, nullptr if the caller is not a pool thread.
+     */
+    [[nodiscard]] static CYThread* GetCurrentThread() noexcept;
+
     /**
      * Allows the thread to execute (run).
      * @note This method is called by the thread pool, not by the user.
@@ -187,6 +384,40 @@ public:
      */
     virtual void TerminateThread();
 
+    /**
+     * Signal the stop token handed to the running (or just dispatched) task.
+     * @param pInvokingObject Only signal if this object is the task, nullptr signals whatever task it is.
+     * @return True if a task was signalled.
+     */
+    bool RequestTaskStop(ICYIThreadableObject* pInvokingObject = nullptr) noexcept;
+
+    /**
+     * Signal the stop token of the current task if it belongs to pTaskGroup or one of its children.
+     * @param pTaskGroup - The cancelled group.
+     * @return True if a task was signalled.
+     */
+    bool RequestGroupStop(const CYTaskGroup* pTaskGroup) noexcept;
+
+    /**
+     * Note a queued task this worker runs inline while its own task waits.
+     * @param objHelped - The helped task, it stays linked until LeaveHelpedTask.
+     * @return Token of the helped task, only cancelling its group signals it.
+     */
+    [[nodiscard]] CYStopToken EnterHelpedTask(CYHelpedTask& objHelped) noexcept;
+
+    /**
+     * Forget the task run inline, before its group is released.
+     * @param objHelped - The task passed to EnterHelpedTask.
+     */
+    void LeaveHelpedTask(CYHelpedTask& objHelped) noexcept;
+
+    /**
+     * Signal the stop token of the current task if it carries the tag.
+     * @param nTag - The cancelled tag.
+     * @return True if a task was signalled.
+     */
+    bool RequestTagStop(CYTaskTag nTag) noexcept;
+
     /**
      * Suspend a thread from executing.
      * @note This method is called by the thread pool, not by the user.
@@ -257,10 +488,116 @@ protected:
     std::atomic<int32_t>    m_nChangedThreadsObject{ 0 };
     ICYIThreadableObject* m_pNextThreadsObject{ nullptr };
 
+    /**
+     * Tag of the current and of the next object, captured at dispatch. The object may be gone once
+     * TaskToExecute() returned, so the bookkeeping after it only uses these. Guarded by m_objMutex.
+     */
+    CYTaskTag m_nObjectTag{ CYTHREAD_NO_TAG };
+    CYTaskTag m_nNextObjectTag{ CYTHREAD_NO_TAG };
+
+    /**
+     * Group of the current and of the next task, guarded by m_objMutex.
+     */
+    CYTaskGroup*          m_pTaskGroup{ nullptr };
+    CYTaskGroup*          m_pNextTaskGroup{ nullptr };
+
+    /**
+     * Innermost task run inline, guarded by m_objMutex.
+     */
+    CYHelpedTask*         m_pHelpedTask{ nullptr };
+
+    /**
+     * Stop source of the current task. It is shared by consecutive tasks and only
+     * replaced after a stop was requested, so handing out tokens never allocates.
+     */
+    CYStopSource                  m_objTaskStopSource;
+
+private:
+    /**
+     * Get the stop token for the task that is about to run.
+     */
+    [[nodiscard]] CYStopToken AcquireTaskStopToken() noexcept;
+
+    /**
+     * Run a worker hook on this thread.
+     * @param funHook - The hook, may be empty.
+     * @note A throwing hook must not take the worker down.
+     */
+    void RunWorkerHook(const CYWorkerHook& funHook) noexcept;
+
+    /**
+     * Reset the scratch arena if the pool started a new frame.
+     */
+    void PrepareScratchArena() noexcept;
+
+    /**
+     * Note the start time and the counters of the task that is about to run.
+     * @param objTaskType - Type of the task object or callable.
+     * @param nTag - Tag of the task.
+     */
+    void BeginTask(const std::type_info& objTaskType, CYTaskTag nTag) noexcept
+    {
+        const bool bTagged = m_pTagTable && nTag != CYTHREAD_NO_TAG;
+        const uint64_t nNow = m_pMetrics || m_pTrace || bTagged ? CYPoolMetrics::GetTimeNs() : 0;
+        m_nTaskStartNs = m_pMetrics ? nNow : 0;
+        m_nTraceStartNs = m_pTrace ? nNow : 0;
+        m_nTagStartNs = bTagged ? nNow : 0;
+        m_nTagCpuStartNs = bTagged && m_bTagCpuTime ? CYPerfCounters::GetThreadCpuTimeNs() : 0;
+        if (m_ptrPerfCounters)
+        {
+            m_ptrPerfCounters->BeginSample(objTaskType);
+        }
+    }
+
+    /**
+     * Mark the current task as finished, record its execution time, trace span and counters, release its scratch memory and recycle a signalled stop source.
+     * @param bObjectTask True if the finished task was an object task.
+     */
+    void FinishTask(bool bObjectTask) noexcept;
+
+protected:
+
     std::unique_ptr<CYJThread> m_ptrThread;
     std::mutex                    m_objMutex;
     std::condition_variable       m_objCondVar;
     std::atomic<bool>             m_bSuspended{ false };
+    size_t                        m_nWorkerIndex{ 0 };
+    CYWorkerHook                  m_funOnWorkerStart;
+    CYWorkerHook                  m_funOnWorkerStop;
+    std::function<void()>         m_funOnTaskFinished;
+
+    /**
+     * Scratch memory of the tasks, only touched by the worker thread.
+     */
+    CYScratchArena                m_objScratchArena;
+    CYArenaResetMode              m_eScratchResetMode{ CYArenaResetMode::RESET_PER_TASK };
+    const std::atomic<uint64_t>*  m_pScratchFrame{ nullptr };
+    uint64_t                      m_nScratchFrame{ 0 };
+
+    /**
+     * Metrics slot of the worker and start time of the running task, 0 while it is not measured.
+     */
+    CYWorkerMetrics*              m_pMetrics{ nullptr };
+    uint64_t                      m_nTaskStartNs{ 0 };
+
+    /**
+     * Trace ring of the worker and start time of the running task in the trace.
+     */
+    CYTraceRing*                  m_pTrace{ nullptr };
+    uint64_t                      m_nTraceStartNs{ 0 };
+
+    /**
+     * Tag table of the pool and start times of the running tagged task, 0 while it is not measured.
+     */
+    const CYTagTable*             m_pTagTable{ nullptr };
+    bool                          m_bTagCpuTime{ false };
+    uint64_t                      m_nTagStartNs{ 0 };
+    uint64_t                      m_nTagCpuStartNs{ 0 };
+
+    /**
+     * Performance counters of the worker, nullptr unless the pool samples tasks.
+     */
+    std::unique_ptr<CYPerfCounters> m_ptrPerfCounters;
 };
 
 CYTHRAD_NAMESPACE_END
@@ -5,127 +5,1676 @@
 #include <thread>
 #include <chrono>
 #include <stdexcept>
+#include <algorithm>
+#include <optional>
 
 CYTHRAD_NAMESPACE_BEGIN
 
+namespace
+{
+    /**
+     * Write to nBytes of the calling thread's stack so its pages are mapped before the first task.
+     * @param nBytes Stack bytes to touch.
+     */
+    void TouchStack(size_t nBytes) noexcept
+    {
+        constexpr size_t STACK_CHUNK_SIZE = 4096;
+        volatile unsigned char arrChunk[STACK_CHUNK_SIZE];
+        for (size_t i = 0; i < STACK_CHUNK_SIZE; i += 64)
+        {
+            arrChunk[i] = 0;
+        }
+
+        if (nBytes > STACK_CHUNK_SIZE)
+        {
+            TouchStack(nBytes - STACK_CHUNK_SIZE);
+        }
+
+        // Read after the call so the recursion cannot become a loop that reuses this frame.
+        (void)arrChunk[0];
+    }
+}
+
+/**
+ * Constructor.
+ */
+CYThreadPool::CYThreadPool()
+{
+}
+
+CYThreadPool::~CYThreadPool()
+{
+    (void)Shutdown();
+}
+
+/**
+ * Shutdown thread pool.
+ * @return True if success, false otherwise.
+ * @note This function will terminate all working threads and release resources.
+ */
+bool CYThreadPool::Shutdown() noexcept
+{
+    return Shutdown(CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE);
+}
+
+/**
+ * Shutdown thread pool using the given mode.
+ * @param eMode Shutdown mode.
+ * @param nTimeoutMs Drain deadline in milliseconds, only used by SHUTDOWN_MODE_DRAIN_DEADLINE.
+ * @param funOnCancelled Callback invoked for every pending task that is dropped.
+ * @return True if every pending task was executed or handed to the callback before the workers stopped,
+ *         false if the drain deadline expired.
+ */
+bool CYThreadPool::Shutdown(CYShutdownMode eMode, uint32_t nTimeoutMs, const CYCancelledTaskCallback& funOnCancelled) noexcept
+{
+    bool bDrained = true;
+
+    // Refuse new submissions and timers while the remaining work is settled. Timers were accepted
+    // when they were scheduled: DRAIN still runs the one-shot timers that are already due, every
+    // other timer task is dropped and reported like a pending task.
+    std::pmr::vector<CYThreadTask> lstDroppedTimer(m_objTaskNodePool.GetMemoryResource());
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        m_objTPProps.SetTaskPoolLock(true);
+
+        std::pmr::vector<CYThreadTask> lstDueTimer(m_objTaskNodePool.GetMemoryResource());
+        {
+            std::lock_guard<std::mutex> objTimerLock(m_objTimerMutex);
+            m_bTimersClosed = true;
+            m_objTimerWheel.Clear(lstDroppedTimer, std::chrono::steady_clock::now(),
+                eMode == CYShutdownMode::SHUTDOWN_MODE_DRAIN ? &lstDueTimer : nullptr);
+        }
+
+        const size_t nWorker = GetCurrentWorker();
+        for (auto& objTask : lstDueTimer)
+        {
+            const CYTaskTag nTag = objTask.nTag;
+            CYQueuedTask objEntry{ std::move(objTask) };
+            if (m_lstTask.PushFront(std::move(objEntry), nWorker))
+            {
+                RecordSubmit(nWorker, 1, nTag);
+                continue;
+            }
+            try { lstDroppedTimer.push_back(std::move(objEntry.objTask)); }
+            catch (...) {}
+        }
+    }
+
+    if (eMode != CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE && funOnCancelled)
+    {
+        for (auto& objTask : lstDroppedTimer)
+        {
+            try { funOnCancelled(&objTask, nullptr); }
+            catch (...) {}
+        }
+    }
+
+    switch (eMode)
+    {
+    case CYShutdownMode::SHUTDOWN_MODE_DRAIN:
+#undef max
+        bDrained = WaitForDrain(std::chrono::steady_clock::time_point::max());
+        break;
+    case CYShutdownMode::SHUTDOWN_MODE_DRAIN_DEADLINE:
+        bDrained = WaitForDrain(std::chrono::steady_clock::now() + std::chrono::milliseconds(nTimeoutMs));
+        CancelPendingTasks(funOnCancelled);
+        break;
+    case CYShutdownMode::SHUTDOWN_MODE_CANCEL_PENDING:
+        CancelPendingTasks(funOnCancelled);
+        break;
+    case CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE:
+    default:
+        // Nothing is reported, but groups still have to see their tasks go away.
+        CancelPendingTasks(nullptr);
+        break;
+    }
+
+    // Region tasks are never cancelled and their caller waits for them, so the workers stay up until they ran.
+    {
+        std::unique_lock<std::mutex> lock(m_objMutex);
+        m_objCondVar.wait(lock, [this] { return m_nActiveRegions == 0; });
+    }
+
+    // Stop the distribution thread first (before acquiring the main mutex)
+    StopDistributionThread();
+
+    // Workers take m_objMutex after every task to wake drain waiters, so they are joined without it.
+    // No worker is added once m_bShutdown is set, concurrent calls serialize on the join lock.
+    std::lock_guard<std::mutex> objJoinLock(m_objJoinMutex);
+    {
+        std::unique_lock<std::mutex> lock(m_objMutex);
+        m_objSpawnCondVar.wait(lock, [this] { return !m_bSpawning; });
+        m_bShutdown.store(true, std::memory_order_release);
+        m_objCondVar.notify_all();
+    }
+
+    for (auto& objThread : m_lstThread)
+    {
+        if (objThread)
+        {
+            objThread->TerminateThread();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    m_nThreadCount.store(0, std::memory_order_release);
+    m_lstThread.clear();
+    m_lstTask.Clear(SIZE_MAX);
+    {
+        std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+        m_objCompactQueue.Clear();
+    }
+
+    return bDrained;
+}
+
+/**
+ * Wait until every queued task has been dispatched and executed.
+ * @param tpDeadline Time point after which the wait gives up.
+ * @return True if the pool drained, false if the deadline expired.
+ */
+bool CYThreadPool::WaitForDrain(std::chrono::steady_clock::time_point tpDeadline) noexcept
+{
+    std::unique_lock<std::mutex> lock(m_objMutex);
+    auto funIdle = [this] {
+        return GetPendingTaskCount() == 0 &&
+            std::none_of(m_lstThread.begin(), m_lstThread.end(),
+                [](const auto& thread) {
+                    return thread->GetThreadAvail() == CYThreadStatus::STATUS_THREAD_EXECUTING;
+                });
+    };
+
+    // Registered before the first check, so a worker finishing right after it sees the waiter.
+    m_nDrainWaiters.fetch_add(1, std::memory_order_seq_cst);
+    bool bDrained = true;
+    if (tpDeadline == std::chrono::steady_clock::time_point::max())
+    {
+        m_objCondVar.wait(lock, funIdle);
+    }
+    else
+    {
+        bDrained = m_objCondVar.wait_until(lock, tpDeadline, funIdle);
+    }
+    m_nDrainWaiters.fetch_sub(1, std::memory_order_relaxed);
+    return bDrained;
+}
+
+/**
+ * Wake the threads in WaitForDrain after a task finished, the caller must not hold m_objMutex.
+ * @note Called by the workers after every task, it only locks while someone waits.
+ */
+void CYThreadPool::NotifyDrainWaiters() const noexcept
+{
+    // Orders the worker's status change before the check, pairs with the registration in WaitForDrain.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_nDrainWaiters.load(std::memory_order_relaxed) != 0)
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        m_objCondVar.notify_all();
+    }
+}
+
+/**
+ * Remove all pending tasks and report each one through the callback.
+ * @param funOnCancelled Callback invoked outside the pool lock, may be empty.
+ */
+void CYThreadPool::CancelPendingTasks(const CYCancelledTaskCallback& funOnCancelled) noexcept
+{
+    TaskList lstTask(m_objTaskNodePool);
+    CYCompactTaskQueue lstCompact;
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        lstTask.SpliceBack(m_lstTask);
+        std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+        (void)lstCompact.SetMemoryResource(m_objCompactQueue.GetMemoryResource());
+        lstCompact.SpliceBack(m_objCompactQueue);
+    }
+
+    // Oldest first, whatever the kind.
+    for (auto pRecord = lstTask.GetBack(); pRecord; )
+    {
+        auto pNewer = pRecord->pPrev;
+        if (pRecord->eKind == CYTaskKind::TASK_KIND_FUNCTION && TaskList::GetNode(pRecord)->objValue.bRegion)
+        {
+            // Region tasks go back to the queue, the workers still have to run them.
+            pRecord = pNewer;
+            continue;
+        }
+
+        auto pTaskGroup = pRecord->pTaskGroup;
+        m_objTagTable.OnCancel(pRecord->nTag, 1, false);
+        if (pRecord->eKind == CYTaskKind::TASK_KIND_OBJECT)
+        {
+            // Release the object before the callback, which may submit it again.
+            auto pObject = TaskList::GetHook(pRecord)->pObject;
+            lstTask.Erase(pRecord, SIZE_MAX);
+            if (funOnCancelled)
+            {
+                try { funOnCancelled(nullptr, pObject); }
+                catch (...) {}
+            }
+        }
+        else
+        {
+            if (funOnCancelled)
+            {
+                try { funOnCancelled(&TaskList::GetNode(pRecord)->objValue.objTask, nullptr); }
+                catch (...) {}
+            }
+            lstTask.Erase(pRecord, SIZE_MAX);
+        }
+
+        if (pTaskGroup)
+        {
+            pTaskGroup->OnTaskFinished();
+        }
+        pRecord = pNewer;
+    }
+
+    if (!lstTask.Empty())
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        m_lstTask.SpliceBack(lstTask);
+    }
+
+    // Compact tasks are reported as function tasks that would run the procedure on pArgList.
+    CYCompactTask arrTask[COMPACT_CHUNK_SIZE];
+    while (funOnCancelled)
+    {
+        const size_t nCount = lstCompact.Pop(arrTask, COMPACT_CHUNK_SIZE);
+        if (nCount == 0)
+        {
+            break;
+        }
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex)
+        {
+            CYThreadTask objTask;
+            objTask.funTaskToExecute = [pfnTask = arrTask[nIndex].pfnTask](void* pContext, bool) { pfnTask(pContext); };
+            objTask.pArgList = arrTask[nIndex].pContext;
+            try { funOnCancelled(&objTask, nullptr); }
+            catch (...) {}
+        }
+    }
+}
+
+/**
+ * Count queued tasks of every kind, the caller must hold m_objMutex.
+ * @return Pending task count.
+ */
+size_t CYThreadPool::GetPendingTaskCount() const noexcept
+{
+    std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+    return m_lstTask.Size() + m_objCompactQueue.Size();
+}
+
+/**
+ * Get a snapshot of the pool metrics.
+ * @return Counters, queue depth and latency histograms.
+ * @note The counters are merged from the worker slots without stopping the workers,
+ *       a task may show up as started before it shows up as submitted.
+ */
+CYThreadPoolMetrics CYThreadPool::GetMetrics() const noexcept
+{
+    CYThreadPoolMetrics objMetrics;
+    m_objMetrics.Collect(objMetrics);
+
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    objMetrics.nQueueDepth = GetPendingTaskCount();
+    return objMetrics;
+}
+
+/**
+ * Create thread pool with specified platform and max threads.
+ * @param eThreadType Platform type.
+ * @param iMaxThread Max thread count.
+ * @return True if success, false otherwise.
+ */
+bool CYThreadPool::CreateThreadPool(const CYPlatformId& eThreadType, int iMaxThread) noexcept
+{
+    return CreateThreadPool(eThreadType, iMaxThread, CYThreadPoolOptions{});
+}
+
+/**
+ * Create thread pool with specified platform, max threads and creation options.
+ * @param eThreadType Platform type.
+ * @param iMaxThread Max thread count.
+ * @param objOptions Worker hooks and other creation options.
+ * @return True if success, false otherwise.
+ */
+bool CYThreadPool::CreateThreadPool(const CYPlatformId& eThreadType, int iMaxThread, const CYThreadPoolOptions& objOptions) noexcept
+{
+    try
+    {
+        std::unique_lock<std::mutex> lock(m_objMutex);
+
+        // Set thread pool properties
+        m_objOptions = objOptions;
+        m_eThreadType = eThreadType;
+        m_objTPProps.SetMaxTasks(25);
+        m_objTPProps.SetMaxThreads(iMaxThread);
+        m_objTPProps.SetTaskPoolLock(false);
+        // Enough nodes for full queues plus one refill per worker, the pool only allocates beyond that.
+        const size_t nWorkerCount = static_cast<size_t>(m_objTPProps.GetMaxThreadCount());
+        const size_t nReserve = (static_cast<size_t>(m_objTPProps.GetMaxTasks()) + 1) * 2 + nWorkerCount * decltype(m_objTaskNodePool)::GetRefillCount();
+        // The resource only applies to a pool that has not allocated yet.
+        (void)m_objTaskNodePool.SetMemoryResource(m_objOptions.pMemoryResource);
+        {
+            std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+            (void)m_objCompactQueue.SetMemoryResource(m_objTaskNodePool.GetMemoryResource());
+        }
+        {
+            std::lock_guard<std::mutex> objTimerLock(m_objTimerMutex);
+            (void)m_objTimerWheel.SetMemoryResource(m_objTaskNodePool.GetMemoryResource());
+            m_bTimersClosed = false;
+        }
+        m_objTaskNodePool.SetWorkerCount(nWorkerCount);
+        m_objTaskNodePool.Reserve(nReserve);
+        m_objMetrics.SetWorkerCount(nWorkerCount, m_objTaskNodePool.GetMemoryResource());
+        m_objTrace.SetWorkerCount(nWorkerCount, m_objOptions.nTraceCapacity, m_objTaskNodePool.GetMemoryResource());
+        m_objTagTable.Create(m_objTaskNodePool.GetMemoryResource());
+        m_lstThread.reserve(nWorkerCount);
+
+        // Lazy pools start without workers, the dispatcher spawns them on demand.
+        if (m_objOptions.eSpawnMode != CYWorkerSpawnMode::SPAWN_MODE_LAZY)
+        {
+            // Thread creation is the slow part, tasks submitted meanwhile only queue up.
+            lock.unlock();
+            ThreadList lstWorker = CreateWorkers(0, nWorkerCount, m_objOptions.eSpawnMode == CYWorkerSpawnMode::SPAWN_MODE_PARALLEL);
+            lock.lock();
+
+            for (auto& thread : lstWorker)
+            {
+                m_lstThread.push_back(std::move(thread));
+            }
+            m_nThreadCount.store(m_lstThread.size(), std::memory_order_release);
+            if (m_lstThread.empty())
+            {
+                return false;
+            }
+        }
+
+        // Start the task distribution thread
+        StartDistributionThread();
+
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+/**
+ * Write the recorded submit, dispatch, task and idle events as Chrome trace JSON.
+ * @param objStream Output stream.
+ * @return True if tracing is on and the stream took the trace.
+ * @note The workers keep recording while the trace is written, the rings are not locked.
+ */
+bool CYThreadPool::WriteTrace(std::ostream& objStream) const noexcept
+{
+    try
+    {
+        return m_objTrace.WriteJson(objStream);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+/**
+ * Get the performance counters and CPU time of the finished tasks, summed per task type.
+ * @return One entry per task type, most frequent first, empty unless the pool samples tasks.
+ * @note Tasks run by batches, compact runners or ExecutePendingTask are not sampled.
+ */
+std::vector<CYTaskPerfStats> CYThreadPool::GetPerfStats() const noexcept
+{
+    try
+    {
+        std::unordered_map<std::type_index, CYTaskPerfStats> mapStats;
+        {
+            std::lock_guard<std::mutex> lock(m_objMutex);
+            for (const auto& thread : m_lstThread)
+            {
+                if (auto pPerfCounters = thread->GetPerfCounters())
+                {
+                    pPerfCounters->Collect(mapStats);
+                }
+            }
+        }
+
+        std::vector<CYTaskPerfStats> lstStats;
+        lstStats.reserve(mapStats.size());
+        for (const auto& [objType, objStats] : mapStats)
+        {
+            lstStats.push_back(objStats);
+        }
+        std::sort(lstStats.begin(), lstStats.end(), [](const auto& objLeft, const auto& objRight) {
+            return objLeft.nTaskCount > objRight.nTaskCount;
+        });
+        return lstStats;
+    }
+    catch (const std::exception&)
+    {
+        return {};
+    }
+}
+
+/**
+ * Get counts, latencies and CPU time of every tag seen so far.
+ * @return One entry per tag, in no particular order.
+ * @note The counters are read without stopping the workers, a task may show up as completed
+ *       before it shows up as submitted.
+ */
+std::vector<CYTaskTagStats> CYThreadPool::GetTagStats() const noexcept
+{
+    try
+    {
+        std::vector<CYTaskTagStats> lstStats;
+        m_objTagTable.Collect(lstStats);
+        return lstStats;
+    }
+    catch (const std::exception&)
+    {
+        return {};
+    }
+}
+
+/**
+ * Wait until no task of the tag is queued or running.
+ * @param nTag Tag.
+ * @param nTimeoutMs Timeout in milliseconds, UINT32_MAX waits forever.
+ * @return 0 if the tag is idle, 1 on timeout.
+ * @note A task must not wait for its own tag, it would wait for itself.
+ */
+uint32_t CYThreadPool::WaitForTag(CYTaskTag nTag, uint32_t nTimeoutMs) noexcept
+{
+    return m_objTagTable.Wait(nTag, nTimeoutMs);
+}
+
+/**
+ * Drop the queued tasks of a tag and signal the running ones.
+ * @param nTag Tag.
+ * @return Number of queued tasks dropped.
+ * @note Running tasks only stop early if they poll their stop token.
+ */
+size_t CYThreadPool::CancelTag(CYTaskTag nTag) noexcept
+{
+    if (nTag == CYTHREAD_NO_TAG) return 0;
+
+    size_t nDropped = 0;
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    m_lstTask.EraseIf([nTag, &nDropped](CYTaskRecord& objRecord) {
+        if (objRecord.nTag != nTag)
+        {
+            return false;
+        }
+        if (objRecord.pTaskGroup)
+        {
+            objRecord.pTaskGroup->OnTaskFinished();
+        }
+        ++nDropped;
+        return true;
+    }, GetCurrentWorker());
+    m_objTagTable.OnCancel(nTag, nDropped, false);
+
+    for (auto& thread : m_lstThread)
+    {
+        (void)thread->RequestTagStop(nTag);
+    }
+    return nDropped;
+}
+
+/**
+ * Limit how many tasks of a tag run at once.
+ * @param nTag Tag.
+ * @param nMaxRunning Limit, 0 removes it.
+ * @return False if the pool is not created or cannot track more tags.
+ * @note Queued tasks over the limit stay queued and count as missed until a task of the tag finishes.
+ */
+bool CYThreadPool::SetTagConcurrency(CYTaskTag nTag, uint32_t nMaxRunning) noexcept
+{
+    return m_objTagTable.SetConcurrencyLimit(nTag, nMaxRunning);
+}
+
+/**
+ * Submit a objTask to the pool.
+ * @param objTask Task object.
+ * @return True if success, false otherwise.
+ */
+bool CYThreadPool::SubmitTask(const CYThreadTask& objTask) noexcept
+{
+    return SubmitTask(objTask, nullptr);
+}
+
+/**
+ * Submit a objTask to the pool.
+ * @param objTask Task object.
+ * @return True if success, false otherwise.
+ */
+bool CYThreadPool::SubmitTask(ICYIThreadableObject* pInvokingObject) noexcept
+{
+    return SubmitTask(pInvokingObject, nullptr);
+}
+
+/**
+ * Submit a objTask on behalf of a task group.
+ * @param objTask Task object.
+ * @param pTaskGroup Group that tracks the task, may be nullptr.
+ * @return True if success, false otherwise.
+ */
+bool CYThreadPool::SubmitTask(const CYThreadTask& objTask, CYTaskGroup* pTaskGroup) noexcept
+{
+    // The node is taken and filled before the lock, only linking it happens inside.
+    const size_t nWorker = GetCurrentWorker();
+    auto pNode = m_objTaskNodePool.Acquire(nWorker);
+    if (!pNode)
+    {
+        RecordReject(nWorker, objTask.nTag);
+        return false;
+    }
+    pNode->objValue.objTask = objTask;
+    pNode->pTaskGroup = pTaskGroup;
+    pNode->nTag = objTask.nTag;
+
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        if (!m_objTPProps.GetTaskPoolLock() && m_lstTask.GetFreshCount(CYTaskKind::TASK_KIND_FUNCTION) <= static_cast<size_t>(m_objTPProps.GetMaxTasks()))
+        {
+            m_lstTask.LinkFront(pNode);
+            RecordSubmit(nWorker, 1, objTask.nTag);
+            if (pTaskGroup)
+            {
+                pTaskGroup->OnTaskSubmitted();
+            }
+            m_objCondVar.notify_one();
+            return true;
+        }
+    }
+
+    m_objTaskNodePool.Release(pNode, nWorker);
+    RecordReject(nWorker, objTask.nTag);
+    return false;
+}
+
+/**
+ * Submit an object objTask on behalf of a task group.
+ * @param pInvokingObject Object invoking the task.
+ * @param pTaskGroup Group that tracks the task, may be nullptr.
+ * @return True if success, false if the pool rejected it or the object is still queued.
+ */
+bool CYThreadPool::SubmitTask(ICYIThreadableObject* pInvokingObject, CYTaskGroup* pTaskGroup) noexcept
+{
+    if (!pInvokingObject) return false;
+
+    // The object carries its own queue links, which only one queue can use at a time.
+    auto& objHook = pInvokingObject->m_objQueueHook;
+    if (objHook.bQueued.exchange(true, std::memory_order_acquire))
+    {
+        RecordReject(GetCurrentWorker(), pInvokingObject->GetTag());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        if (!m_objTPProps.GetTaskPoolLock() && m_lstTask.GetFreshCount(CYTaskKind::TASK_KIND_OBJECT) <= static_cast<size_t>(m_objTPProps.GetMaxTasks()))
+        {
+            objHook.pObject = pInvokingObject;
+            objHook.pTaskGroup = pTaskGroup;
+            objHook.nTag = pInvokingObject->GetTag();
+            m_lstTask.LinkFront(&objHook);
+            RecordSubmit(GetCurrentWorker(), 1, objHook.nTag);
+            if (pTaskGroup)
+            {
+                pTaskGroup->OnTaskSubmitted();
+            }
+            m_objCondVar.notify_one();
+            return true;
+        }
+    }
+
+    objHook.bQueued.store(false, std::memory_order_release);
+    RecordReject(GetCurrentWorker(), pInvokingObject->GetTag());
+    return false;
+}
+
+/**
+ * Discard the queued tasks of a cancelled group and signal the running ones.
+ * @param pTaskGroup Cancelled group.
+ * @note Queued tasks are unlinked right away through the group's own list, a task still on its
+ *       way into the queue is dropped by the next distribution pass through the group flag.
+ */
+void CYThreadPool::CancelTaskGroup(CYTaskGroup* pTaskGroup) noexcept
+{
+    if (!pTaskGroup) return;
+
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    for (auto& thread : m_lstThread)
+    {
+        thread->RequestGroupStop(pTaskGroup);
+    }
+    DropGroupTasks(pTaskGroup, GetCurrentWorker());
+
+    if (m_nDrainWaiters.load(std::memory_order_relaxed) != 0 && GetPendingTaskCount() == 0)
+    {
+        m_objCondVar.notify_all();
+    }
+}
+
+/**
+ * Remove the queued records of a group and its child groups on this pool, the caller must hold m_objMutex.
+ * @param pTaskGroup Cancelled group.
+ * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+ * @note The group is released last, its owner may destroy it right after.
+ */
+void CYThreadPool::DropGroupTasks(CYTaskGroup* pTaskGroup, size_t nWorker) noexcept
+{
+    int nDropped = 0;
+    while (auto pRecord = pTaskGroup->m_pQueuedRecord)
+    {
+        m_objTagTable.OnCancel(pRecord->nTag, 1, false);
+        m_lstTask.Erase(pRecord, nWorker);
+        ++nDropped;
+    }
+
+    {
+        // A child blocks in its destructor on this lock, so it stays alive while it is visited.
+        std::lock_guard<std::mutex> objChildLock(pTaskGroup->m_objChildMutex);
+        for (auto pChild = pTaskGroup->m_pFirstChild; pChild; pChild = pChild->m_pNextSibling)
+        {
+            // Children on another pool keep their tombstones, their pool drops them.
+            if (pChild->GetThreadPool() == this)
+            {
+                DropGroupTasks(pChild, nWorker);
+            }
+        }
+    }
+
+    while (nDropped-- > 0)
+    {
+        pTaskGroup->OnTaskFinished();
+    }
+}
+
+/**
+ * Run the oldest queued task on the calling thread.
+ * @return True if a task was executed, false if the queues were empty.
+ * @note Used by a worker that blocks on its own children, so they cannot starve behind it.
+ */
+bool CYThreadPool::ExecutePendingTask() noexcept
+{
+    ICYIThreadableObject* pObject = nullptr;
+    CYQueuedTask objTaskEntry;
+    CYCompactTask objCompactEntry;
+    CYTaskGroup* pTaskGroup = nullptr;
+    CYTaskTag nTag = CYTHREAD_NO_TAG;
+    const size_t nCurrentWorker = GetCurrentWorker();
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+
+        // Tasks are pushed to the front, so the oldest record is at the back.
+        auto funPop = [&](bool bObjects, bool bFunctions) {
+            for (auto pRecord = m_lstTask.GetBack(); pRecord; )
+            {
+                auto pNewer = pRecord->pPrev;
+                const bool bObject = pRecord->eKind == CYTaskKind::TASK_KIND_OBJECT;
+                if (bObject ? !bObjects : !bFunctions)
+                {
+                    pRecord = pNewer;
+                    continue;
+                }
+
+                if (DiscardIfCancelled(*pRecord))
+                {
+                    m_lstTask.Erase(pRecord, nCurrentWorker);
+                }
+                else if (!m_objTagTable.IsThrottled(pRecord->nTag) &&
+                    (bObject || !IsPinnedElsewhere(TaskList::GetNode(pRecord)->objValue, nCurrentWorker)))
+                {
+                    // Objects are never pinned.
+                    pTaskGroup = pRecord->pTaskGroup;
+                    nTag = pRecord->nTag;
+                    if (bObject)
+                    {
+                        pObject = TaskList::GetHook(pRecord)->pObject;
+                    }
+                    else
+                    {
+                        objTaskEntry = std::move(TaskList::GetNode(pRecord)->objValue);
+                    }
+                    RecordStart(nCurrentWorker, *pRecord);
+                    m_lstTask.Erase(pRecord, nCurrentWorker);
+                    return true;
+                }
+                pRecord = pNewer;
+            }
+            return false;
+        };
+
+        // Compact tasks carry no time stamp, they are counted without a queue wait.
+        auto funPopCompact = [this, nCurrentWorker](CYCompactTask& objEntry) {
+            std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+            if (m_objCompactQueue.Pop(&objEntry, 1) == 0)
+            {
+                return false;
+            }
+            if (auto pSlot = m_objMetrics.GetSlot(nCurrentWorker))
+            {
+                pSlot->OnStart(0);
+            }
+            return true;
+        };
+
+        const bool bFound = m_objOptions.eTaskOrder == CYTaskOrder::TASK_ORDER_OBJECTS_FIRST ?
+            funPop(true, false) || funPop(false, true) : funPop(true, true);
+        if (!bFound && !funPopCompact(objCompactEntry))
+        {
+            return false;
+        }
+    }
+
+    // A worker helping from inside a task shares its arena with that task, only the helped task's memory is released.
+    auto pCurrent = CYThread::GetCurrentThread();
+    const CYScratchMark objScratchMark = pCurrent ? pCurrent->GetScratchArena().GetMark() : CYScratchMark{};
+    const uint64_t nStartNs = CYPoolMetrics::GetTimeNs();
+    const uint64_t nCpuStartNs = nTag != CYTHREAD_NO_TAG && m_objOptions.bCpuTime ? CYPerfCounters::GetThreadCpuTimeNs() : 0;
+
+    // A worker of this pool links the helped task with a stop source of its own, so cancelling the
+    // helped task's group reaches it without stopping the task that waits on this worker.
+    // Any other thread is no worker slot of the task, nothing could signal the token.
+    auto pWorker = nCurrentWorker != SIZE_MAX ? pCurrent : nullptr;
+    std::optional<CYHelpedTask> objHelped;
+    CYStopToken objStopToken;
+    if (pWorker)
+    {
+        try
+        {
+            objHelped.emplace();
+            objHelped->pTaskGroup = pTaskGroup;
+            objStopToken = pWorker->EnterHelpedTask(*objHelped);
+        }
+        catch (const std::exception&)
+        {
+            // Without a stop source the task runs with a token nothing signals.
+        }
+    }
+    if (pObject)
+    {
+        pObject->TaskToExecute(objStopToken);
+    }
+    else if (objTaskEntry.objTask.funCancellableTaskToExecute)
+    {
+        objTaskEntry.objTask.funCancellableTaskToExecute(objTaskEntry.objTask.pArgList, objStopToken);
+    }
+    else if (objTaskEntry.objTask.funTaskToExecute)
+    {
+        objTaskEntry.objTask.funTaskToExecute(objTaskEntry.objTask.pArgList, objTaskEntry.objTask.bDelete);
+    }
+    else if (objCompactEntry.pfnTask)
+    {
+        objCompactEntry.pfnTask(objCompactEntry.pContext);
+    }
+    if (pWorker && objHelped)
+    {
+        pWorker->LeaveHelpedTask(*objHelped);
+    }
+    const uint64_t nEndNs = CYPoolMetrics::GetTimeNs();
+    m_objMetrics.OnComplete(nCurrentWorker, nEndNs - nStartNs);
+    m_objTrace.RecordSpan(nCurrentWorker, CYTraceEventType::TRACE_EVENT_TASK, nStartNs);
+    if (nTag != CYTHREAD_NO_TAG)
+    {
+        m_objTagTable.OnFinish(nTag, nEndNs - nStartNs, nCpuStartNs ? CYPerfCounters::GetThreadCpuTimeNs() - nCpuStartNs : 0);
+    }
+
+    if (pCurrent)
+    {
+        pCurrent->RewindScratchArena(objScratchMark);
+    }
+
+    if (pTaskGroup)
+    {
+        pTaskGroup->OnTaskFinished();
+    }
+    NotifyDrainWaiters();
+    return true;
+}
+
+/**
+ * Submit a compact objTask, a function pointer plus its context.
+ * @param pfnTask Task procedure.
+ * @param pContext Context handed to the procedure.
+ * @return True if success, false if the pool does not accept tasks or is out of memory.
+ * @note Compact tasks have a queue of their own that MaxTasks does not limit.
+ */
+bool CYThreadPool::SubmitCompactTask(CYCompactTaskProc pfnTask, void* pContext) noexcept
+{
+    if (!pfnTask)
+    {
+        return false;
+    }
+    const CYCompactTask objTask{ pfnTask, pContext };
+    return SubmitCompactTasks(&objTask, 1) == 1;
+}
+
+/**
+ * Submit compact tasks in bulk, the queue is locked once for the whole range.
+ * @param pTasks Task descriptors.
+ * @param nCount Number of descriptors.
+ * @return Number of tasks queued, zero if the pool does not accept tasks.
+ * @note Every descriptor must have a procedure, the range is copied without being checked.
+ */
+size_t CYThreadPool::SubmitCompactTasks(const CYCompactTask* pTasks, size_t nCount) noexcept
+{
+    if (!pTasks || nCount == 0)
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    if (m_objTPProps.GetTaskPoolLock())
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+    const size_t nQueued = m_objCompactQueue.Push(pTasks, nCount);
+    const size_t nWorker = GetCurrentWorker();
+    if (nQueued != 0)
+    {
+        RecordSubmit(nWorker, nQueued);
+        m_objCondVar.notify_one();
+    }
+    if (nQueued != nCount)
+    {
+        RecordReject(nWorker);
+    }
+    return nQueued;
+}
+
+/**
+ * Submit a objTask once the delay has elapsed.
+ * @param nDelay Delay before the task is queued.
+ * @param objTask Task object.
+ * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+ */
+CYTimerId CYThreadPool::SubmitAfter(std::chrono::milliseconds nDelay, const CYThreadTask& objTask)
+{
+    return ScheduleTimer(std::chrono::steady_clock::now() + nDelay, std::chrono::milliseconds::zero(), objTask);
+}
+
+/**
+ * Submit a objTask at the given time point.
+ * @param tpWhen Time point at which the task is queued.
+ * @param objTask Task object.
+ * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+ */
+CYTimerId CYThreadPool::SubmitAt(std::chrono::steady_clock::time_point tpWhen, const CYThreadTask& objTask)
+{
+    return ScheduleTimer(tpWhen, std::chrono::milliseconds::zero(), objTask);
+}
+
+/**
+ * Submit a objTask every period until the timer is cancelled.
+ * @param nPeriod Period between two submissions, must be positive.
+ * @param objTask Task object.
+ * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+ */
+CYTimerId CYThreadPool::SubmitEvery(std::chrono::milliseconds nPeriod, const CYThreadTask& objTask)
+{
+    if (nPeriod.count() <= 0) return CYTHREAD_INVALID_TIMER_ID;
+    return ScheduleTimer(std::chrono::steady_clock::now() + nPeriod, nPeriod, objTask);
+}
+
+/**
+ * Cancel a delayed or periodic objTask that has not fired yet.
+ * @param nTimerId Timer id.
+ * @return True if the timer was pending, false if it already fired or is unknown.
+ */
+bool CYThreadPool::CancelTimer(CYTimerId nTimerId) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objTimerMutex);
+    return m_objTimerWheel.Cancel(nTimerId);
+}
+
+/**
+ * Schedule a objTask on the timer wheel.
+ * @param tpExpire When the task is due.
+ * @param nPeriod Repeat period, zero for a one-shot timer.
+ * @param objTask Task object.
+ * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+ */
+CYTimerId CYThreadPool::ScheduleTimer(std::chrono::steady_clock::time_point tpExpire, std::chrono::milliseconds nPeriod, const CYThreadTask& objTask)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        if (m_objTPProps.GetTaskPoolLock())
+        {
+            return CYTHREAD_INVALID_TIMER_ID;
+        }
+    }
+
+    CYTimerId nTimerId = CYTHREAD_INVALID_TIMER_ID;
+    {
+        std::lock_guard<std::mutex> lock(m_objTimerMutex);
+        // Shutdown has already harvested the wheel.
+        if (m_bTimersClosed)
+        {
+            return CYTHREAD_INVALID_TIMER_ID;
+        }
+        nTimerId = m_objTimerWheel.Schedule(tpExpire, nPeriod, objTask);
+        m_bTimerScheduled = true;
+    }
+
+    // The distribution thread sleeps until the previous next expiry, which may be later.
+    m_objTimerCondVar.notify_one();
+    return nTimerId;
+}
+
+/**
+ * Queue the timer tasks that became due.
+ * @return Time of the next timer wheel expiry, time_point::max() if no timer is pending.
+ */
+std::chrono::steady_clock::time_point CYThreadPool::ProcessTimers() noexcept
+{
+    std::pmr::vector<CYThreadTask> lstExpired(m_objTaskNodePool.GetMemoryResource());
+    const auto tpNow = std::chrono::steady_clock::now();
+
+    // Both locks are held, so Shutdown finds every fired timer either in the wheel or in the queue.
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    std::lock_guard<std::mutex> objTimerLock(m_objTimerMutex);
+    bool bRetry = false;
+    try
+    {
+        m_objTimerWheel.Advance(tpNow, lstExpired);
+    }
+    catch (const std::exception&)
+    {
+        // The tasks collected so far are still queued below, the rest fire on the retry.
+        bRetry = true;
+    }
+
+    // A fired timer was accepted when it was scheduled, so neither MaxTasks nor the pool lock
+    // applies here. A task that finds no node goes back on the wheel for the next round.
+    const size_t nWorker = GetCurrentWorker();
+    for (auto& objTask : lstExpired)
+    {
+        const CYTaskTag nTag = objTask.nTag;
+        CYQueuedTask objEntry{ std::move(objTask) };
+        if (m_lstTask.PushFront(std::move(objEntry), nWorker))
+        {
+            RecordSubmit(nWorker, 1, nTag);
+            continue;
+        }
+        try { (void)m_objTimerWheel.Schedule(tpNow, std::chrono::milliseconds(0), objEntry.objTask); }
+        catch (...) {}
+        bRetry = true;
+    }
+
+    if (!lstExpired.empty())
+    {
+        m_objCondVar.notify_one();
+    }
+    return bRetry ? tpNow + std::chrono::milliseconds(1) : m_objTimerWheel.GetNextExpiry();
+}
+
+/**
+ * Submit a objTask that only the given worker may run.
+ * @param nWorkerIndex Index of the worker, see GetCurrentWorkerIndex().
+ * @param objTask Task object.
+ * @return True if success, false if the index is invalid or the pool rejected the task.
+ */
+bool CYThreadPool::SubmitToWorker(int nWorkerIndex, const CYThreadTask& objTask) noexcept
+{
+    // A lazy pool spawns the addressed worker and the ones before it.
+    if (nWorkerIndex < 0 || SpawnWorkers(static_cast<size_t>(nWorkerIndex) + 1) <= static_cast<size_t>(nWorkerIndex))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_objMutex);
+
+    const size_t nWorker = GetCurrentWorker();
+    if (!m_objTPProps.GetTaskPoolLock() && m_lstTask.GetFreshCount(CYTaskKind::TASK_KIND_FUNCTION) <= static_cast<size_t>(m_objTPProps.GetMaxTasks()))
+    {
+        CYQueuedTask objEntry{ objTask };
+        objEntry.nPinnedWorker = static_cast<size_t>(nWorkerIndex);
+        if (m_lstTask.PushFront(std::move(objEntry), nWorker))
+        {
+            RecordSubmit(nWorker, 1, objTask.nTag);
+            m_objCondVar.notify_one();
+            return true;
+        }
+    }
+    RecordReject(nWorker, objTask.nTag);
+    return false;
+}
+
+/**
+ * Run a kernel on every worker at once and wait until all of them returned.
+ * @param funKernel Kernel, receives the worker index, the worker count and a barrier shared by the region.
+ * @return True if the region ran, false if called from a worker of this pool or the pool rejected it.
+ * @note The region starts once every worker finished its current task. An exception thrown by
+ *       the kernel is rethrown here once every worker returned.
+ */
+bool CYThreadPool::RunOnAllWorkers(const CYParallelKernel& funKernel)
+{
+    // The calling worker could never join its own region.
+    if (!funKernel || GetCurrentWorker() != SIZE_MAX)
+    {
+        return false;
+    }
+
+    std::atomic<int> nRemaining{ 0 };
+    std::mutex objDoneMutex;
+    std::condition_variable objDoneCondVar;
+    std::optional<CYBarrier> objBarrier;
+    std::exception_ptr ptrException;
+
+    // The region runs on every worker, a lazy pool spawns the missing ones first.
+    if (SpawnWorkers(SIZE_MAX) == 0)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        if (m_objTPProps.GetTaskPoolLock() || m_lstThread.empty())
+        {
+            return false;
+        }
+
+        const int nWorkerCount = static_cast<int>(m_lstThread.size());
+        objBarrier.emplace(nWorkerCount);
+        nRemaining.store(nWorkerCount, std::memory_order_relaxed);
+
+        // One pinned task per worker, the region counts as a single submission so MaxTasks does not apply.
+        TaskList lstRegion(m_objTaskNodePool);
+        for (int nWorker = 0; nWorker < nWorkerCount; ++nWorker)
+        {
+            CYQueuedTask objEntry;
+            objEntry.nPinnedWorker = static_cast<size_t>(nWorker);
+            objEntry.bRegion = true;
+            objEntry.objTask.funTaskToExecute = [&, nWorker, nWorkerCount](void*, bool) {
+                std::exception_ptr ptrKernelException;
+                try
+                {
+                    funKernel(nWorker, nWorkerCount, *objBarrier);
+                }
+                catch (...)
+                {
+                    ptrKernelException = std::current_exception();
+                }
+
+                // Last touch of the caller's frame happens under its lock.
+                std::lock_guard<std::mutex> objDoneLock(objDoneMutex);
+                if (ptrKernelException && !ptrException)
+                {
+                    ptrException = std::move(ptrKernelException);
+                }
+                if (nRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    objDoneCondVar.notify_all();
+                }
+            };
+            if (!lstRegion.PushFront(std::move(objEntry), SIZE_MAX))
+            {
+                // A partial region would never pass its barrier.
+                return false;
+            }
+        }
+        m_lstTask.SpliceBack(lstRegion);
+        RecordSubmit(SIZE_MAX, static_cast<uint64_t>(nWorkerCount));
+        ++m_nActiveRegions;
+    }
+
+    // Dispatch right away instead of waiting for the next distribution pass.
+    processObjectTaskList();
+
+    {
+        std::unique_lock<std::mutex> lock(objDoneMutex);
+        objDoneCondVar.wait(lock, [&] { return nRemaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        --m_nActiveRegions;
+        m_objCondVar.notify_all();
+    }
+
+    if (ptrException)
+    {
+        std::rethrow_exception(ptrException);
+    }
+    return true;
+}
+
+/**
+ * Start a new scratch frame, every worker resets its arena before its next task.
+ * @note Only meaningful with CYArenaResetMode::RESET_PER_FRAME.
+ */
+void CYThreadPool::AdvanceScratchFrame() noexcept
+{
+    m_nScratchFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Create missing workers, touch their stacks and fill their caches ahead of the first tasks.
+ * @param nStackBytes Stack bytes every worker writes to.
+ * @return True if every worker was warmed, false if called from a worker of this pool or the pool is not running.
+ * @note Runs as a region on all workers, so it waits for running tasks like RunOnAllWorkers.
+ */
+bool CYThreadPool::Prewarm(size_t nStackBytes) noexcept
+{
+    {
+        std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+        m_objCompactQueue.Reserve();
+    }
+
+    try
+    {
+        return RunOnAllWorkers([this, nStackBytes](int nWorkerIndex, int, CYBarrier&) {
+            TouchStack(nStackBytes);
+
+            // The first block of an unused arena is kept by the reset that follows.
+            if (auto pArena = CYScratchArena::GetCurrent(); pArena && pArena->GetCapacity() == 0)
+            {
+                (void)pArena->Allocate(1);
+                pArena->Reset();
+            }
+
+            // Taking one node refills the private free list in bulk, giving it back keeps them all.
+            const size_t nWorker = static_cast<size_t>(nWorkerIndex);
+            if (auto pNode = m_objTaskNodePool.Acquire(nWorker))
+            {
+                m_objTaskNodePool.Release(pNode, nWorker);
+            }
+        });
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+/**
+ * Get the index of the worker running the calling thread.
+ * @return Worker index, -1 if the caller is not a worker of this pool.
+ */
+int CYThreadPool::GetCurrentWorkerIndex() const noexcept
+{
+    const size_t nCurrentWorker = GetCurrentWorker();
+    return nCurrentWorker == SIZE_MAX ? -1 : static_cast<int>(nCurrentWorker);
+}
+
+/**
+ * Get the index of the worker running the calling thread.
+ * @return Worker index, SIZE_MAX if the caller is not a worker of this pool.
+ * @note Spawned workers are appended within the reserved capacity, so no lock is needed.
+ */
+size_t CYThreadPool::GetCurrentWorker() const noexcept
+{
+    auto pCurrent = CYThread::GetCurrentThread();
+    if (!pCurrent)
+    {
+        return SIZE_MAX;
+    }
+
+    const size_t nIndex = pCurrent->GetWorkerIndex();
+    return nIndex < m_nThreadCount.load(std::memory_order_acquire) && m_lstThread[nIndex].get() == pCurrent ? nIndex : SIZE_MAX;
+}
+
+/**
+ * Check if a queued entry is pinned to another worker.
+ * @param objEntry Queued entry.
+ * @param nWorker Worker index asking, SIZE_MAX for a non-worker thread.
+ * @return True if only another worker may run the entry.
+ */
+bool CYThreadPool::IsPinnedElsewhere(const CYQueuedTask& objEntry, size_t nWorker) noexcept
+{
+    return objEntry.nPinnedWorker != SIZE_MAX && objEntry.nPinnedWorker != nWorker;
+}
+
+/**
+ * Get a worker for a queued function task, the caller must hold m_objMutex.
+ * @param pRecord Record of the task.
+ * @return Worker or nullptr if the task stays queued.
+ * @note A pinned task only ever goes to its own worker.
+ */
+CYThread* CYThreadPool::FindTaskThread(CYTaskRecord* pRecord) noexcept
+{
+    const auto& objEntry = TaskList::GetNode(pRecord)->objValue;
+    if (objEntry.nPinnedWorker != SIZE_MAX)
+    {
+        auto pPinned = m_lstThread[objEntry.nPinnedWorker].get();
+        return pPinned->GetThreadAvail() == CYThreadStatus::STATUS_THREAD_NOT_EXECUTING ? pPinned : nullptr;
+    }
+    return FindAffinityThread(GetPreferredThread(objEntry.objTask.nAffinityKey), pRecord->nAffinitySkips);
+}
+
+/**
+ * Hand one queued record to a worker, the caller must hold m_objMutex.
+ * @param pRecord Record to dispatch, advanced to the next newer record still queued.
+ * @param nBatchSize Tasks per batch for this pass.
+ * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+ */
+void CYThreadPool::DispatchRecord(CYTaskRecord*& pRecord, size_t nBatchSize, size_t nWorker) noexcept
+{
+    auto pNewer = pRecord->pPrev;
+    if (DiscardIfCancelled(*pRecord))
+    {
+        m_lstTask.Erase(pRecord, nWorker);
+    }
+    else if (m_objTagTable.IsThrottled(pRecord->nTag))
+    {
+        // The tag runs as many tasks as it may, the record waits for one of them to finish.
+        m_lstTask.MarkMissed(pRecord);
+    }
+    else if (pRecord->eKind == CYTaskKind::TASK_KIND_OBJECT)
+    {
+        auto pObject = TaskList::GetHook(pRecord)->pObject;
+        if (auto pWorker = FindAffinityThread(GetPreferredThread(pObject), pRecord->nAffinitySkips))
+        {
+            pObject->m_nLastWorker = static_cast<int>(pWorker->GetWorkerIndex());
+            pWorker->ChangeThreadPropertiesandResume(pObject, pRecord->pTaskGroup, pRecord->nTag);
+            RecordStart(nWorker, *pRecord);
+            m_objTrace.Record(nWorker, CYTraceEventType::TRACE_EVENT_DISPATCH, pWorker->GetWorkerIndex());
+            m_lstTask.Erase(pRecord, nWorker);
+        }
+        else
+        {
+            m_lstTask.MarkMissed(pRecord);
+        }
+    }
+    else if (auto pWorker = FindTaskThread(pRecord))
+    {
+        m_objTrace.Record(nWorker, CYTraceEventType::TRACE_EVENT_DISPATCH, pWorker->GetWorkerIndex());
+        if (nBatchSize > 1 && IsBatchable(pRecord))
+        {
+            pWorker->ChangeThreadPropertiesandResume(BuildTaskBatch(pRecord, nBatchSize, nWorker), nullptr);
+            return;
+        }
+        pWorker->ChangeThreadPropertiesandResume(std::move(TaskList::GetNode(pRecord)->objValue.objTask), pRecord->pTaskGroup);
+        RecordStart(nWorker, *pRecord);
+        m_lstTask.Erase(pRecord, nWorker);
+    }
+    else
+    {
+        m_lstTask.MarkMissed(pRecord);
+    }
+    pRecord = pNewer;
+}
+
+/**
+ * Coalesce consecutive tiny tasks into batches that a worker runs back-to-back.
+ * @param bEnable True to enable batching.
+ * @param nMaxLatencyUs Longest time a task may wait behind earlier tasks of its batch.
+ */
+void CYThreadPool::SetTaskBatching(bool bEnable, uint32_t nMaxLatencyUs) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
+    m_objTPProps.SetTaskBatching(bEnable, nMaxLatencyUs);
+}
+
+/**
+ * Pick the batch size for this dispatch pass, the caller must hold m_objMutex.
+ * @return Tasks per batch, 1 disables batching for the pass.
+ */
+size_t CYThreadPool::GetBatchSize() noexcept
+{
+    if (!m_objTPProps.GetTaskBatching())
+    {
+        return 1;
+    }
+
+    const auto nIdle = static_cast<size_t>(std::count_if(m_lstThread.begin(), m_lstThread.end(), [](const auto& thread) {
+        return thread->GetThreadAvail() == CYThreadStatus::STATUS_THREAD_NOT_EXECUTING;
+    }));
+    if (nIdle == 0)
+    {
+        return 1;
+    }
+
+    // Spread the queued tasks over the idle workers...
+    const size_t nQueued = m_lstTask.GetCount(CYTaskKind::TASK_KIND_FUNCTION);
+    const size_t nByDepth = (nQueued + nIdle - 1) / nIdle;
+
+    // ...without letting the last task of a batch wait longer than the latency cap.
+    const uint64_t nAvgTaskNs = m_nAvgTaskNs.load(std::memory_order_relaxed);
+    const uint64_t nLatencyNs = static_cast<uint64_t>(m_objTPProps.GetBatchLatencyUs()) * 1000;
+    const size_t nByLatency = nAvgTaskNs ? static_cast<size_t>(nLatencyNs / nAvgTaskNs) : MAX_BATCH_SIZE;
+
+    if (nByLatency < 2 && nByDepth > 1)
+    {
+        // Let the estimate decay so that tasks getting cheaper are noticed again.
+        m_nAvgTaskNs.store(nAvgTaskNs - nAvgTaskNs / 16, std::memory_order_relaxed);
+    }
+
+    return std::clamp<size_t>(std::min(nByDepth, nByLatency), 1, MAX_BATCH_SIZE);
+}
+
 /**
- * Constructor.
+ * Check if a queued record may share a batch.
+ * @param pRecord Queued record.
+ * @return True for plain function tasks without group, tag, pin or affinity.
  */
-CYThreadPool::CYThreadPool()
+bool CYThreadPool::IsBatchable(CYTaskRecord* pRecord) noexcept
 {
+    if (pRecord->eKind != CYTaskKind::TASK_KIND_FUNCTION || pRecord->pTaskGroup || pRecord->nTag != CYTHREAD_NO_TAG)
+    {
+        return false;
+    }
+    const auto& objEntry = TaskList::GetNode(pRecord)->objValue;
+    return objEntry.nPinnedWorker == SIZE_MAX && objEntry.objTask.nAffinityKey == CYTHREAD_NO_AFFINITY_KEY &&
+        (objEntry.objTask.funTaskToExecute || objEntry.objTask.funCancellableTaskToExecute);
 }
 
-CYThreadPool::~CYThreadPool()
+/**
+ * Take consecutive batchable records out of the queue, the caller must hold m_objMutex.
+ * @param pRecord Oldest record of the batch, advanced to the next newer record still queued.
+ * @param nBatchSize Maximum records to take.
+ * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+ * @return Task running the batch.
+ */
+CYThreadTask CYThreadPool::BuildTaskBatch(CYTaskRecord*& pRecord, size_t nBatchSize, size_t nWorker)
 {
-    (void)Shutdown();
+    // The allocator is handed on to the vector, so the control block and the tasks share the resource.
+    auto ptrBatch = std::allocate_shared<TaskBatch>(std::pmr::polymorphic_allocator<TaskBatch>(m_objTaskNodePool.GetMemoryResource()));
+    ptrBatch->reserve(nBatchSize);
+    while (pRecord && ptrBatch->size() < nBatchSize && IsBatchable(pRecord))
+    {
+        auto pNewer = pRecord->pPrev;
+        ptrBatch->push_back(std::move(TaskList::GetNode(pRecord)->objValue.objTask));
+        RecordStart(nWorker, *pRecord);
+        m_lstTask.Erase(pRecord, nWorker);
+        pRecord = pNewer;
+    }
+
+    if (ptrBatch->size() == 1)
+    {
+        return std::move(ptrBatch->front());
+    }
+
+    // The batch is shared, CYThreadTask copies on its way to the worker must not copy the tasks.
+    CYThreadTask objBatchTask;
+    objBatchTask.funCancellableTaskToExecute = [this, ptrBatch, nLatencyUs = m_objTPProps.GetBatchLatencyUs()](void*, const CYStopToken& objStopToken) {
+        RunTaskBatch(*ptrBatch, nLatencyUs, objStopToken);
+    };
+    return objBatchTask;
 }
 
 /**
- * Shutdown thread pool.
- * @return True if success, false otherwise.
- * @note This function will terminate all working threads and release resources.
+ * Run a batch back-to-back on the calling worker.
+ * @param lstBatch Tasks of the batch.
+ * @param nLatencyUs Latency cap of the batch.
+ * @param objStopToken Token of the batch task.
+ * @note Tasks that would start after the latency cap are queued again.
  */
-bool CYThreadPool::Shutdown() noexcept
+void CYThreadPool::RunTaskBatch(TaskBatch& lstBatch, uint32_t nLatencyUs, const CYStopToken& objStopToken) noexcept
 {
-    // Stop the distribution thread first (before acquiring the main mutex)
-    StopDistributionThread();
+    const auto tpStart = std::chrono::steady_clock::now();
+    const auto nLatencyCap = std::chrono::microseconds(nLatencyUs);
+    auto tpNow = tpStart;
 
-    std::lock_guard<std::mutex> lock(m_objMutex);
-    m_bShutdown.store(true, std::memory_order_release);
-    m_objCondVar.notify_all();
+    // Every task of the batch gets the arena back empty, like a task of its own would.
+    auto pCurrent = CYThread::GetCurrentThread();
+    const CYScratchMark objScratchMark = pCurrent ? pCurrent->GetScratchArena().GetMark() : CYScratchMark{};
 
-    for (auto& objThread : m_lstThread)
+    // Each task of the batch is recorded on its own instead of the batch as one task.
+    auto pMetrics = pCurrent ? pCurrent->GetMetrics() : nullptr;
+    if (pCurrent)
     {
-        if (objThread)
+        pCurrent->ExcludeTaskFromMetrics();
+    }
+
+    size_t nRun = 0;
+    for (; nRun < lstBatch.size(); ++nRun)
+    {
+        if (nRun > 0 && tpNow - tpStart > nLatencyCap)
         {
-            objThread->TerminateThread();
+            break;
+        }
+
+        const auto tpTask = tpNow;
+        auto& objTask = lstBatch[nRun];
+        if (objTask.funCancellableTaskToExecute)
+        {
+            objTask.funCancellableTaskToExecute(objTask.pArgList, objStopToken);
+        }
+        else
+        {
+            objTask.funTaskToExecute(objTask.pArgList, objTask.bDelete);
+        }
+        if (pCurrent)
+        {
+            pCurrent->RewindScratchArena(objScratchMark);
+        }
+        tpNow = std::chrono::steady_clock::now();
+        if (pMetrics)
+        {
+            pMetrics->OnComplete(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(tpNow - tpTask).count()));
         }
     }
 
-    m_lstThread.clear();
-    m_lstTask.clear();
-    m_lstTaskMiss.clear();
-    m_lstTTask.clear();
-    m_lstTTaskMiss.clear();
+    // Feed the measured duration back into the batch size.
+    const auto nTaskNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(tpNow - tpStart).count()) / nRun;
+    const uint64_t nAvgTaskNs = m_nAvgTaskNs.load(std::memory_order_relaxed);
+    m_nAvgTaskNs.store(nAvgTaskNs ? (nAvgTaskNs * 7 + nTaskNs) / 8 : nTaskNs, std::memory_order_relaxed);
 
-    return true;
+    if (nRun == lstBatch.size())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_objMutex);
+        if (!m_objTPProps.GetTaskPoolLock())
+        {
+            // Queued ahead of everything else, in their original order, they already waited once.
+            const size_t nWorker = GetCurrentWorker();
+            size_t nIndex = lstBatch.size();
+            for (; nIndex > nRun; --nIndex)
+            {
+                auto pNode = m_objTaskNodePool.Acquire(nWorker);
+                if (!pNode)
+                {
+                    break;
+                }
+                pNode->objValue.objTask = std::move(lstBatch[nIndex - 1]);
+                pNode->bMissed = true;
+                m_lstTask.LinkBack(pNode);
+            }
+            if (nIndex == nRun)
+            {
+                return;
+            }
+
+            // Out of memory, the tasks that could not be queued again are finished here.
+            lstBatch.resize(nIndex);
+        }
+    }
+
+    // A shutting down pool no longer dispatches, the batch was accepted so it is finished here.
+    for (; nRun < lstBatch.size(); ++nRun)
+    {
+        const uint64_t nStartNs = CYPoolMetrics::GetTimeNs();
+        auto& objTask = lstBatch[nRun];
+        if (objTask.funCancellableTaskToExecute)
+        {
+            objTask.funCancellableTaskToExecute(objTask.pArgList, objStopToken);
+        }
+        else
+        {
+            objTask.funTaskToExecute(objTask.pArgList, objTask.bDelete);
+        }
+        if (pMetrics)
+        {
+            pMetrics->OnComplete(CYPoolMetrics::GetTimeNs() - nStartNs);
+        }
+    }
 }
 
 /**
- * Create thread pool with specified platform and max threads.
- * @param eThreadType Platform type.
- * @param iMaxThread Max thread count.
- * @return True if success, false otherwise.
+ * Hand compact tasks to idle workers, the caller must hold m_objMutex.
+ * @note Every runner drains many chunks, one is started per chunk still without a runner.
  */
-bool CYThreadPool::CreateThreadPool(const CYPlatformId& eThreadType, int iMaxThread) noexcept
+void CYThreadPool::DispatchCompactTasks() noexcept
 {
-    try
+    // Runners give their worker back while other tasks wait for one.
+    m_bCompactYield.store(m_nWorkerShortage != 0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> objCompactLock(m_objCompactMutex);
+    while (m_nCompactRunners * COMPACT_CHUNK_SIZE < m_objCompactQueue.Size())
     {
-        std::lock_guard<std::mutex> lock(m_objMutex);
+        auto pWorker = FindAvailThread();
+        if (!pWorker)
+        {
+            return;
+        }
 
-        // Set thread pool properties
-        m_objTPProps.SetMaxTasks(25);
-        m_objTPProps.SetMaxThreads(iMaxThread);
-        m_objTPProps.SetTaskPoolLock(false);
+        CYThreadTask objRunner;
+        objRunner.funCancellableTaskToExecute = [this](void*, const CYStopToken& objStopToken) {
+            RunCompactTasks(objStopToken);
+        };
+        ++m_nCompactRunners;
+        pWorker->ChangeThreadPropertiesandResume(std::move(objRunner), nullptr);
+        m_objTrace.Record(GetCurrentWorker(), CYTraceEventType::TRACE_EVENT_DISPATCH, pWorker->GetWorkerIndex());
+    }
+}
 
-        // Create threads
-        for (int i = 0; i < m_objTPProps.GetMaxThreadCount(); i++)
-        {
-            auto thread = std::make_unique<CYThread>();
-            CYThreadProperties objThreadProps;
-            objThreadProps.CreateProperties(eThreadType);
+/**
+ * Drain the compact queue chunk by chunk on the calling worker.
+ * @param objStopToken Token of the runner task.
+ * @note Returns once the queue is empty or other tasks are waiting.
+ */
+void CYThreadPool::RunCompactTasks(const CYStopToken& objStopToken) noexcept
+{
+    auto pCurrent = CYThread::GetCurrentThread();
+    const CYScratchMark objScratchMark = pCurrent ? pCurrent->GetScratchArena().GetMark() : CYScratchMark{};
 
-            if (thread->CreateThread(objThreadProps))
+    // The runner records the compact tasks per chunk, they carry no queue time.
+    auto pMetrics = pCurrent ? pCurrent->GetMetrics() : nullptr;
+    if (pCurrent)
+    {
+        pCurrent->ExcludeTaskFromMetrics();
+    }
+
+    CYCompactTask arrTask[COMPACT_CHUNK_SIZE];
+    for (;;)
+    {
+        size_t nCount = 0;
+        {
+            // Only the compact lock is taken, m_objMutex stays free for the dispatch passes.
+            std::lock_guard<std::mutex> lock(m_objCompactMutex);
+            if (!m_bCompactYield.load(std::memory_order_relaxed) && !objStopToken.stop_requested())
             {
-                m_lstThread.push_back(std::move(thread));
+                nCount = m_objCompactQueue.Pop(arrTask, COMPACT_CHUNK_SIZE);
+            }
+            if (nCount == 0)
+            {
+                --m_nCompactRunners;
+                return;
             }
         }
 
-        // Start the task distribution thread
-        StartDistributionThread();
-
-        return !m_lstThread.empty();
+        const uint64_t nStartNs = CYPoolMetrics::GetTimeNs();
+        if (pMetrics)
+        {
+            pMetrics->OnStart(0, nCount);
+        }
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex)
+        {
+            arrTask[nIndex].pfnTask(arrTask[nIndex].pContext);
+            if (pCurrent)
+            {
+                pCurrent->RewindScratchArena(objScratchMark);
+            }
+        }
+        if (pMetrics)
+        {
+            pMetrics->OnComplete((CYPoolMetrics::GetTimeNs() - nStartNs) / nCount, nCount);
+        }
     }
-    catch (const std::exception&)
+}
+
+/**
+ * Map an affinity key to a worker index, the caller must hold m_objMutex.
+ * @param nAffinityKey Affinity key.
+ * @return Worker index, SIZE_MAX for no preference.
+ */
+size_t CYThreadPool::GetPreferredThread(uint64_t nAffinityKey) const noexcept
+{
+    if (nAffinityKey == CYTHREAD_NO_AFFINITY_KEY || m_lstThread.empty())
     {
-        return false;
+        return SIZE_MAX;
     }
+
+    // Fibonacci hashing spreads sequential shard ids over the workers.
+    return static_cast<size_t>(((nAffinityKey * 0x9E3779B97F4A7C15ull) >> 32) % m_lstThread.size());
 }
 
 /**
- * Submit a objTask to the pool.
- * @param objTask Task object.
- * @return True if success, false otherwise.
+ * Get the preferred worker of an object, the caller must hold m_objMutex.
+ * @param pObject Object task.
+ * @return Worker index, SIZE_MAX for no preference.
  */
-bool CYThreadPool::SubmitTask(const CYThreadTask& objTask) noexcept
+size_t CYThreadPool::GetPreferredThread(const ICYIThreadableObject* pObject) const noexcept
 {
-    std::lock_guard<std::mutex> lock(m_objMutex);
-    if (!m_objTPProps.GetTaskPoolLock() && m_lstTask.size() <= m_objTPProps.GetMaxTasks())
+    const uint64_t nAffinityKey = pObject->GetAffinityKey();
+    if (nAffinityKey != CYTHREAD_NO_AFFINITY_KEY)
     {
-        m_lstTask.push_front(objTask);
-        m_objCondVar.notify_one();
-        return true;
+        return GetPreferredThread(nAffinityKey);
     }
-    return false;
+
+    // Without a key the object sticks to the worker that ran it last.
+    const int nLastWorker = pObject->GetLastWorker();
+    return nLastWorker >= 0 && static_cast<size_t>(nLastWorker) < m_lstThread.size() ? static_cast<size_t>(nLastWorker) : SIZE_MAX;
 }
 
 /**
- * Submit a objTask to the pool.
- * @param objTask Task object.
- * @return True if success, false otherwise.
+ * Get a worker for a task with a preferred worker, the caller must hold m_objMutex.
+ * @param nPreferred Preferred worker index, SIZE_MAX for none.
+ * @param nAffinitySkips Passes the task already waited, incremented when it has to wait again.
+ * @return Worker or nullptr if the task stays queued.
+ * @note Another worker is only used once the task waited AFFINITY_MAX_SKIPS passes.
  */
-bool CYThreadPool::SubmitTask(ICYIThreadableObject* pInvokingObject) noexcept
+CYThread* CYThreadPool::FindAffinityThread(size_t nPreferred, uint32_t& nAffinitySkips) noexcept
 {
-    if (!pInvokingObject) return false;
+    if (nPreferred == SIZE_MAX)
+    {
+        return FindAvailThread();
+    }
 
-    std::lock_guard<std::mutex> lock(m_objMutex);
-    if (!m_objTPProps.GetTaskPoolLock() && m_lstTTask.size() <= m_objTPProps.GetMaxTasks())
+    auto pPreferred = m_lstThread[nPreferred].get();
+    if (pPreferred->GetThreadAvail() == CYThreadStatus::STATUS_THREAD_NOT_EXECUTING)
     {
-        m_lstTTask.push_front(pInvokingObject);
-        m_objCondVar.notify_one();
-        return true;
+        return pPreferred;
     }
-    return false;
+
+    // The preferred worker stays busy, let another one steal the task once the wait shows imbalance.
+    if (nAffinitySkips >= AFFINITY_MAX_SKIPS)
+    {
+        return FindAvailThread();
+    }
+
+    ++nAffinitySkips;
+    return nullptr;
+}
+
+/**
+ * Check if a queued entry belongs to a cancelled group and release it if so.
+ * @param objRecord Record of the entry.
+ * @return True if the entry must be dropped.
+ */
+bool CYThreadPool::DiscardIfCancelled(const CYTaskRecord& objRecord) noexcept
+{
+    if (!objRecord.pTaskGroup || !objRecord.pTaskGroup->IsCancelled())
+    {
+        return false;
+    }
+
+    m_objTagTable.OnCancel(objRecord.nTag, 1, false);
+    objRecord.pTaskGroup->OnTaskFinished();
+    return true;
 }
 
 /**
@@ -135,93 +1684,242 @@ bool CYThreadPool::SubmitTask(ICYIThreadableObject* pInvokingObject) noexcept
  */
 void CYThreadPool::processObjectTaskList() noexcept
 {
-    // Process missed tasks
-    if (!m_lstTTaskMiss.empty())
+    for (;;)
     {
-        for (auto it = m_lstTTaskMiss.begin(); it != m_lstTTaskMiss.end(); )
+        size_t nThreadCount = 0;
+        size_t nSpawnDemand = 0;
         {
-            if (auto pWorker = GetAvailThread())
+            std::lock_guard<std::mutex> lock(m_objMutex);
+            const size_t nWorker = GetCurrentWorker();
+            const size_t nBatchSize = GetBatchSize();
+            m_nWorkerShortage = 0;
+
+            // Oldest first. A task without a worker is marked missed and keeps its place in the queue.
+            auto funDispatch = [&](bool bObjects, bool bFunctions) {
+                for (auto pRecord = m_lstTask.GetBack(); pRecord; )
+                {
+                    const bool bObject = pRecord->eKind == CYTaskKind::TASK_KIND_OBJECT;
+                    if (bObject ? bObjects : bFunctions)
+                    {
+                        DispatchRecord(pRecord, nBatchSize, nWorker);
+                    }
+                    else
+                    {
+                        pRecord = pRecord->pPrev;
+                    }
+                }
+            };
+
+            if (m_objOptions.eTaskOrder == CYTaskOrder::TASK_ORDER_OBJECTS_FIRST)
             {
-                pWorker->ChangeThreadPropertiesandResume(*it);
-                it = m_lstTTaskMiss.erase(it);
+                funDispatch(true, false);
+                funDispatch(false, true);
             }
             else
             {
-                ++it;
+                funDispatch(true, true);
+            }
+
+            DispatchCompactTasks();
+            PromoteCleanupToAvailability();
+
+            // The pass may have dropped the last queued records without running them.
+            if (m_nDrainWaiters.load(std::memory_order_relaxed) != 0 && GetPendingTaskCount() == 0)
+            {
+                m_objCondVar.notify_all();
             }
+
+            nThreadCount = m_lstThread.size();
+            nSpawnDemand = std::exchange(m_nSpawnDemand, 0);
+        }
+
+        // A lazy pool creates the workers the pass was missing without holding the lock, then
+        // dispatches again so the waiting tasks reach them.
+        if (nSpawnDemand <= nThreadCount || SpawnWorkers(nSpawnDemand) <= nThreadCount)
+        {
+            return;
         }
     }
+}
+
+/**
+ * Get nAvailable thread.
+ * @param bRemove Remove thread from list if true.
+ * @return nAvailable thread.
+ */
+CYThread* CYThreadPool::GetAvailThread(bool bRemove) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_objMutex);
 
-    // Process new tasks
-    for (auto it = m_lstTTask.begin(); it != m_lstTTask.end(); )
+    for (auto it = m_lstThread.begin(); it != m_lstThread.end(); ++it)
     {
-        if (auto pWorker = GetAvailThread())
+        if ((*it)->GetThreadAvail() == CYThreadStatus::STATUS_THREAD_NOT_EXECUTING)
         {
-            pWorker->ChangeThreadPropertiesandResume(*it);
-            it = m_lstTTask.erase(it);
+            auto pThread = it->get();
+            if (bRemove)
+            {
+                m_lstThread.erase(it);
+                m_nThreadCount.store(m_lstThread.size(), std::memory_order_release);
+            }
+
+            return pThread;
         }
-        else
+    }
+    return nullptr;
+}
+
+/**
+ * Get available thread, the caller must hold m_objMutex.
+ * @return Available thread or nullptr.
+ */
+CYThread* CYThreadPool::FindAvailThread() noexcept
+{
+    for (const auto& thread : m_lstThread)
+    {
+        if (thread->GetThreadAvail() == CYThreadStatus::STATUS_THREAD_NOT_EXECUTING)
         {
-            m_lstTTaskMiss.push_front(*it);
-            it = m_lstTTask.erase(it);
+            return thread.get();
         }
     }
 
-    // Process function tasks (missed first)
-    if (!m_lstTaskMiss.empty())
+    // Every worker is busy, a lazy pool grows by one once the dispatch pass released the lock.
+    ++m_nWorkerShortage;
+    if (m_objOptions.eSpawnMode == CYWorkerSpawnMode::SPAWN_MODE_LAZY)
     {
-        for (auto it = m_lstTaskMiss.begin(); it != m_lstTaskMiss.end(); )
+        const size_t nDemand = std::max(m_nSpawnDemand, m_lstThread.size());
+        if (nDemand < static_cast<size_t>(m_objTPProps.GetMaxThreadCount()))
         {
-            if (auto pWorker = GetAvailThread())
-            {
-                pWorker->ChangeThreadPropertiesandResume(*it);
-                it = m_lstTaskMiss.erase(it);
-            }
-            else
+            m_nSpawnDemand = nDemand + 1;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Create workers without adding them to the pool.
+ * @param nFirstIndex Index of the first worker.
+ * @param nCount Workers to create.
+ * @param bParallel Spread the thread creation over several spawning threads.
+ * @return Created workers, indexed from nFirstIndex without gaps.
+ * @note A worker that fails to start ends the list, the ones after it are dropped again.
+ */
+CYThreadPool::ThreadList CYThreadPool::CreateWorkers(size_t nFirstIndex, size_t nCount, bool bParallel) const noexcept
+{
+    ThreadList lstWorker;
+    try
+    {
+        lstWorker.reserve(nCount);
+        for (size_t i = 0; i < nCount; ++i)
+        {
+            auto thread = std::make_unique<CYThread>();
+            thread->SetWorkerIndex(nFirstIndex + i);
+            thread->SetWorkerHooks(m_objOptions.funOnWorkerStart, m_objOptions.funOnWorkerStop);
+            thread->SetTaskFinishedHook([this] { NotifyDrainWaiters(); });
+            thread->SetScratchArena(m_objOptions.eScratchResetMode, m_objOptions.nScratchBlockSize, &m_nScratchFrame);
+            thread->SetMetrics(m_objMetrics.GetSlot(nFirstIndex + i));
+            thread->SetTrace(m_objTrace.GetRing(nFirstIndex + i));
+            thread->SetTagTable(&m_objTagTable, m_objOptions.bCpuTime);
+            if (m_objOptions.bPerfCounters || m_objOptions.bCpuTime)
             {
-                ++it;
+                thread->SetPerfCounters(m_objOptions.bPerfCounters, m_objOptions.bCpuTime, m_objTaskNodePool.GetMemoryResource());
             }
+            lstWorker.push_back(std::move(thread));
+        }
+    }
+    catch (const std::exception&)
+    {
+        return {};
+    }
+
+    std::unique_ptr<std::atomic<bool>[]> arrCreated(new (std::nothrow) std::atomic<bool>[nCount]);
+    if (!arrCreated)
+    {
+        return {};
+    }
+
+    auto funCreate = [&](size_t nBegin, size_t nEnd) {
+        for (size_t i = nBegin; i < nEnd; ++i)
+        {
+            CYThreadProperties objThreadProps;
+            objThreadProps.CreateProperties(m_eThreadType);
+            arrCreated[i].store(lstWorker[i]->CreateThread(objThreadProps), std::memory_order_relaxed);
+        }
+    };
+
+    // Slices of about sqrt(nCount) workers keep both the spawning threads and their slices short.
+    size_t nSlice = nCount;
+    if (bParallel)
+    {
+        nSlice = SPAWN_SLICE_MIN;
+        while (nSlice * nSlice < nCount)
+        {
+            ++nSlice;
         }
     }
 
-    for (auto it = m_lstTask.begin(); it != m_lstTask.end(); )
+    std::vector<std::thread> lstSpawner;
+    for (size_t nBegin = nSlice; nBegin < nCount; nBegin += nSlice)
     {
-        if (auto pWorker = GetAvailThread())
+        const size_t nEnd = std::min(nBegin + nSlice, nCount);
+        try
         {
-            pWorker->ChangeThreadPropertiesandResume(*it);
-            it = m_lstTask.erase(it);
+            lstSpawner.emplace_back(funCreate, nBegin, nEnd);
         }
-        else
+        catch (const std::exception&)
         {
-            m_lstTaskMiss.push_front(*it);
-            it = m_lstTask.erase(it);
+            funCreate(nBegin, nEnd);
         }
     }
+    funCreate(0, std::min(nSlice, nCount));
+    for (auto& objSpawner : lstSpawner)
+    {
+        objSpawner.join();
+    }
 
-    PromoteCleanupToAvailability();
+    // Worker indices are positions in the pool's list, so nothing after a gap can be kept.
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        if (!arrCreated[i].load(std::memory_order_relaxed))
+        {
+            lstWorker.erase(lstWorker.begin() + static_cast<std::ptrdiff_t>(i), lstWorker.end());
+            break;
+        }
+    }
+    return lstWorker;
 }
 
 /**
- * Get nAvailable thread.
- * @param bRemove Remove thread from list if true.
- * @return nAvailable thread.
+ * Add workers until the pool has nCount of them, the caller must not hold m_objMutex.
+ * @param nCount Wanted worker count, capped at the maximum.
+ * @return Worker count afterwards.
+ * @note A pool that is shut down spawns nothing. One thread creates workers at a time, the others
+ *       wait for it and then only create what is still missing.
  */
-CYThread* CYThreadPool::GetAvailThread(bool bRemove) noexcept
+size_t CYThreadPool::SpawnWorkers(size_t nCount) noexcept
 {
-    std::lock_guard<std::mutex> lock(m_objMutex);
+    std::unique_lock<std::mutex> lock(m_objMutex);
+    m_objSpawnCondVar.wait(lock, [this] { return !m_bSpawning; });
 
-    for (auto it = m_lstThread.begin(); it != m_lstThread.end(); ++it)
+    nCount = std::min(nCount, static_cast<size_t>(m_objTPProps.GetMaxThreadCount()));
+    if (nCount > m_lstThread.size() && !m_bShutdown.load(std::memory_order_acquire))
     {
-        if ((*it)->GetThreadAvail() == CYThreadStatus::STATUS_THREAD_NOT_EXECUTING)
-        {
-            auto pThread = it->get();
-            if (bRemove)
-                m_lstThread.erase(it);
+        const size_t nFirstIndex = m_lstThread.size();
+        m_bSpawning = true;
 
-            return pThread;
+        // Thread creation is the slow part, tasks submitted meanwhile only queue up.
+        lock.unlock();
+        ThreadList lstWorker = CreateWorkers(nFirstIndex, nCount - nFirstIndex, false);
+        lock.lock();
+
+        for (auto& thread : lstWorker)
+        {
+            m_lstThread.push_back(std::move(thread));
         }
+        m_nThreadCount.store(m_lstThread.size(), std::memory_order_release);
+        m_bSpawning = false;
+        m_objSpawnCondVar.notify_all();
     }
-    return nullptr;
+    return m_lstThread.size();
 }
 
 /**
@@ -335,7 +2033,7 @@ int CYThreadPool::GetSpecificThreadStatusCount(CYThreadStatus eThreadType) const
 bool CYThreadPool::IsPoolEmpty() const noexcept
 {
     std::lock_guard<std::mutex> lock(m_objMutex);
-    return m_lstTask.empty() && m_lstTTask.empty() && m_lstTTaskMiss.empty();
+    return GetPendingTaskCount() == 0;
 }
 
 /**
@@ -435,18 +2133,31 @@ CYThreadStatus CYThreadPool::GetWorkingThreadStatus(ICYIThreadableObject* pInvok
 /**
  * Terminate specific working thread.
  * @param pInvokingObject Object invoking the task.
- * @note This function will terminate only the specified thread, not all working threads.
+ * @note The object is dropped if it is still queued, otherwise the stop token of the running
+ *       task is signalled. The worker itself keeps serving the pool.
  */
 void CYThreadPool::TerminateWorkingThread(ICYIThreadableObject* pInvokingObject) noexcept
 {
     if (!pInvokingObject) return;
 
     std::lock_guard<std::mutex> lock(m_objMutex);
+    m_lstTask.EraseIf([this, pInvokingObject](CYTaskRecord& objRecord) {
+        if (objRecord.eKind != CYTaskKind::TASK_KIND_OBJECT || TaskList::GetHook(&objRecord)->pObject != pInvokingObject)
+        {
+            return false;
+        }
+        m_objTagTable.OnCancel(objRecord.nTag, 1, false);
+        if (objRecord.pTaskGroup)
+        {
+            objRecord.pTaskGroup->OnTaskFinished();
+        }
+        return true;
+    }, GetCurrentWorker());
+
     for (auto& thread : m_lstThread)
     {
-        if (thread->GetThreadObject() == pInvokingObject)
+        if (thread->RequestTaskStop(pInvokingObject))
         {
-            thread->TerminateThread();
             break;
         }
     }
@@ -520,7 +2231,11 @@ void CYThreadPool::StopDistributionThread() noexcept
 {
     if (m_bDistributionRunning.load())
     {
-        m_bDistributionRunning.store(false);
+        {
+            std::lock_guard<std::mutex> lock(m_objTimerMutex);
+            m_bDistributionRunning.store(false);
+        }
+        m_objTimerCondVar.notify_all();
         if (m_ptrDistributionThread && m_ptrDistributionThread->joinable())
         {
             m_ptrDistributionThread->join();
@@ -537,11 +2252,18 @@ void CYThreadPool::DistributionThreadFunction() noexcept
 {
     while (m_bDistributionRunning.load() && !m_bShutdown.load())
     {
+        // Queue due timers first so they are dispatched in the same pass
+        const auto tpNextExpiry = ProcessTimers();
+
         // Process pending tasks
         processObjectTaskList();
         
-        // Sleep for a short time to avoid busy waiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Sleep until the next timer is due, but at most 10 ms so object tasks keep being distributed.
+        // A newly scheduled timer may be due earlier, so scheduling wakes the thread up.
+        const auto tpWake = std::min(tpNextExpiry, std::chrono::steady_clock::now() + std::chrono::milliseconds(10));
+        std::unique_lock<std::mutex> lock(m_objTimerMutex);
+        (void)m_objTimerCondVar.wait_until(lock, tpWake, [this] { return m_bTimerScheduled || !m_bDistributionRunning.load(); });
+        m_bTimerScheduled = false;
     }
 }
 
@@ -47,6 +47,7 @@
 #include <map>
 #include <deque>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
@@ -54,7 +55,14 @@
 #include <thread>
 #include "CYThread.hpp"
 #include "CYThreadPoolProperties.hpp"
+#include "CYTimerWheel.hpp"
+#include "CYTaskQueue.hpp"
+#include "CYPoolMetrics.hpp"
+#include "CYPoolTrace.hpp"
+#include "CYTagTable.hpp"
+#include "CYCompactTaskQueue.hpp"
 #include "CYThread/ICYThread.hpp"
+#include "CYThread/CYTaskGroup.hpp"
 
 CYTHRAD_NAMESPACE_BEGIN
 
@@ -85,6 +93,15 @@ public:
      */
     [[nodiscard]] bool CreateThreadPool(const CYPlatformId& eThreadType, int iMaxThread = 10) noexcept override;
 
+    /**
+     * Create thread pool with specified platform, max threads and creation options.
+     * @param eThreadType Platform type.
+     * @param iMaxThread Max thread count.
+     * @param objOptions Worker hooks and other creation options.
+     * @return True if success, false otherwise.
+     */
+    [[nodiscard]] bool CreateThreadPool(const CYPlatformId& eThreadType, int iMaxThread, const CYThreadPoolOptions& objOptions) noexcept override;
+
     /**
      * Submit a objTask to the pool.
      * @param objTask Task object.
@@ -99,6 +116,129 @@ public:
      */
     [[nodiscard]] bool SubmitTask(ICYIThreadableObject* pInvokingObject) noexcept override;
 
+    /**
+     * Submit a objTask on behalf of a task group.
+     * @param objTask Task object.
+     * @param pTaskGroup Group that tracks the task, may be nullptr.
+     * @return True if success, false otherwise.
+     */
+    [[nodiscard]] bool SubmitTask(const CYThreadTask& objTask, CYTaskGroup* pTaskGroup) noexcept override;
+
+    /**
+     * Submit an object objTask on behalf of a task group.
+     * @param pInvokingObject Object invoking the task.
+     * @param pTaskGroup Group that tracks the task, may be nullptr.
+     * @return True if success, false if the pool rejected it or the object is still queued.
+     */
+    [[nodiscard]] bool SubmitTask(ICYIThreadableObject* pInvokingObject, CYTaskGroup* pTaskGroup) noexcept override;
+
+    /**
+     * Discard the queued tasks of a cancelled group and signal the running ones.
+     * @param pTaskGroup Cancelled group.
+     * @note Queued tasks are tombstoned by the group flag and dropped by the next distribution
+     *       pass without being handed to a worker.
+     */
+    void CancelTaskGroup(CYTaskGroup* pTaskGroup) noexcept override;
+
+    /**
+     * Run the oldest queued task on the calling thread.
+     * @return True if a task was executed, false if the queues were empty.
+     * @note Used by a worker that blocks on its own children, so they cannot starve behind it.
+     */
+    [[nodiscard]] bool ExecutePendingTask() noexcept override;
+
+    /**
+     * Submit a compact objTask, a function pointer plus its context.
+     * @param pfnTask Task procedure.
+     * @param pContext Context handed to the procedure.
+     * @return True if success, false if the pool does not accept tasks or is out of memory.
+     * @note Compact tasks have a queue of their own that MaxTasks does not limit.
+     */
+    [[nodiscard]] bool SubmitCompactTask(CYCompactTaskProc pfnTask, void* pContext) noexcept override;
+
+    /**
+     * Submit compact tasks in bulk, the queue is locked once for the whole range.
+     * @param pTasks Task descriptors.
+     * @param nCount Number of descriptors.
+     * @return Number of tasks queued, zero if the pool does not accept tasks.
+     * @note Every descriptor must have a procedure, the range is copied without being checked.
+     */
+    [[nodiscard]] size_t SubmitCompactTasks(const CYCompactTask* pTasks, size_t nCount) noexcept override;
+
+    /**
+     * Submit a objTask once the delay has elapsed.
+     * @param nDelay Delay before the task is queued.
+     * @param objTask Task object.
+     * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+     */
+    [[nodiscard]] CYTimerId SubmitAfter(std::chrono::milliseconds nDelay, const CYThreadTask& objTask) override;
+
+    /**
+     * Submit a objTask at the given time point.
+     * @param tpWhen Time point at which the task is queued.
+     * @param objTask Task object.
+     * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+     */
+    [[nodiscard]] CYTimerId SubmitAt(std::chrono::steady_clock::time_point tpWhen, const CYThreadTask& objTask) override;
+
+    /**
+     * Submit a objTask every period until the timer is cancelled.
+     * @param nPeriod Period between two submissions, must be positive.
+     * @param objTask Task object.
+     * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+     */
+    [[nodiscard]] CYTimerId SubmitEvery(std::chrono::milliseconds nPeriod, const CYThreadTask& objTask) override;
+
+    /**
+     * Cancel a delayed or periodic objTask that has not fired yet.
+     * @param nTimerId Timer id.
+     * @return True if the timer was pending, false if it already fired or is unknown.
+     */
+    bool CancelTimer(CYTimerId nTimerId) noexcept override;
+
+    /**
+     * Coalesce consecutive tiny tasks into batches that a worker runs back-to-back.
+     * @param bEnable True to enable batching.
+     * @param nMaxLatencyUs Longest time a task may wait behind earlier tasks of its batch.
+     */
+    void SetTaskBatching(bool bEnable, uint32_t nMaxLatencyUs = 1000) noexcept override;
+
+    /**
+     * Submit a objTask that only the given worker may run.
+     * @param nWorkerIndex Index of the worker, see GetCurrentWorkerIndex().
+     * @param objTask Task object.
+     * @return True if success, false if the index is invalid or the pool rejected the task.
+     */
+    [[nodiscard]] bool SubmitToWorker(int nWorkerIndex, const CYThreadTask& objTask) noexcept override;
+
+    /**
+     * Get the index of the worker running the calling thread.
+     * @return Worker index, -1 if the caller is not a worker of this pool.
+     */
+    [[nodiscard]] int GetCurrentWorkerIndex() const noexcept override;
+
+    /**
+     * Run a kernel on every worker at once and wait until all of them returned.
+     * @param funKernel Kernel, receives the worker index, the worker count and a barrier shared by the region.
+     * @return True if the region ran, false if called from a worker of this pool or the pool rejected it.
+     * @note The region starts once every worker finished its current task. An exception thrown by
+     *       the kernel is rethrown here once every worker returned.
+     */
+    bool RunOnAllWorkers(const CYParallelKernel& funKernel) override;
+
+    /**
+     * Start a new scratch frame, every worker resets its arena before its next task.
+     * @note Only meaningful with CYArenaResetMode::RESET_PER_FRAME.
+     */
+    void AdvanceScratchFrame() noexcept override;
+
+    /**
+     * Create missing workers, touch their stacks and fill their caches ahead of the first tasks.
+     * @param nStackBytes Stack bytes every worker writes to.
+     * @return True if every worker was warmed, false if called from a worker of this pool or the pool is not running.
+     */
+    bool Prewarm(size_t nStackBytes = CYTHREAD_PREWARM_STACK_SIZE) noexcept override;
+
     /**
      * Check if any threads are working.
      * @return True if any threads are working, false otherwise.
@@ -123,7 +263,7 @@ public:
      */
     [[nodiscard]] int GetTaskCount() const noexcept override
     {
-        return static_cast<int>(m_lstTTask.size());
+        return static_cast<int>(m_lstTask.GetFreshCount(CYTaskKind::TASK_KIND_OBJECT));
     }
 
     /**
@@ -132,9 +272,57 @@ public:
      */
     [[nodiscard]] int GetTasksMissedCount() const noexcept override
     {
-        return static_cast<int>(m_lstTTaskMiss.size());
+        return static_cast<int>(m_lstTask.GetMissedCount(CYTaskKind::TASK_KIND_OBJECT));
     }
 
+    /**
+     * Get a snapshot of the pool metrics.
+     * @return Counters, queue depth and latency histograms.
+     */
+    [[nodiscard]] CYThreadPoolMetrics GetMetrics() const noexcept override;
+
+    /**
+     * Write the recorded submit, dispatch, task and idle events as Chrome trace JSON.
+     * @param objStream Output stream.
+     * @return True if tracing is on and the stream took the trace.
+     */
+    bool WriteTrace(std::ostream& objStream) const noexcept override;
+
+    /**
+     * Get the performance counters and CPU time of the finished tasks, summed per task type.
+     * @return One entry per task type, most frequent first, empty unless the pool samples tasks.
+     */
+    [[nodiscard]] std::vector<CYTaskPerfStats> GetPerfStats() const noexcept override;
+
+    /**
+     * Get counts, latencies and CPU time of every tag seen so far.
+     * @return One entry per tag, in no particular order.
+     */
+    [[nodiscard]] std::vector<CYTaskTagStats> GetTagStats() const noexcept override;
+
+    /**
+     * Wait until no task of the tag is queued or running.
+     * @param nTag Tag.
+     * @param nTimeoutMs Timeout in milliseconds, UINT32_MAX waits forever.
+     * @return 0 if the tag is idle, 1 on timeout.
+     */
+    uint32_t WaitForTag(CYTaskTag nTag, uint32_t nTimeoutMs = UINT32_MAX) noexcept override;
+
+    /**
+     * Drop the queued tasks of a tag and signal the running ones.
+     * @param nTag Tag.
+     * @return Number of queued tasks dropped.
+     */
+    size_t CancelTag(CYTaskTag nTag) noexcept override;
+
+    /**
+     * Limit how many tasks of a tag run at once.
+     * @param nTag Tag.
+     * @param nMaxRunning Limit, 0 removes it.
+     * @return False if the pool is not created or cannot track more tags.
+     */
+    bool SetTagConcurrency(CYTaskTag nTag, uint32_t nMaxRunning) noexcept override;
+
     /**
      * Get nAvailable thread count.
      * @return nAvailable thread count.
@@ -189,7 +377,8 @@ public:
     /**
      * Terminate specific working thread.
      * @param pInvokingObject Object invoking the task.
-     * @note This function will terminate only the specified thread, not all working threads.
+     * @note The object is dropped if it is still queued, otherwise the stop token of the running
+     *       task is signalled. The worker itself keeps serving the pool.
      */
     void TerminateWorkingThread(ICYIThreadableObject* pInvokingObject) noexcept override;
 
@@ -230,6 +419,16 @@ public:
      */
     [[nodiscard]] bool Shutdown() noexcept;
 
+    /**
+     * Shutdown thread pool using the given mode.
+     * @param eMode Shutdown mode.
+     * @param nTimeoutMs Drain deadline in milliseconds, only used by SHUTDOWN_MODE_DRAIN_DEADLINE.
+     * @param funOnCancelled Callback invoked for every pending task that is dropped.
+     * @return True if every pending task was executed or handed to the callback before the workers stopped,
+     *         false if the drain deadline expired.
+     */
+    [[nodiscard]] bool Shutdown(CYShutdownMode eMode, uint32_t nTimeoutMs = 0, const CYCancelledTaskCallback& funOnCancelled = nullptr) noexcept override;
+
 private:
     /**
      * Thread list types.
@@ -238,24 +437,56 @@ private:
     using ThreadListIT = ThreadList::iterator;
 
     /**
-     * Task list types.
+     * Task list types, one queue holds function and object tasks.
      */
-    using TaskList = std::deque<CYThreadTask>;
+    using TaskList = CYTaskQueue;
     using TaskListIT = TaskList::iterator;
 
     /**
-     * Object objTask list types.
+     * Tasks of one batch, allocated from the memory resource of the pool.
      */
-    using TTaskList = std::deque<ICYIThreadableObject*>;
-    using TTaskListIT = TTaskList::iterator;
+    using TaskBatch = std::pmr::vector<CYThreadTask>;
 
     /**
      * Thread pool data.
      */
     ThreadList m_lstThread;
-    TaskList m_lstTask, m_lstTaskMiss;
-    TTaskList m_lstTTask, m_lstTTaskMiss;
+
+    /**
+     * Size of m_lstThread, read without the lock by GetCurrentWorker. The list reserves the
+     * maximum worker count up front, so workers spawned later never move the others.
+     */
+    std::atomic<size_t> m_nThreadCount{ 0 };
+
+    /**
+     * Platform the workers are created for, kept for workers spawned after CreateThreadPool.
+     */
+    CYPlatformId m_eThreadType{ CY_PLATFORM_WINDOWS };
+
+    /**
+     * Function task nodes are recycled, the pool must outlive the queue. Object tasks are linked
+     * through their own hooks and need no nodes. The node pool also holds the memory resource.
+     */
+    CYTaskNodePool<CYQueuedTask> m_objTaskNodePool;
+    TaskList m_lstTask{ m_objTaskNodePool, true };
+
+    /**
+     * Counters and latency histograms, one slot per worker. The workers point into the slots,
+     * which come from the memory resource of m_objTaskNodePool.
+     */
+    CYPoolMetrics m_objMetrics;
+
+    /**
+     * Trace rings, one per worker, only allocated when the options ask for tracing.
+     */
+    CYPoolTrace m_objTrace;
+
+    /**
+     * Counters and concurrency limits per tag, the workers record their tagged tasks in it.
+     */
+    CYTagTable m_objTagTable;
     CYThreadPoolProperties m_objTPProps;
+    CYThreadPoolOptions m_objOptions;
 
     /**
      * Synchronization.
@@ -264,12 +495,74 @@ private:
     mutable std::condition_variable m_objCondVar;
     std::atomic<bool> m_bShutdown{ false };
 
+    /**
+     * Threads in WaitForDrain, finishing tasks only take the lock to wake them while there are any.
+     */
+    std::atomic<uint32_t> m_nDrainWaiters{ 0 };
+
+    /**
+     * RunOnAllWorkers() regions still running, Shutdown waits for them on m_objCondVar. Guarded by m_objMutex.
+     */
+    size_t m_nActiveRegions{ 0 };
+
+    /**
+     * Lazy worker creation, a dispatch pass records the worker count it was missing and the
+     * workers are created after the lock is released. Guarded by m_objMutex.
+     */
+    size_t m_nSpawnDemand{ 0 };
+    bool m_bSpawning{ false };
+    std::condition_variable m_objSpawnCondVar;
+
+    /**
+     * Serializes Shutdown calls while they join the workers outside m_objMutex.
+     */
+    std::mutex m_objJoinMutex;
+
+    /**
+     * Scratch frame counter, the workers compare it with the frame they last reset at.
+     */
+    std::atomic<uint64_t> m_nScratchFrame{ 0 };
+
     /**
      * Task distribution management.
      */
     std::unique_ptr<std::thread> m_ptrDistributionThread;
     std::atomic<bool> m_bDistributionRunning{ false };
 
+    /**
+     * Delayed and periodic tasks, serviced by the distribution thread.
+     */
+    CYTimerWheel m_objTimerWheel;
+    std::mutex m_objTimerMutex;
+    std::condition_variable m_objTimerCondVar;
+    bool m_bTimerScheduled{ false };
+    bool m_bTimersClosed{ false };
+
+    /**
+     * Moving average of the task duration measured by batches.
+     */
+    std::atomic<uint64_t> m_nAvgTaskNs{ 0 };
+
+    /**
+     * Compact tasks and the number of workers draining them, guarded by m_objCompactMutex.
+     * When both locks are needed m_objMutex is taken first.
+     */
+    CYCompactTaskQueue m_objCompactQueue;
+    size_t m_nCompactRunners{ 0 };
+    mutable std::mutex m_objCompactMutex;
+
+    /**
+     * Set by the distribution pass while tasks wait for a worker, runners stop draining then.
+     */
+    std::atomic<bool> m_bCompactYield{ false };
+
+    /**
+     * Records the current dispatch pass left queued because every worker was busy. Throttled,
+     * pinned and affinity-waiting records do not count, a yielding runner would not help them.
+     * Guarded by m_objMutex.
+     */
+    size_t m_nWorkerShortage{ 0 };
+
 private:
     /**
      * Remove objTask from objTask list.
@@ -285,6 +578,234 @@ private:
      */
     [[nodiscard]] bool CleanTaskList() noexcept;
 
+    /**
+     * Get available thread, the caller must hold m_objMutex.
+     * @return Available thread or nullptr.
+     */
+    [[nodiscard]] CYThread* FindAvailThread() noexcept;
+
+    /**
+     * Workers every spawning thread creates at least in SPAWN_MODE_PARALLEL.
+     */
+    static constexpr size_t SPAWN_SLICE_MIN = 8;
+
+    /**
+     * Create workers without adding them to the pool.
+     * @param nFirstIndex Index of the first worker.
+     * @param nCount Workers to create.
+     * @param bParallel Spread the thread creation over several spawning threads.
+     * @return Created workers, indexed from nFirstIndex without gaps.
+     */
+    [[nodiscard]] ThreadList CreateWorkers(size_t nFirstIndex, size_t nCount, bool bParallel) const noexcept;
+
+    /**
+     * Add workers until the pool has nCount of them, the caller must not hold m_objMutex.
+     * @param nCount Wanted worker count, capped at the maximum.
+     * @return Worker count afterwards.
+     */
+    size_t SpawnWorkers(size_t nCount) noexcept;
+
+    /**
+     * Count queued tasks of every kind, the caller must hold m_objMutex.
+     * @return Pending task count.
+     */
+    [[nodiscard]] size_t GetPendingTaskCount() const noexcept;
+
+    /**
+     * Get the index of the worker running the calling thread.
+     * @return Worker index, SIZE_MAX if the caller is not a worker of this pool.
+     * @note The worker list only changes while no task runs, so no lock is needed.
+     */
+    [[nodiscard]] size_t GetCurrentWorker() const noexcept;
+
+    /**
+     * Check if a queued entry is pinned to another worker.
+     * @param objEntry Queued entry.
+     * @param nWorker Worker index asking, SIZE_MAX for a non-worker thread.
+     * @return True if only another worker may run the entry.
+     */
+    [[nodiscard]] static bool IsPinnedElsewhere(const CYQueuedTask& objEntry, size_t nWorker) noexcept;
+
+    /**
+     * Get a worker for a queued function task, the caller must hold m_objMutex.
+     * @param pRecord Record of the task.
+     * @return Worker or nullptr if the task stays queued.
+     * @note A pinned task only ever goes to its own worker.
+     */
+    [[nodiscard]] CYThread* FindTaskThread(CYTaskRecord* pRecord) noexcept;
+
+    /**
+     * Hand one queued record to a worker, the caller must hold m_objMutex.
+     * @param pRecord Record to dispatch, advanced to the next newer record still queued.
+     * @param nBatchSize Tasks per batch for this pass.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     */
+    void DispatchRecord(CYTaskRecord*& pRecord, size_t nBatchSize, size_t nWorker) noexcept;
+
+    /**
+     * Upper bound of tasks coalesced into one batch.
+     */
+    static constexpr size_t MAX_BATCH_SIZE = 64;
+
+    /**
+     * Pick the batch size for this dispatch pass, the caller must hold m_objMutex.
+     * @return Tasks per batch, 1 disables batching for the pass.
+     */
+    [[nodiscard]] size_t GetBatchSize() noexcept;
+
+    /**
+     * Check if a queued record may share a batch.
+     * @param pRecord Queued record.
+     * @return True for plain function tasks without group, pin or affinity.
+     */
+    [[nodiscard]] static bool IsBatchable(CYTaskRecord* pRecord) noexcept;
+
+    /**
+     * Take consecutive batchable records out of the queue, the caller must hold m_objMutex.
+     * @param pRecord Oldest record of the batch, advanced to the next newer record still queued.
+     * @param nBatchSize Maximum records to take.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @return Task running the batch.
+     */
+    [[nodiscard]] CYThreadTask BuildTaskBatch(CYTaskRecord*& pRecord, size_t nBatchSize, size_t nWorker);
+
+    /**
+     * Run a batch back-to-back on the calling worker.
+     * @param lstBatch Tasks of the batch.
+     * @param nLatencyUs Latency cap of the batch.
+     * @param objStopToken Token of the batch task.
+     * @note Tasks that would start after the latency cap are queued again.
+     */
+    void RunTaskBatch(TaskBatch& lstBatch, uint32_t nLatencyUs, const CYStopToken& objStopToken) noexcept;
+
+    /**
+     * Compact tasks a runner takes out of the queue at once.
+     */
+    static constexpr size_t COMPACT_CHUNK_SIZE = 64;
+
+    /**
+     * Hand compact tasks to idle workers, the caller must hold m_objMutex.
+     */
+    void DispatchCompactTasks() noexcept;
+
+    /**
+     * Count queued tasks in the metrics, the trace and the tag table.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param nCount Number of tasks.
+     * @param nTag Tag of the tasks.
+     */
+    void RecordSubmit(size_t nWorker, uint64_t nCount = 1, CYTaskTag nTag = CYTHREAD_NO_TAG) const noexcept
+    {
+        m_objMetrics.OnSubmit(nWorker, nCount);
+        m_objTrace.Record(nWorker, CYTraceEventType::TRACE_EVENT_SUBMIT, nCount);
+        m_objTagTable.OnSubmit(nTag, nCount);
+    }
+
+    /**
+     * Count a task the pool refused in the metrics and the tag table.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param nTag Tag of the task.
+     */
+    void RecordReject(size_t nWorker, CYTaskTag nTag = CYTHREAD_NO_TAG) const noexcept
+    {
+        m_objMetrics.OnReject(nWorker);
+        m_objTagTable.OnReject(nTag);
+    }
+
+    /**
+     * Count a record taken out of the queue to run, the caller must hold m_objMutex.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @param objRecord Record of the task.
+     */
+    void RecordStart(size_t nWorker, const CYTaskRecord& objRecord) const noexcept
+    {
+        m_objMetrics.OnStart(nWorker, objRecord);
+        m_objTagTable.OnStart(objRecord);
+    }
+
+    /**
+     * Drain the compact queue chunk by chunk on the calling worker.
+     * @param objStopToken Token of the runner task.
+     * @note Returns once the queue is empty or other tasks are waiting.
+     */
+    void RunCompactTasks(const CYStopToken& objStopToken) noexcept;
+
+    /**
+     * Dispatch passes a task waits for its busy preferred worker before any worker may take it.
+     */
+    static constexpr uint32_t AFFINITY_MAX_SKIPS = 2;
+
+    /**
+     * Map an affinity key to a worker index, the caller must hold m_objMutex.
+     * @param nAffinityKey Affinity key.
+     * @return Worker index, SIZE_MAX for no preference.
+     */
+    [[nodiscard]] size_t GetPreferredThread(uint64_t nAffinityKey) const noexcept;
+
+    /**
+     * Get the preferred worker of an object, the caller must hold m_objMutex.
+     * @param pObject Object task.
+     * @return Worker index, SIZE_MAX for no preference.
+     */
+    [[nodiscard]] size_t GetPreferredThread(const ICYIThreadableObject* pObject) const noexcept;
+
+    /**
+     * Get a worker for a task with a preferred worker, the caller must hold m_objMutex.
+     * @param nPreferred Preferred worker index, SIZE_MAX for none.
+     * @param nAffinitySkips Passes the task already waited, incremented when it has to wait again.
+     * @return Worker or nullptr if the task stays queued.
+     * @note Another worker is only used once the task waited AFFINITY_MAX_SKIPS passes.
+     */
+    [[nodiscard]] CYThread* FindAffinityThread(size_t nPreferred, uint32_t& nAffinitySkips) noexcept;
+
+    /**
+     * Remove the queued records of a group and its child groups on this pool, the caller must hold m_objMutex.
+     * @param pTaskGroup Cancelled group.
+     * @param nWorker Index of the calling worker, SIZE_MAX for other threads.
+     * @note The group is released last, its owner may destroy it right after.
+     */
+    void DropGroupTasks(CYTaskGroup* pTaskGroup, size_t nWorker) noexcept;
+
+    /**
+     * Check if a queued entry belongs to a cancelled group and release it if so.
+     * @param objRecord Record of the entry.
+     * @return True if the entry must be dropped.
+     */
+    [[nodiscard]] bool DiscardIfCancelled(const CYTaskRecord& objRecord) noexcept;
+
+    /**
+     * Schedule a objTask on the timer wheel.
+     * @param tpExpire When the task is due.
+     * @param nPeriod Repeat period, zero for a one-shot timer.
+     * @param objTask Task object.
+     * @return Timer id, CYTHREAD_INVALID_TIMER_ID if the pool does not accept tasks.
+     */
+    [[nodiscard]] CYTimerId ScheduleTimer(std::chrono::steady_clock::time_point tpExpire, std::chrono::milliseconds nPeriod, const CYThreadTask& objTask);
+
+    /**
+     * Queue the timer tasks that became due.
+     * @return Time of the next timer wheel expiry, time_point::max() if no timer is pending.
+     */
+    [[nodiscard]] std::chrono::steady_clock::time_point ProcessTimers() noexcept;
+
+    /**
+     * Wait until every queued task has been dispatched and executed.
+     * @param tpDeadline Time point after which the wait gives up.
+     * @return True if the pool drained, false if the deadline expired.
+     */
+    [[nodiscard]] bool WaitForDrain(std::chrono::steady_clock::time_point tpDeadline) noexcept;
+
+    /**
+     * Wake the threads in WaitForDrain after a task finished, the caller must not hold m_objMutex.
+     */
+    void NotifyDrainWaiters() const noexcept;
+
+    /**
+     * Remove all pending tasks and report each one through the callback.
+     * @param funOnCancelled Callback invoked outside the pool lock, may be empty.
+     */
+    void CancelPendingTasks(const CYCancelledTaskCallback& funOnCancelled) noexcept;
+
     /**
      * Set objTask pool lock status.
      * @param status Lock status.
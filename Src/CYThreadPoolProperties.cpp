@@ -49,4 +49,16 @@ int32_t CYThreadPoolProperties::GetTaskPoolLock(void)
     return m_nBlockTask;
 }
 
+/**
+ * Function member to enable coalescing of tiny tasks into batches
+ * @param bEnable: true to batch consecutive plain function tasks
+ * @param nMaxLatencyUs: longest time a task may wait behind earlier tasks of its batch
+ * @return void
+ */
+void CYThreadPoolProperties::SetTaskBatching(bool bEnable, uint32_t nMaxLatencyUs)
+{
+    m_bTaskBatching = bEnable;
+    m_nBatchLatencyUs = nMaxLatencyUs;
+}
+
 CYTHRAD_NAMESPACE_END
\ No newline at end of file
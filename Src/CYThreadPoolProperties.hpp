@@ -103,6 +103,32 @@ public:
     {
         return m_nMaxTasks;
     }
+
+    /**
+     * Function member to enable coalescing of tiny tasks into batches
+     * @param bEnable: true to batch consecutive plain function tasks
+     * @param nMaxLatencyUs: longest time a task may wait behind earlier tasks of its batch
+     * @return void
+     */
+    void SetTaskBatching(bool bEnable, uint32_t nMaxLatencyUs);
+
+    /**
+     * Check if task batching is enabled
+     * @return true if enabled
+     */
+    bool GetTaskBatching() const noexcept
+    {
+        return m_bTaskBatching;
+    }
+
+    /**
+     * Get the batching latency cap
+     * @return the cap in microseconds
+     */
+    uint32_t GetBatchLatencyUs() const noexcept
+    {
+        return m_nBatchLatencyUs;
+    }
 public:
     /**
      * Maximum number of threads that the pool can allocate.
@@ -118,6 +144,16 @@ public:
      * Block any new tasks from being submitted.
      */
     int32_t m_nBlockTask;
+
+    /**
+     * Coalesce consecutive tiny tasks into one work unit.
+     */
+    bool m_bTaskBatching{ false };
+
+    /**
+     * Latency cap of a batch in microseconds.
+     */
+    uint32_t m_nBatchLatencyUs{ 1000 };
 };
 
 CYTHRAD_NAMESPACE_END
@@ -0,0 +1,356 @@
+#include "CYThreadPCH.hpp"
+#include "CYTimerWheel.hpp"
+#include <algorithm>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Constructor.
+ * @param tpOrigin Time point of tick zero.
+ */
+CYTimerWheel::CYTimerWheel(Clock::time_point tpOrigin)
+    : m_tpOrigin(tpOrigin)
+{
+    m_arrSlot.fill(INVALID_INDEX);
+}
+
+/**
+ * Schedule a objTask.
+ * @param tpExpire When the task is due, it never fires earlier.
+ * @param nPeriod Repeat period, zero for a one-shot timer.
+ * @param objTask Task to hand out when the timer fires.
+ * @return Timer id, never CYTHREAD_INVALID_TIMER_ID.
+ */
+CYTimerId CYTimerWheel::Schedule(Clock::time_point tpExpire, std::chrono::milliseconds nPeriod, const CYThreadTask& objTask)
+{
+    uint32_t nIndex = m_nFreeHead;
+    if (nIndex != INVALID_INDEX)
+    {
+        m_nFreeHead = m_lstNode[nIndex].nNext;
+    }
+    else
+    {
+        nIndex = static_cast<uint32_t>(m_lstNode.size());
+        m_lstNode.emplace_back();
+    }
+
+    auto& objNode = m_lstNode[nIndex];
+    objNode.objTask = objTask;
+    objNode.nExpireTick = std::max(ToTick(tpExpire), m_nCurrentTick + 1);
+    objNode.nPeriodTicks = nPeriod.count() > 0 ? static_cast<uint64_t>(nPeriod.count()) : 0;
+    Insert(nIndex);
+    ++m_nTimerCount;
+
+    // Index is biased by one so that no valid id equals CYTHREAD_INVALID_TIMER_ID.
+    return (static_cast<uint64_t>(objNode.nGeneration) << 32) | (static_cast<uint64_t>(nIndex) + 1);
+}
+
+/**
+ * Cancel a timer.
+ * @param nTimerId Timer id returned by Schedule().
+ * @return True if the timer was still pending, false if it fired or was unknown.
+ */
+bool CYTimerWheel::Cancel(CYTimerId nTimerId) noexcept
+{
+    const uint64_t nBiasedIndex = nTimerId & 0xFFFFFFFFu;
+    if (nBiasedIndex == 0 || nBiasedIndex > m_lstNode.size())
+    {
+        return false;
+    }
+
+    const auto nIndex = static_cast<uint32_t>(nBiasedIndex - 1);
+    auto& objNode = m_lstNode[nIndex];
+    if (objNode.nGeneration != static_cast<uint32_t>(nTimerId >> 32) || objNode.nSlot == INVALID_INDEX)
+    {
+        return false;
+    }
+
+    Unlink(nIndex);
+    Release(nIndex);
+    --m_nTimerCount;
+    return true;
+}
+
+/**
+ * Advance the wheel and collect the tasks that became due.
+ * @param tpNow Current time.
+ * @param lstExpired Receives the due tasks in expiry order.
+ */
+void CYTimerWheel::Advance(Clock::time_point tpNow, std::pmr::vector<CYThreadTask>& lstExpired)
+{
+    if (tpNow < m_tpOrigin)
+    {
+        return;
+    }
+
+    const auto nTargetTick = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(tpNow - m_tpOrigin).count());
+
+    // An empty wheel has nothing to cascade, it can jump straight to the target.
+    while (m_nCurrentTick < nTargetTick && m_nTimerCount != 0)
+    {
+        Tick(lstExpired);
+    }
+
+    if (m_nCurrentTick < nTargetTick)
+    {
+        m_nCurrentTick = nTargetTick;
+    }
+}
+
+/**
+ * Get the earliest time at which Advance() can have work to do.
+ * @return Due time of the next level zero timer or cascade, Clock::time_point::max() if no timer is pending.
+ */
+CYTimerWheel::Clock::time_point CYTimerWheel::GetNextExpiry() const noexcept
+{
+    if (m_nTimerCount == 0)
+    {
+        return Clock::time_point::max();
+    }
+
+    // Higher levels only move down at a level one boundary, so nothing fires before the next
+    // one unless level zero holds an earlier timer. Level zero covers the next 255 ticks.
+    uint64_t nNextTick = (m_nCurrentTick | (LEVEL_SLOTS - 1)) + 1;
+    for (uint64_t nTick = m_nCurrentTick + 1; nTick < nNextTick; ++nTick)
+    {
+        if (m_arrSlot[static_cast<uint32_t>(nTick & (LEVEL_SLOTS - 1))] != INVALID_INDEX)
+        {
+            nNextTick = nTick;
+            break;
+        }
+    }
+
+    return m_tpOrigin + std::chrono::milliseconds(nNextTick);
+}
+
+/**
+ * Drop every pending timer.
+ * @param lstCleared Receives the task of every dropped timer.
+ * @param tpNow Current time, only used with pDue.
+ * @param pDue Receives the one-shot tasks due by tpNow in expiry order instead of lstCleared, nullptr to drop them too.
+ * @note A task that cannot be stored for lack of memory is dropped unreported.
+ */
+void CYTimerWheel::Clear(std::pmr::vector<CYThreadTask>& lstCleared, Clock::time_point tpNow, std::pmr::vector<CYThreadTask>* pDue) noexcept
+{
+    const bool bCollectDue = pDue != nullptr && tpNow >= m_tpOrigin;
+    const uint64_t nDueTick = bCollectDue ? static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(tpNow - m_tpOrigin).count()) : 0;
+
+    // Due nodes stay allocated until they are sorted, everything else is released right away.
+    std::pmr::vector<std::pair<uint64_t, uint32_t>> lstDueNode(m_lstNode.get_allocator().resource());
+    try
+    {
+        lstCleared.reserve(lstCleared.size() + m_nTimerCount);
+    }
+    catch (const std::exception&)
+    {
+    }
+
+    for (uint32_t nSlot = 0; nSlot < m_arrSlot.size(); ++nSlot)
+    {
+        uint32_t nIndex = DetachSlot(nSlot);
+        while (nIndex != INVALID_INDEX)
+        {
+            auto& objNode = m_lstNode[nIndex];
+            const uint32_t nNext = objNode.nNext;
+            bool bDue = false;
+            try
+            {
+                if (bCollectDue && objNode.nPeriodTicks == 0 && objNode.nExpireTick <= nDueTick)
+                {
+                    lstDueNode.emplace_back(objNode.nExpireTick, nIndex);
+                    bDue = true;
+                }
+                else
+                {
+                    lstCleared.push_back(std::move(objNode.objTask));
+                }
+            }
+            catch (const std::exception&)
+            {
+            }
+
+            if (!bDue)
+            {
+                Release(nIndex);
+            }
+            nIndex = nNext;
+        }
+    }
+
+    std::sort(lstDueNode.begin(), lstDueNode.end());
+    for (const auto& [nExpireTick, nIndex] : lstDueNode)
+    {
+        try
+        {
+            pDue->push_back(std::move(m_lstNode[nIndex].objTask));
+        }
+        catch (const std::exception&)
+        {
+        }
+        Release(nIndex);
+    }
+    m_nTimerCount = 0;
+}
+
+/**
+ * Set the memory resource of the timer slab.
+ * @param pMemoryResource Memory resource, nullptr for std::pmr::get_default_resource().
+ * @return True if applied, false once a timer has been scheduled.
+ */
+bool CYTimerWheel::SetMemoryResource(std::pmr::memory_resource* pMemoryResource) noexcept
+{
+    if (m_lstNode.capacity() != 0)
+    {
+        return false;
+    }
+
+    // A pmr vector keeps its resource for life, so the empty slab is rebuilt on the new one.
+    std::destroy_at(&m_lstNode);
+    std::construct_at(&m_lstNode, pMemoryResource ? pMemoryResource : std::pmr::get_default_resource());
+    return true;
+}
+
+/**
+ * Convert a time point to a tick, rounding up.
+ */
+uint64_t CYTimerWheel::ToTick(Clock::time_point tpTime) const noexcept
+{
+    if (tpTime <= m_tpOrigin)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(std::chrono::ceil<std::chrono::milliseconds>(tpTime - m_tpOrigin).count());
+}
+
+/**
+ * Link a node into the slot matching its expiry.
+ */
+void CYTimerWheel::Insert(uint32_t nIndex) noexcept
+{
+    auto& objNode = m_lstNode[nIndex];
+    const uint64_t nDelta = objNode.nExpireTick > m_nCurrentTick ? objNode.nExpireTick - m_nCurrentTick : 0;
+
+    uint32_t nLevel = 0;
+    while (nLevel + 1 < LEVEL_COUNT && nDelta >= (uint64_t(1) << (LEVEL_BITS * (nLevel + 1))))
+    {
+        ++nLevel;
+    }
+
+    // Beyond the top level the timer is parked at the farthest slot and cascaded again later.
+    const uint64_t nRange = uint64_t(1) << (LEVEL_BITS * LEVEL_COUNT);
+    const uint64_t nTick = nDelta < nRange ? objNode.nExpireTick : m_nCurrentTick + nRange - 1;
+
+    objNode.nSlot = nLevel * LEVEL_SLOTS + static_cast<uint32_t>((nTick >> (LEVEL_BITS * nLevel)) & (LEVEL_SLOTS - 1));
+    objNode.nPrev = INVALID_INDEX;
+    objNode.nNext = m_arrSlot[objNode.nSlot];
+    if (objNode.nNext != INVALID_INDEX)
+    {
+        m_lstNode[objNode.nNext].nPrev = nIndex;
+    }
+    m_arrSlot[objNode.nSlot] = nIndex;
+}
+
+/**
+ * Unlink a node from its slot.
+ */
+void CYTimerWheel::Unlink(uint32_t nIndex) noexcept
+{
+    auto& objNode = m_lstNode[nIndex];
+    if (objNode.nPrev != INVALID_INDEX)
+    {
+        m_lstNode[objNode.nPrev].nNext = objNode.nNext;
+    }
+    else
+    {
+        m_arrSlot[objNode.nSlot] = objNode.nNext;
+    }
+
+    if (objNode.nNext != INVALID_INDEX)
+    {
+        m_lstNode[objNode.nNext].nPrev = objNode.nPrev;
+    }
+
+    objNode.nPrev = objNode.nNext = objNode.nSlot = INVALID_INDEX;
+}
+
+/**
+ * Detach the whole list of a slot.
+ * @return Index of the first node of the list.
+ */
+uint32_t CYTimerWheel::DetachSlot(uint32_t nSlot) noexcept
+{
+    const uint32_t nHead = m_arrSlot[nSlot];
+    m_arrSlot[nSlot] = INVALID_INDEX;
+    for (uint32_t nIndex = nHead; nIndex != INVALID_INDEX; nIndex = m_lstNode[nIndex].nNext)
+    {
+        m_lstNode[nIndex].nSlot = INVALID_INDEX;
+    }
+    return nHead;
+}
+
+/**
+ * Return a node to the free list, invalidating its id.
+ */
+void CYTimerWheel::Release(uint32_t nIndex) noexcept
+{
+    auto& objNode = m_lstNode[nIndex];
+    objNode.objTask = {};
+    objNode.nSlot = INVALID_INDEX;
+    objNode.nPrev = INVALID_INDEX;
+    ++objNode.nGeneration;
+    objNode.nNext = m_nFreeHead;
+    m_nFreeHead = nIndex;
+}
+
+/**
+ * Move the wheel one tick forward.
+ */
+void CYTimerWheel::Tick(std::pmr::vector<CYThreadTask>& lstExpired)
+{
+    ++m_nCurrentTick;
+
+    // Find the highest level whose slot boundary was crossed, then cascade top-down so that
+    // timers falling through several levels end up in level zero before it fires.
+    uint32_t nTopLevel = 0;
+    while (nTopLevel + 1 < LEVEL_COUNT && (m_nCurrentTick & ((uint64_t(1) << (LEVEL_BITS * (nTopLevel + 1))) - 1)) == 0)
+    {
+        ++nTopLevel;
+    }
+
+    for (uint32_t nLevel = nTopLevel; nLevel > 0; --nLevel)
+    {
+        const auto nSlot = nLevel * LEVEL_SLOTS + static_cast<uint32_t>((m_nCurrentTick >> (LEVEL_BITS * nLevel)) & (LEVEL_SLOTS - 1));
+        uint32_t nIndex = DetachSlot(nSlot);
+        while (nIndex != INVALID_INDEX)
+        {
+            const uint32_t nNext = m_lstNode[nIndex].nNext;
+            Insert(nIndex);
+            nIndex = nNext;
+        }
+    }
+
+    uint32_t nIndex = DetachSlot(static_cast<uint32_t>(m_nCurrentTick & (LEVEL_SLOTS - 1)));
+    while (nIndex != INVALID_INDEX)
+    {
+        const uint32_t nNext = m_lstNode[nIndex].nNext;
+        auto& objNode = m_lstNode[nIndex];
+        if (objNode.nPeriodTicks != 0)
+        {
+            // Periodic timers keep their id, a late tick skips the missed periods.
+            lstExpired.push_back(objNode.objTask);
+            objNode.nExpireTick = std::max(objNode.nExpireTick + objNode.nPeriodTicks, m_nCurrentTick + 1);
+            Insert(nIndex);
+        }
+        else
+        {
+            lstExpired.push_back(std::move(objNode.objTask));
+            Release(nIndex);
+            --m_nTimerCount;
+        }
+        nIndex = nNext;
+    }
+}
+
+CYTHRAD_NAMESPACE_END
@@ -0,0 +1,198 @@
+/*
+ * CYThread License
+ * -----------
+ *
+ * CYThread is licensed under the terms of the MIT license reproduced below.
+ * This means that CYThread is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2025 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable thread pool library.
+  * CREATION: 2026.10.17
+  * LCHANGE:  2026.10.17
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TIMER_WHEEL_HPP__
+#define __CY_TIMER_WHEEL_HPP__
+
+#include "CYThread/ICYThread.hpp"
+
+#include <array>
+#include <chrono>
+#include <memory_resource>
+#include <vector>
+
+CYTHRAD_NAMESPACE_BEGIN
+
+/**
+ * Hierarchical timing wheel.
+ * Four levels of 256 slots with a 1 ms tick cover about 49 days, later timers are parked in
+ * the top level and cascaded down until they are due. Timers live in a slab and are linked
+ * into their slot by index, so scheduling and cancelling are O(1).
+ * @note Not thread-safe, the owning pool serializes access.
+ */
+class CYTimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor.
+     * @param tpOrigin Time point of tick zero.
+     */
+    explicit CYTimerWheel(Clock::time_point tpOrigin = Clock::now());
+
+    /**
+     * Schedule a objTask.
+     * @param tpExpire When the task is due, it never fires earlier.
+     * @param nPeriod Repeat period, zero for a one-shot timer.
+     * @param objTask Task to hand out when the timer fires.
+     * @return Timer id, never CYTHREAD_INVALID_TIMER_ID.
+     */
+    [[nodiscard]] CYTimerId Schedule(Clock::time_point tpExpire, std::chrono::milliseconds nPeriod, const CYThreadTask& objTask);
+
+    /**
+     * Cancel a timer.
+     * @param nTimerId Timer id returned by Schedule().
+     * @return True if the timer was still pending, false if it fired or was unknown.
+     */
+    bool Cancel(CYTimerId nTimerId) noexcept;
+
+    /**
+     * Advance the wheel and collect the tasks that became due.
+     * @param tpNow Current time.
+     * @param lstExpired Receives the due tasks in expiry order.
+     */
+    void Advance(Clock::time_point tpNow, std::pmr::vector<CYThreadTask>& lstExpired);
+
+    /**
+     * Get the earliest time at which Advance() can have work to do.
+     * @return Due time of the next level zero timer or cascade, Clock::time_point::max() if no timer is pending.
+     */
+    [[nodiscard]] Clock::time_point GetNextExpiry() const noexcept;
+
+    /**
+     * Drop every pending timer.
+     * @param lstCleared Receives the task of every dropped timer.
+     * @param tpNow Current time, only used with pDue.
+     * @param pDue Receives the one-shot tasks due by tpNow in expiry order instead of lstCleared, nullptr to drop them too.
+     * @note A task that cannot be stored for lack of memory is dropped unreported.
+     */
+    void Clear(std::pmr::vector<CYThreadTask>& lstCleared, Clock::time_point tpNow = Clock::time_point::min(),
+        std::pmr::vector<CYThreadTask>* pDue = nullptr) noexcept;
+
+    /**
+     * Set the memory resource of the timer slab.
+     * @param pMemoryResource Memory resource, nullptr for std::pmr::get_default_resource().
+     * @return True if applied, false once a timer has been scheduled.
+     */
+    bool SetMemoryResource(std::pmr::memory_resource* pMemoryResource) noexcept;
+
+    /**
+     * Get the number of pending timers.
+     * @return Pending timer count.
+     */
+    [[nodiscard]] size_t GetTimerCount() const noexcept
+    {
+        return m_nTimerCount;
+    }
+
+private:
+    static constexpr uint32_t LEVEL_BITS = 8;
+    static constexpr uint32_t LEVEL_SLOTS = 1u << LEVEL_BITS;
+    static constexpr uint32_t LEVEL_COUNT = 4;
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    /**
+     * Slab entry of one timer.
+     */
+    struct CYTimerNode
+    {
+        CYThreadTask objTask;
+        uint64_t nExpireTick{ 0 };
+        uint64_t nPeriodTicks{ 0 };
+        uint32_t nPrev{ INVALID_INDEX };
+        uint32_t nNext{ INVALID_INDEX };
+        uint32_t nSlot{ INVALID_INDEX };
+        uint32_t nGeneration{ 0 };
+    };
+
+    /**
+     * Convert a time point to a tick, rounding up.
+     */
+    [[nodiscard]] uint64_t ToTick(Clock::time_point tpTime) const noexcept;
+
+    /**
+     * Link a node into the slot matching its expiry.
+     */
+    void Insert(uint32_t nIndex) noexcept;
+
+    /**
+     * Unlink a node from its slot.
+     */
+    void Unlink(uint32_t nIndex) noexcept;
+
+    /**
+     * Detach the whole list of a slot.
+     * @return Index of the first node of the list.
+     */
+    [[nodiscard]] uint32_t DetachSlot(uint32_t nSlot) noexcept;
+
+    /**
+     * Return a node to the free list, invalidating its id.
+     */
+    void Release(uint32_t nIndex) noexcept;
+
+    /**
+     * Move the wheel one tick forward.
+     */
+    void Tick(std::pmr::vector<CYThreadTask>& lstExpired);
+
+private:
+    Clock::time_point m_tpOrigin;
+    uint64_t m_nCurrentTick{ 0 };
+    size_t m_nTimerCount{ 0 };
+
+    /**
+     * Head node of every slot, level by level.
+     */
+    std::array<uint32_t, LEVEL_SLOTS * LEVEL_COUNT> m_arrSlot;
+
+    /**
+     * Timer slab and its free list.
+     */
+    std::pmr::vector<CYTimerNode> m_lstNode;
+    uint32_t m_nFreeHead{ INVALID_INDEX };
+};
+
+CYTHRAD_NAMESPACE_END
+
+#endif // __CY_TIMER_WHEEL_HPP__
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <set>
+#include <mutex>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Object that records the threads it ran on
+class ShardTask : public ICYIThreadableObject
+{
+private:
+    std::mutex m_mutex;
+    std::set<std::thread::id> m_threads;
+    std::atomic<int> m_runs{0};
+
+public:
+    void TaskToExecute() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_threads.insert(std::this_thread::get_id());
+        }
+        m_runs.fetch_add(1);
+    }
+
+    CYThreadExecutionProps* GetExecutionProps() override
+    {
+        return nullptr;
+    }
+
+    int GetRuns() const { return m_runs.load(); }
+    size_t GetThreadCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_threads.size();
+    }
+};
+
+int main()
+{
+    std::cout << "=== CYThread Affinity Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+
+    // Test 1: tasks with the same key land on the same worker
+    {
+        std::cout << "\n--- Test 1: Affinity Key ---" << std::endl;
+        for (uint64_t nKey = 0; nKey < 4; ++nKey)
+        {
+            std::mutex mutex;
+            std::set<std::thread::id> threads;
+            std::atomic<int> executed{0};
+            for (int i = 0; i < 20; ++i)
+            {
+                CYThreadTask task;
+                task.nAffinityKey = nKey;
+                task.funTaskToExecute = [&](void*, bool) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    threads.insert(std::this_thread::get_id());
+                    executed.fetch_add(1);
+                };
+                if (!pool->SubmitTask(task) || !WaitUntil([&] { return executed.load() == i + 1; }, 1000))
+                {
+                    std::cout << "❌ Task " << i << " of key " << nKey << " did not run" << std::endl;
+                    return 1;
+                }
+            }
+
+            if (threads.size() != 1)
+            {
+                std::cout << "❌ Key " << nKey << " ran on " << threads.size() << " workers" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "✅ Every key stayed on one worker" << std::endl;
+    }
+
+    // Test 2: an object sticks to the worker that ran it last
+    {
+        std::cout << "\n--- Test 2: Sticky Object ---" << std::endl;
+        ShardTask shard;
+        for (int i = 0; i < 20; ++i)
+        {
+            if (!pool->SubmitTask(&shard) || !WaitUntil([&] { return shard.GetRuns() == i + 1; }, 1000))
+            {
+                std::cout << "❌ Run " << i << " did not happen" << std::endl;
+                return 1;
+            }
+        }
+
+        if (shard.GetThreadCount() != 1 || shard.GetLastWorker() < 0)
+        {
+            std::cout << "❌ Object ran on " << shard.GetThreadCount() << " workers" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Object stayed on worker " << shard.GetLastWorker() << std::endl;
+    }
+
+    // Test 3: a busy preferred worker does not starve the key
+    {
+        std::cout << "\n--- Test 3: Stealing Under Imbalance ---" << std::endl;
+        std::atomic<bool> release{false};
+        std::atomic<int> executed{0};
+        CYThreadTask blocker;
+        blocker.nAffinityKey = 7;
+        blocker.funTaskToExecute = [&](void*, bool) {
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        (void)pool->SubmitTask(blocker);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            CYThreadTask task;
+            task.nAffinityKey = 7;
+            task.funTaskToExecute = [&](void*, bool) { executed.fetch_add(1); };
+            (void)pool->SubmitTask(task);
+        }
+
+        bool bStolen = WaitUntil([&] { return executed.load() == 3; }, 1000);
+        release.store(true);
+        if (!bStolen)
+        {
+            std::cout << "❌ Tasks waited for their busy worker" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Other workers took the tasks of the busy worker" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
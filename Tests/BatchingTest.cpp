@@ -0,0 +1,91 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+static bool SubmitAll(ICYThreadPool* pool, int nCount, const std::function<void()>& funBody)
+{
+    for (int i = 0; i < nCount; ++i)
+    {
+        CYThreadTask task;
+        task.funTaskToExecute = [funBody](void*, bool) { funBody(); };
+        auto start = std::chrono::steady_clock::now();
+        while (!pool->SubmitTask(task))
+        {
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5))
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    std::cout << "=== CYThread Batching Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+    pool->SetTaskBatching(true, 1000);
+
+    // Test 1: tiny tasks are coalesced and every one runs exactly once
+    {
+        std::cout << "\n--- Test 1: Tiny Tasks ---" << std::endl;
+        const int nTasks = 5000;
+        std::vector<std::atomic<int>> lstRuns(nTasks);
+        std::atomic<int> executed{0};
+        std::atomic<int> nextIndex{0};
+
+        auto start = std::chrono::steady_clock::now();
+        if (!SubmitAll(pool.get(), nTasks, [&] {
+            lstRuns[nextIndex.fetch_add(1)].fetch_add(1);
+            executed.fetch_add(1);
+        }) || !WaitUntil([&] { return executed.load() == nTasks; }, 10000))
+        {
+            std::cout << "❌ Executed " << executed.load() << " of " << nTasks << std::endl;
+            return 1;
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        for (auto& runs : lstRuns)
+        {
+            if (runs.load() != 1)
+            {
+                std::cout << "❌ A task ran " << runs.load() << " times" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "✅ " << nTasks << " tiny tasks ran once each in " << ms.count() << " ms" << std::endl;
+    }
+
+    // Test 2: slow tasks are not held back behind each other beyond the cap
+    {
+        std::cout << "\n--- Test 2: Latency Cap ---" << std::endl;
+        const int nTasks = 24;
+        std::atomic<int> executed{0};
+        if (!SubmitAll(pool.get(), nTasks, [&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            executed.fetch_add(1);
+        }) || !WaitUntil([&] { return executed.load() == nTasks; }, 10000))
+        {
+            std::cout << "❌ Executed " << executed.load() << " of " << nTasks << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Slow tasks were requeued instead of waiting in their batch" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Task that spins until it is asked to stop
+class SpinningTask : public ICYIThreadableObject
+{
+private:
+    std::atomic<bool> m_started{false};
+    std::atomic<bool> m_stopped{false};
+
+public:
+    void TaskToExecute() override
+    {
+        TaskToExecute(CYStopToken{});
+    }
+
+    void TaskToExecute(const CYStopToken& objStopToken) override
+    {
+        m_started.store(true);
+        auto start = std::chrono::steady_clock::now();
+        while (!objStopToken.stop_requested())
+        {
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5))
+            {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_stopped.store(true);
+    }
+
+    CYThreadExecutionProps* GetExecutionProps() override
+    {
+        return nullptr;
+    }
+
+    bool IsStarted() const { return m_started.load(); }
+    bool IsStopped() const { return m_stopped.load(); }
+};
+
+int main()
+{
+    std::cout << "=== CYThread Cancellation Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+    // Test 1: TerminateWorkingThread signals the running object task
+    {
+        std::cout << "\n--- Test 1: Stop Token Of Running Object ---" << std::endl;
+        SpinningTask task;
+        if (!pool->SubmitTask(&task) || !WaitUntil([&] { return task.IsStarted(); }, 1000))
+        {
+            std::cout << "❌ Task never started" << std::endl;
+            return 1;
+        }
+
+        pool->TerminateWorkingThread(&task);
+        if (!WaitUntil([&] { return task.IsStopped(); }, 1000))
+        {
+            std::cout << "❌ Task did not observe its stop token" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Running task stopped early" << std::endl;
+    }
+
+    // Test 2: the next task on the same worker gets a fresh token
+    {
+        std::cout << "\n--- Test 2: Fresh Token Per Task ---" << std::endl;
+        std::atomic<int> stoppedAtStart{0};
+        std::atomic<int> executed{0};
+        for (int i = 0; i < 6; ++i)
+        {
+            CYThreadTask task;
+            task.funCancellableTaskToExecute = [&](void*, const CYStopToken& objStopToken) {
+                if (objStopToken.stop_requested())
+                {
+                    stoppedAtStart.fetch_add(1);
+                }
+                executed.fetch_add(1);
+            };
+            if (!pool->SubmitTask(task))
+            {
+                std::cout << "❌ Failed to submit task " << i << std::endl;
+                return 1;
+            }
+        }
+
+        if (!WaitUntil([&] { return executed.load() == 6; }, 2000) || stoppedAtStart.load() != 0)
+        {
+            std::cout << "❌ Executed " << executed.load() << ", stopped at start " << stoppedAtStart.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Later tasks were not affected by the earlier stop" << std::endl;
+    }
+
+    // Test 3: a deadline shutdown signals long-running tasks
+    {
+        std::cout << "\n--- Test 3: Shutdown Signals Running Tasks ---" << std::endl;
+        SpinningTask task;
+        if (!pool->SubmitTask(&task) || !WaitUntil([&] { return task.IsStarted(); }, 1000))
+        {
+            std::cout << "❌ Task never started" << std::endl;
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN_DEADLINE, 50);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Shutdown took " << ms.count() << " ms" << std::endl;
+        if (!task.IsStopped() || ms.count() > 1000)
+        {
+            std::cout << "❌ Shutdown waited for the task instead of stopping it" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Shutdown stopped the running task" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
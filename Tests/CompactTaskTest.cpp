@@ -0,0 +1,171 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+static void CountTask(void* pContext)
+{
+    static_cast<std::atomic<int>*>(pContext)->fetch_add(1, std::memory_order_relaxed);
+}
+
+struct OrderContext
+{
+    std::mutex* pMutex;
+    std::vector<int>* pOrder;
+    int nIndex;
+};
+
+static void RecordTask(void* pContext)
+{
+    auto pOrder = static_cast<OrderContext*>(pContext);
+    std::lock_guard<std::mutex> lock(*pOrder->pMutex);
+    pOrder->pOrder->push_back(pOrder->nIndex);
+}
+
+static void SleepTask(void*)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+int main()
+{
+    std::cout << "=== CYThread Compact Task Test ===" << std::endl;
+
+    CYThreadFactory factory;
+
+    // Test 1: a large backlog is queued in bulk and fully executed
+    {
+        std::cout << "\n--- Test 1: Bulk Backlog ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+
+        const int nTasks = 1000000;
+        std::atomic<int> done{0};
+        std::vector<CYCompactTask> lstTask(nTasks, CYCompactTask{ &CountTask, &done });
+
+        auto start = std::chrono::steady_clock::now();
+        const size_t nQueued = pool->SubmitCompactTasks(lstTask.data(), lstTask.size());
+        if (nQueued != lstTask.size())
+        {
+            std::cout << "❌ Only " << nQueued << " tasks queued" << std::endl;
+            return 1;
+        }
+        if (!WaitUntil([&] { return done.load() == nTasks; }, 30000))
+        {
+            std::cout << "❌ " << done.load() << " of " << nTasks << " tasks executed" << std::endl;
+            return 1;
+        }
+        auto nElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "✅ " << nTasks << " compact tasks executed in " << nElapsedMs << " ms" << std::endl;
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    }
+
+    // Test 2: a single worker runs compact tasks in submission order
+    {
+        std::cout << "\n--- Test 2: FIFO Order ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::mutex mutex;
+        std::vector<int> order;
+        std::vector<OrderContext> lstContext;
+        const int nTasks = 10000;
+        for (int i = 0; i < nTasks; ++i)
+        {
+            lstContext.push_back({ &mutex, &order, i });
+        }
+        for (auto& objContext : lstContext)
+        {
+            if (!pool->SubmitCompactTask(&RecordTask, &objContext))
+            {
+                std::cout << "❌ Submit failed" << std::endl;
+                return 1;
+            }
+        }
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (order.size() != static_cast<size_t>(nTasks))
+        {
+            std::cout << "❌ " << order.size() << " tasks executed" << std::endl;
+            return 1;
+        }
+        for (int i = 0; i < nTasks; ++i)
+        {
+            if (order[i] != i)
+            {
+                std::cout << "❌ Task " << order[i] << " ran at position " << i << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "✅ Tasks ran in submission order" << std::endl;
+    }
+
+    // Test 3: function tasks are not starved by a compact backlog
+    {
+        std::cout << "\n--- Test 3: Mixed Queues ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+        std::vector<CYCompactTask> lstTask(2000, CYCompactTask{ &SleepTask, nullptr });
+        (void)pool->SubmitCompactTasks(lstTask.data(), lstTask.size());
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+        std::atomic<bool> ran{false};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { ran.store(true); };
+        auto start = std::chrono::steady_clock::now();
+        if (!pool->SubmitTask(task) || !WaitUntil([&] { return ran.load(); }, 500))
+        {
+            std::cout << "❌ Function task waited behind the compact backlog" << std::endl;
+            return 1;
+        }
+        auto nElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "✅ Function task ran after " << nElapsedMs << " ms" << std::endl;
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE);
+    }
+
+    // Test 4: cancelled compact tasks are reported and can still be run by the callback
+    {
+        std::cout << "\n--- Test 4: Cancel Pending ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<int> done{0};
+        std::vector<CYCompactTask> lstTask(5000, CYCompactTask{ &SleepTask, nullptr });
+        lstTask.push_back({ &CountTask, &done });
+        (void)pool->SubmitCompactTasks(lstTask.data(), lstTask.size());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        int nCancelled = 0;
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_CANCEL_PENDING, 0, [&](const CYThreadTask* pTask, ICYIThreadableObject*) {
+            if (pTask)
+            {
+                ++nCancelled;
+                if (pTask->pArgList == &done)
+                {
+                    pTask->funTaskToExecute(pTask->pArgList, false);
+                }
+            }
+        });
+
+        if (nCancelled == 0 || done.load() != 1)
+        {
+            std::cout << "❌ Cancelled " << nCancelled << ", counter " << done.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << nCancelled << " compact tasks reported as cancelled" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
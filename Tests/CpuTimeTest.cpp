@@ -0,0 +1,98 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+int main()
+{
+    std::cout << "=== CYThread CPU Time Test ===" << std::endl;
+
+    CYThreadFactory factory;
+
+    // Test 1: blocking tasks spend little of their wall time on a CPU
+    {
+        std::cout << "\n--- Test 1: CPU Time Ratio ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        CYThreadPoolOptions options;
+        options.bCpuTime = true;
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1, options);
+
+        std::mutex mutex;
+        CYThreadTask blocker;
+        blocker.funTaskToExecute = [&](void*, bool) {
+            std::lock_guard<std::mutex> lock(mutex);
+        };
+        CYThreadTask sleeper;
+        sleeper.funCancellableTaskToExecute = [](void*, const CYStopToken&) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); };
+        CYThreadTask spinner;
+        spinner.funTaskToExecute = [](void*, bool) {
+            volatile uint64_t nValue = 0;
+            for (int i = 0; i < 5'000'000; ++i)
+            {
+                nValue = nValue + i;
+            }
+        };
+
+        // The lock is held while the blocking task waits for it.
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            (void)pool->SubmitTask(blocker);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        for (int i = 0; i < 10; ++i)
+        {
+            (void)pool->SubmitTask(sleeper);
+            (void)pool->SubmitTask(spinner);
+        }
+        (void)WaitUntil([&] { return pool->GetMetrics().nCompleted == 21; }, 10000);
+        const auto lstStats = pool->GetPerfStats();
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        const CYTaskPerfStats* pBlocker = nullptr;
+        const CYTaskPerfStats* pSpinner = nullptr;
+        const CYTaskPerfStats* pSleeper = nullptr;
+        for (const auto& objStats : lstStats)
+        {
+            std::cout << objStats.nTaskCount << " x " << objStats.pszTaskType << ": cpu " << objStats.GetCounter(CYPerfCounter::PERF_COUNTER_CPU_TIME) / 1000
+                      << " us, wall " << objStats.GetCounter(CYPerfCounter::PERF_COUNTER_WALL_TIME) / 1000 << " us, ratio " << objStats.GetCpuRatio() << std::endl;
+            if (objStats.nTaskCount == 1)
+            {
+                pBlocker = &objStats;
+            }
+            else if (objStats.HasCounter(CYPerfCounter::PERF_COUNTER_CPU_TIME) && objStats.GetCpuRatio() > 0.2)
+            {
+                pSpinner = &objStats;
+            }
+            else
+            {
+                pSleeper = &objStats;
+            }
+        }
+
+        if (lstStats.size() != 3 || !pBlocker || !pSpinner || !pSleeper)
+        {
+            std::cout << "❌ Expected a blocking, a spinning and a sleeping task type" << std::endl;
+            return 1;
+        }
+        if (pBlocker->GetCpuRatio() > 0.2 || pSleeper->GetCpuRatio() > 0.2 || pSleeper->nTaskCount != 10 ||
+            pSpinner->HasCounter(CYPerfCounter::PERF_COUNTER_TASK_CLOCK))
+        {
+            std::cout << "❌ Blocking tasks were not told apart from computing ones" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Blocking tasks show a low CPU time ratio" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
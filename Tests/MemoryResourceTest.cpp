@@ -0,0 +1,153 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <memory_resource>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Forwards to the global heap and keeps track of what the pool takes from it.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::atomic<size_t> nAllocations{0};
+    std::atomic<size_t> nOutstanding{0};
+
+private:
+    void* do_allocate(std::size_t nBytes, std::size_t nAlign) override
+    {
+        void* pMemory = std::pmr::new_delete_resource()->allocate(nBytes, nAlign);
+        nAllocations.fetch_add(1, std::memory_order_relaxed);
+        nOutstanding.fetch_add(nBytes, std::memory_order_relaxed);
+        return pMemory;
+    }
+
+    void do_deallocate(void* pMemory, std::size_t nBytes, std::size_t nAlign) override
+    {
+        nOutstanding.fetch_sub(nBytes, std::memory_order_relaxed);
+        std::pmr::new_delete_resource()->deallocate(pMemory, nBytes, nAlign);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& objOther) const noexcept override
+    {
+        return this == &objOther;
+    }
+};
+
+int main()
+{
+    std::cout << "=== CYThread Memory Resource Test ===" << std::endl;
+
+    CountingResource objResource;
+    CYThreadFactory factory;
+
+    // Test 1: creating the pool takes its nodes from the resource
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    {
+        std::cout << "\n--- Test 1: Pool Creation ---" << std::endl;
+        CYThreadPoolOptions options;
+        options.pMemoryResource = &objResource;
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4, options);
+        if (objResource.nAllocations.load() == 0)
+        {
+            std::cout << "❌ Pool did not allocate from the resource" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << objResource.nAllocations.load() << " allocations from the resource" << std::endl;
+    }
+
+    // Test 2: timers go through the resource
+    {
+        std::cout << "\n--- Test 2: Timers ---" << std::endl;
+        const size_t nBefore = objResource.nAllocations.load();
+        std::atomic<int> fired{0};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { fired.fetch_add(1); };
+        for (int i = 0; i < 4; ++i)
+        {
+            (void)pool->SubmitAfter(std::chrono::milliseconds(5), task);
+        }
+        if (!WaitUntil([&] { return fired.load() == 4; }, 5000))
+        {
+            std::cout << "❌ Timers did not fire" << std::endl;
+            return 1;
+        }
+        if (objResource.nAllocations.load() == nBefore)
+        {
+            std::cout << "❌ Timer slab did not use the resource" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Timer slab allocated from the resource" << std::endl;
+    }
+
+    // Test 3: batches go through the resource
+    {
+        std::cout << "\n--- Test 3: Task Batches ---" << std::endl;
+        pool->SetTaskBatching(true, 1000);
+        const size_t nBefore = objResource.nAllocations.load();
+        std::atomic<int> done{0};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { done.fetch_add(1); };
+        int nSubmitted = 0;
+        for (int nRound = 0; nRound < 20; ++nRound)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                if (pool->SubmitTask(task))
+                {
+                    ++nSubmitted;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        if (!WaitUntil([&] { return done.load() == nSubmitted; }, 10000))
+        {
+            std::cout << "❌ Tasks did not finish" << std::endl;
+            return 1;
+        }
+        if (objResource.nAllocations.load() == nBefore)
+        {
+            std::cout << "❌ Batches did not use the resource" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << nSubmitted << " tasks ran, batches allocated from the resource" << std::endl;
+        pool->SetTaskBatching(false);
+    }
+
+    // Test 4: everything goes back to the resource
+    {
+        std::cout << "\n--- Test 4: Release ---" << std::endl;
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        pool.reset();
+        if (objResource.nOutstanding.load() != 0)
+        {
+            std::cout << "❌ " << objResource.nOutstanding.load() << " bytes not returned" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ All memory returned to the resource" << std::endl;
+    }
+
+    // Test 5: without a resource the pool leaves it alone
+    {
+        std::cout << "\n--- Test 5: Default Resource ---" << std::endl;
+        const size_t nBefore = objResource.nAllocations.load();
+        std::unique_ptr<ICYThreadPool> defaultPool(factory.CreateThreadPool());
+        defaultPool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+        (void)defaultPool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        if (objResource.nAllocations.load() != nBefore)
+        {
+            std::cout << "❌ Default pool used the resource" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Default pool uses the default resource" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Object task that counts its runs.
+class CountingTask : public ICYIThreadableObject
+{
+public:
+    std::atomic<int> m_runs{0};
+
+    void TaskToExecute() override
+    {
+        m_runs.fetch_add(1);
+    }
+};
+
+static std::atomic<int> g_nCompactRuns{0};
+
+static void CompactProc(void*)
+{
+    g_nCompactRuns.fetch_add(1);
+}
+
+int main()
+{
+    std::cout << "=== CYThread Metrics Test ===" << std::endl;
+
+    CYThreadFactory factory;
+
+    // Test 1: tasks queued behind a busy worker wait longer than they run
+    {
+        std::cout << "\n--- Test 1: Queue Wait And Execution Time ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> bRelease{false};
+        CYThreadTask blocker;
+        blocker.funTaskToExecute = [&](void*, bool) {
+            while (!bRelease.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        (void)pool->SubmitTask(blocker);
+        (void)WaitUntil([&] { return pool->GetMetrics().nStarted == 1; }, 5000);
+
+        CYThreadTask sleeper;
+        sleeper.funTaskToExecute = [](void*, bool) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); };
+        for (int i = 0; i < 10; ++i)
+        {
+            (void)pool->SubmitTask(sleeper);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const size_t nDepth = pool->GetMetrics().nQueueDepth;
+        bRelease.store(true);
+
+        (void)WaitUntil([&] { return pool->GetMetrics().nCompleted == 11; }, 5000);
+        const CYThreadPoolMetrics objMetrics = pool->GetMetrics();
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        std::cout << "submitted " << objMetrics.nSubmitted << ", started " << objMetrics.nStarted
+                  << ", completed " << objMetrics.nCompleted << ", depth while blocked " << nDepth << std::endl;
+        std::cout << "queue wait p50 " << objMetrics.objQueueWait.GetP50() / 1000 << " us, execution p50 "
+                  << objMetrics.objExecution.GetP50() / 1000 << " us" << std::endl;
+
+        if (objMetrics.nSubmitted != 11 || objMetrics.nStarted != 11 || objMetrics.nCompleted != 11 || nDepth != 10)
+        {
+            std::cout << "❌ Counters do not match the submitted tasks" << std::endl;
+            return 1;
+        }
+        if (objMetrics.objQueueWait.GetP50() < 40'000'000 || objMetrics.objExecution.GetP50() < 500'000 ||
+            objMetrics.objExecution.GetP50() > 40'000'000 || objMetrics.objExecution.GetMax() < 40'000'000)
+        {
+            std::cout << "❌ Histograms do not reflect the wait and the execution time" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Queue wait and execution time recorded" << std::endl;
+    }
+
+    // Test 2: an object submitted again while still queued is rejected
+    {
+        std::cout << "\n--- Test 2: Rejections ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> bRelease{false};
+        CYThreadTask blocker;
+        blocker.funTaskToExecute = [&](void*, bool) {
+            while (!bRelease.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        (void)pool->SubmitTask(blocker);
+        (void)WaitUntil([&] { return pool->GetMetrics().nStarted == 1; }, 5000);
+
+        CountingTask task;
+        const bool bFirst = pool->SubmitTask(&task);
+        const bool bSecond = pool->SubmitTask(&task);
+        bRelease.store(true);
+
+        (void)WaitUntil([&] { return pool->GetMetrics().nCompleted == 2; }, 5000);
+        const CYThreadPoolMetrics objMetrics = pool->GetMetrics();
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (!bFirst || bSecond || objMetrics.nRejected != 1 || objMetrics.nSubmitted != 2 || objMetrics.nCompleted != 2)
+        {
+            std::cout << "❌ Rejected " << objMetrics.nRejected << ", submitted " << objMetrics.nSubmitted << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Rejection counted" << std::endl;
+    }
+
+    // Test 3: compact tasks are counted without a queue wait
+    {
+        std::cout << "\n--- Test 3: Compact Tasks ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            (void)pool->SubmitCompactTask(&CompactProc, nullptr);
+        }
+        (void)WaitUntil([&] { return pool->GetMetrics().nCompleted == 1000; }, 5000);
+        const CYThreadPoolMetrics objMetrics = pool->GetMetrics();
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (g_nCompactRuns.load() != 1000 || objMetrics.nSubmitted != 1000 || objMetrics.nStarted != 1000 ||
+            objMetrics.nCompleted != 1000 || objMetrics.objQueueWait.GetCount() != 0 || objMetrics.objExecution.GetCount() != 1000)
+        {
+            std::cout << "❌ Compact tasks: started " << objMetrics.nStarted << ", completed " << objMetrics.nCompleted << std::endl;
+            return 1;
+        }
+        std::cout << "✅ 1000 compact tasks counted" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+class CountingObject : public ICYIThreadableObject
+{
+public:
+    void TaskToExecute() override
+    {
+        runs.fetch_add(1);
+    }
+
+    std::atomic<int> runs{0};
+};
+
+// Keep the only worker of a pool busy until the flag is set.
+static bool BlockWorker(ICYThreadPool* pPool, std::atomic<bool>& started, std::atomic<bool>& release)
+{
+    CYThreadTask task;
+    task.funTaskToExecute = [&](void*, bool) {
+        started.store(true);
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    return pPool->SubmitTask(task) && WaitUntil([&] { return started.load(); }, 5000);
+}
+
+int main()
+{
+    std::cout << "=== CYThread Object Queue Test ===" << std::endl;
+
+    CYThreadFactory factory;
+
+    // Test 1: a queued object cannot be queued twice, once dispatched it can be submitted again
+    {
+        std::cout << "\n--- Test 1: Queued Once ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        CountingObject object;
+        if (!BlockWorker(pool.get(), started, release))
+        {
+            std::cout << "❌ Worker did not start" << std::endl;
+            return 1;
+        }
+
+        const bool bFirst = pool->SubmitTask(&object);
+        const bool bSecond = pool->SubmitTask(&object);
+        release.store(true);
+
+        if (!bFirst || bSecond)
+        {
+            std::cout << "❌ Submissions returned " << bFirst << ", " << bSecond << std::endl;
+            return 1;
+        }
+        if (!WaitUntil([&] { return object.runs.load() == 1; }, 5000) ||
+            !pool->SubmitTask(&object) ||
+            !WaitUntil([&] { return object.runs.load() == 2; }, 5000))
+        {
+            std::cout << "❌ Object ran " << object.runs.load() << " times" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Duplicate refused while queued, accepted again after dispatch" << std::endl;
+    }
+
+    // Test 2: dropping a queued object releases its links
+    {
+        std::cout << "\n--- Test 2: Dropped Object ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        CountingObject object;
+        if (!BlockWorker(pool.get(), started, release) || !pool->SubmitTask(&object))
+        {
+            std::cout << "❌ Object was not queued" << std::endl;
+            return 1;
+        }
+
+        pool->TerminateWorkingThread(&object);
+        const bool bRequeued = pool->SubmitTask(&object);
+        release.store(true);
+
+        if (!bRequeued || !WaitUntil([&] { return object.runs.load() == 1; }, 5000))
+        {
+            std::cout << "❌ Dropped object could not be queued again" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ TerminateWorkingThread unlinks the queued object" << std::endl;
+    }
+
+    // Test 3: a cancelled object may move to another pool from the callback
+    {
+        std::cout << "\n--- Test 3: Cancelled Then Resubmitted ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        std::unique_ptr<ICYThreadPool> other(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+        other->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        std::vector<std::unique_ptr<CountingObject>> lstObject;
+        for (int i = 0; i < 10; ++i)
+        {
+            lstObject.push_back(std::make_unique<CountingObject>());
+        }
+
+        if (!BlockWorker(pool.get(), started, release))
+        {
+            std::cout << "❌ Worker did not start" << std::endl;
+            return 1;
+        }
+        for (auto& ptrObject : lstObject)
+        {
+            (void)pool->SubmitTask(ptrObject.get());
+        }
+
+        std::atomic<int> moved{0};
+        std::thread releaser([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            release.store(true);
+        });
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_CANCEL_PENDING, 0,
+            [&](const CYThreadTask*, ICYIThreadableObject* pObject) {
+                if (pObject && other->SubmitTask(pObject))
+                {
+                    moved.fetch_add(1);
+                }
+            });
+        releaser.join();
+
+        const bool bAllRan = WaitUntil([&] {
+            for (auto& ptrObject : lstObject)
+            {
+                if (ptrObject->runs.load() != 1)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }, 5000);
+
+        if (moved.load() != 10 || !bAllRan)
+        {
+            std::cout << "❌ Moved " << moved.load() << " objects" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ All cancelled objects ran on the second pool" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+
+using namespace cry;
+
+int main()
+{
+    std::cout << "=== CYThread Parallel Region Test ===" << std::endl;
+
+    const int nWorkers = 4;
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, nWorkers);
+
+    // Test 1: the kernel runs once on every worker
+    {
+        std::cout << "\n--- Test 1: One Kernel Per Worker ---" << std::endl;
+        std::vector<std::atomic<int>> lstCalls(nWorkers);
+        std::atomic<int> wrongCount{0};
+        bool bRan = pool->RunOnAllWorkers([&](int nWorkerIndex, int nWorkerCount, CYBarrier&) {
+            if (nWorkerCount != nWorkers || pool->GetCurrentWorkerIndex() != nWorkerIndex)
+            {
+                wrongCount.fetch_add(1);
+            }
+            lstCalls[nWorkerIndex].fetch_add(1);
+        });
+
+        for (auto& calls : lstCalls)
+        {
+            if (!bRan || calls.load() != 1 || wrongCount.load() != 0)
+            {
+                std::cout << "❌ Kernel did not run exactly once per worker" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "✅ Kernel ran once on each of the " << nWorkers << " workers" << std::endl;
+    }
+
+    // Test 2: phases separated by the barrier see each other's results
+    {
+        std::cout << "\n--- Test 2: Phase-Synchronized Stencil ---" << std::endl;
+        const int nPhases = 1000;
+        std::vector<long long> lstCurrent(nWorkers, 1);
+        std::vector<long long> lstNext(nWorkers, 0);
+        std::atomic<int> mismatches{0};
+
+        auto start = std::chrono::steady_clock::now();
+        bool bRan = pool->RunOnAllWorkers([&](int nWorkerIndex, int nWorkerCount, CYBarrier& objBarrier) {
+            for (int nPhase = 0; nPhase < nPhases; ++nPhase)
+            {
+                // Every cell becomes the sum of itself and its right neighbour
+                lstNext[nWorkerIndex] = (lstCurrent[nWorkerIndex] + lstCurrent[(nWorkerIndex + 1) % nWorkerCount]) % 1000003;
+                objBarrier.ArriveAndWait();
+
+                if (nWorkerIndex == 0)
+                {
+                    lstCurrent.swap(lstNext);
+                }
+                objBarrier.ArriveAndWait();
+            }
+        });
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        // Same computation sequentially
+        std::vector<long long> lstExpected(nWorkers, 1);
+        for (int nPhase = 0; nPhase < nPhases; ++nPhase)
+        {
+            std::vector<long long> lstStep(nWorkers);
+            for (int i = 0; i < nWorkers; ++i)
+            {
+                lstStep[i] = (lstExpected[i] + lstExpected[(i + 1) % nWorkers]) % 1000003;
+            }
+            lstExpected.swap(lstStep);
+        }
+
+        for (int i = 0; i < nWorkers; ++i)
+        {
+            if (lstCurrent[i] != lstExpected[i])
+            {
+                mismatches.fetch_add(1);
+            }
+        }
+
+        std::cout << nPhases << " phases took " << us.count() << " us" << std::endl;
+        if (!bRan || mismatches.load() != 0)
+        {
+            std::cout << "❌ Parallel result differs from the sequential one" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Barrier kept all phases in lockstep" << std::endl;
+    }
+
+    // Test 3: a worker cannot open a region on its own pool
+    {
+        std::cout << "\n--- Test 3: Nested Region Refused ---" << std::endl;
+        std::atomic<int> nested{0};
+        (void)pool->RunOnAllWorkers([&](int nWorkerIndex, int, CYBarrier&) {
+            if (nWorkerIndex == 0 && !pool->RunOnAllWorkers([](int, int, CYBarrier&) {}))
+            {
+                nested.store(1);
+            }
+        });
+
+        if (nested.load() != 1)
+        {
+            std::cout << "❌ Nested region was not refused" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Nested region refused instead of deadlocking" << std::endl;
+    }
+
+    // Test 4: a kernel exception reaches the caller after every worker returned
+    {
+        std::cout << "\n--- Test 4: Kernel Exception ---" << std::endl;
+        std::atomic<int> calls{0};
+        bool bThrown = false;
+        try
+        {
+            (void)pool->RunOnAllWorkers([&](int nWorkerIndex, int, CYBarrier&) {
+                calls.fetch_add(1);
+                if (nWorkerIndex == 1)
+                {
+                    throw std::runtime_error("kernel failed");
+                }
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            bThrown = true;
+        }
+
+        if (!bThrown || calls.load() != nWorkers)
+        {
+            std::cout << "❌ Kernel exception was not rethrown to the caller" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Kernel exception rethrown after the region finished" << std::endl;
+    }
+
+    // Test 5: Shutdown never cancels the tasks of a running region
+    {
+        std::cout << "\n--- Test 5: Shutdown During Region ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> regionPool(factory.CreateThreadPool());
+        regionPool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+        // Worker 1 is busy, so its region task is still queued when Shutdown starts.
+        std::atomic<bool> busy{false};
+        CYThreadTask objBlocker;
+        objBlocker.funTaskToExecute = [&](void*, bool) {
+            busy.store(true);
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        };
+        (void)regionPool->SubmitToWorker(1, objBlocker);
+        while (!busy.load())
+        {
+            std::this_thread::yield();
+        }
+
+        std::atomic<int> calls{0};
+        std::atomic<bool> bRan{false};
+        std::thread objRegion([&] {
+            bRan.store(regionPool->RunOnAllWorkers([&](int, int, CYBarrier& objBarrier) {
+                objBarrier.ArriveAndWait();
+                calls.fetch_add(1);
+            }));
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        int nReported = 0;
+        (void)regionPool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_CANCEL_PENDING, 0,
+            [&](const CYThreadTask*, ICYIThreadableObject*) { ++nReported; });
+        objRegion.join();
+
+        if (!bRan.load() || calls.load() != 2 || nReported != 0)
+        {
+            std::cout << "❌ Shutdown cancelled region tasks" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Region finished before the workers stopped" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Object task that walks a buffer much larger than the caches.
+class StreamTask : public ICYIThreadableObject
+{
+public:
+    std::vector<uint64_t> m_buffer = std::vector<uint64_t>(4 * 1024 * 1024, 1);
+    std::atomic<uint64_t> m_sum{0};
+
+    void TaskToExecute() override
+    {
+        uint64_t nSum = 0;
+        for (size_t i = 0; i < m_buffer.size(); i += 8)
+        {
+            nSum += m_buffer[i];
+        }
+        m_sum.fetch_add(nSum);
+    }
+};
+
+static const CYTaskPerfStats* FindStats(const std::vector<CYTaskPerfStats>& lstStats, uint64_t nTaskCount)
+{
+    for (const auto& objStats : lstStats)
+    {
+        if (objStats.nTaskCount == nTaskCount)
+        {
+            return &objStats;
+        }
+    }
+    return nullptr;
+}
+
+int main()
+{
+    std::cout << "=== CYThread Performance Counter Test ===" << std::endl;
+
+    CYThreadFactory factory;
+
+    // Test 1: counters are summed per task type
+    {
+        std::cout << "\n--- Test 1: Counters Per Task Type ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        CYThreadPoolOptions options;
+        options.bPerfCounters = true;
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2, options);
+
+        CYThreadTask sleeper;
+        sleeper.funTaskToExecute = [](void*, bool) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); };
+        CYThreadTask spinner;
+        spinner.funCancellableTaskToExecute = [](void*, const CYStopToken&) {
+            volatile uint64_t nValue = 0;
+            for (int i = 0; i < 2'000'000; ++i)
+            {
+                nValue = nValue + i;
+            }
+        };
+        StreamTask stream;
+
+        for (int i = 0; i < 20; ++i)
+        {
+            while (!pool->SubmitTask(sleeper))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        for (int i = 0; i < 10; ++i)
+        {
+            while (!pool->SubmitTask(spinner))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            (void)WaitUntil([&] { return pool->SubmitTask(&stream); }, 5000);
+        }
+        (void)WaitUntil([&] { return pool->GetMetrics().nCompleted == 35; }, 10000);
+        const auto lstStats = pool->GetPerfStats();
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (lstStats.empty())
+        {
+            std::cout << "⚠️ No counters could be opened on this system, skipped" << std::endl;
+        }
+        else
+        {
+            for (const auto& objStats : lstStats)
+            {
+                std::cout << objStats.nTaskCount << " x " << objStats.pszTaskType << ": mask " << objStats.nCounterMask
+                          << ", cycles " << objStats.GetCounter(CYPerfCounter::PERF_COUNTER_CYCLES)
+                          << ", cache misses " << objStats.GetCounter(CYPerfCounter::PERF_COUNTER_CACHE_MISSES)
+                          << ", context switches " << objStats.GetCounter(CYPerfCounter::PERF_COUNTER_CONTEXT_SWITCHES)
+                          << ", task clock " << objStats.GetCounter(CYPerfCounter::PERF_COUNTER_TASK_CLOCK) << " ns" << std::endl;
+            }
+
+            auto pSleeper = FindStats(lstStats, 20);
+            auto pSpinner = FindStats(lstStats, 10);
+            auto pStream = FindStats(lstStats, 5);
+            if (lstStats.size() != 3 || !pSleeper || !pSpinner || !pStream || !pStream->pszTaskType)
+            {
+                std::cout << "❌ Expected three task types with 20, 10 and 5 tasks" << std::endl;
+                return 1;
+            }
+            if (pSleeper->HasCounter(CYPerfCounter::PERF_COUNTER_CONTEXT_SWITCHES) &&
+                pSleeper->GetCounter(CYPerfCounter::PERF_COUNTER_CONTEXT_SWITCHES) < 20)
+            {
+                std::cout << "❌ Sleeping tasks did not switch context" << std::endl;
+                return 1;
+            }
+            if (pSleeper->HasCounter(CYPerfCounter::PERF_COUNTER_TASK_CLOCK) &&
+                pSpinner->GetCounter(CYPerfCounter::PERF_COUNTER_TASK_CLOCK) / 10 <= pSleeper->GetCounter(CYPerfCounter::PERF_COUNTER_TASK_CLOCK) / 20)
+            {
+                std::cout << "❌ Spinning tasks should spend more CPU time than sleeping ones" << std::endl;
+                return 1;
+            }
+            std::cout << "✅ Counters summed per task type" << std::endl;
+        }
+    }
+
+    // Test 2: a pool without counters reports nothing
+    {
+        std::cout << "\n--- Test 2: Counters Off ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+        CYThreadTask task;
+        task.funTaskToExecute = [](void*, bool) {};
+        (void)pool->SubmitTask(task);
+        (void)WaitUntil([&] { return pool->GetMetrics().nCompleted == 1; }, 5000);
+        const bool bEmpty = pool->GetPerfStats().empty();
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (!bEmpty)
+        {
+            std::cout << "❌ Counters reported without sampling" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ No counters without sampling" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
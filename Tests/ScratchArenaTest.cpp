@@ -0,0 +1,133 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Run a task on worker 0 and wait for it, returns the arena usage it saw on entry.
+static bool RunOnFirstWorker(ICYThreadPool* pPool, size_t nAllocate, size_t& nUsedOnEntry)
+{
+    std::atomic<bool> done{false};
+    CYThreadTask task;
+    task.funTaskToExecute = [&](void*, bool) {
+        auto pArena = CYScratchArena::GetCurrent();
+        nUsedOnEntry = pArena ? pArena->GetUsed() : SIZE_MAX;
+        if (pArena && nAllocate)
+        {
+            std::memset(pArena->Allocate(nAllocate), 0xAB, nAllocate);
+        }
+        done.store(true);
+    };
+    while (!pPool->SubmitToWorker(0, task))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return WaitUntil([&] { return done.load(); }, 5000);
+}
+
+int main()
+{
+    std::cout << "=== CYThread Scratch Arena Test ===" << std::endl;
+
+    // Test 1: bump allocation, alignment, rewind and block merging
+    {
+        std::cout << "\n--- Test 1: Arena Basics ---" << std::endl;
+        CYScratchArena arena(256);
+        auto pByte = arena.AllocateArray<char>(3);
+        auto pWide = arena.AllocateArray<double>(4);
+        auto pAligned = arena.Allocate(16, 64);
+        if (!pByte || !pWide || !pAligned ||
+            reinterpret_cast<uintptr_t>(pWide) % alignof(double) != 0 ||
+            reinterpret_cast<uintptr_t>(pAligned) % 64 != 0)
+        {
+            std::cout << "❌ Misaligned or failed allocation" << std::endl;
+            return 1;
+        }
+
+        const CYScratchMark mark = arena.GetMark();
+        const size_t nUsed = arena.GetUsed();
+        (void)arena.Allocate(1000);
+        (void)arena.Allocate(1000);
+        arena.Rewind(mark);
+        if (arena.GetUsed() != nUsed)
+        {
+            std::cout << "❌ Rewind left " << arena.GetUsed() << " bytes, expected " << nUsed << std::endl;
+            return 1;
+        }
+
+        (void)arena.Allocate(1000);
+        const size_t nCapacity = arena.GetCapacity();
+        arena.Reset();
+        (void)arena.Allocate(nCapacity - 64, 1);
+        (void)arena.Allocate(32, 1);
+        if (arena.GetUsed() != nCapacity - 32 || arena.GetCapacity() != nCapacity)
+        {
+            std::cout << "❌ Reset did not merge the blocks into one" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Aligned bump allocation, rewind and merge on reset" << std::endl;
+    }
+
+    CYThreadFactory factory;
+
+    // Test 2: each task starts with an empty arena
+    {
+        std::cout << "\n--- Test 2: Reset Per Task ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+        if (CYScratchArena::GetCurrent() != nullptr)
+        {
+            std::cout << "❌ The main thread has an arena" << std::endl;
+            return 1;
+        }
+
+        size_t nFirst = SIZE_MAX;
+        size_t nSecond = SIZE_MAX;
+        if (!RunOnFirstWorker(pool.get(), 4096, nFirst) || !RunOnFirstWorker(pool.get(), 0, nSecond))
+        {
+            std::cout << "❌ Tasks did not finish" << std::endl;
+            return 1;
+        }
+        if (nFirst != 0 || nSecond != 0)
+        {
+            std::cout << "❌ Task saw " << nSecond << " bytes left by the previous task" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Worker arena is reset after every task" << std::endl;
+    }
+
+    // Test 3: per-frame mode keeps memory until the frame advances
+    {
+        std::cout << "\n--- Test 3: Reset Per Frame ---" << std::endl;
+        CYThreadPoolOptions options;
+        options.eScratchResetMode = CYArenaResetMode::RESET_PER_FRAME;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2, options);
+
+        size_t nFirst = SIZE_MAX;
+        size_t nSameFrame = SIZE_MAX;
+        size_t nNextFrame = SIZE_MAX;
+        bool bOk = RunOnFirstWorker(pool.get(), 512, nFirst) && RunOnFirstWorker(pool.get(), 0, nSameFrame);
+        pool->AdvanceScratchFrame();
+        bOk = bOk && RunOnFirstWorker(pool.get(), 0, nNextFrame);
+
+        if (!bOk || nFirst != 0 || nSameFrame < 512 || nNextFrame != 0)
+        {
+            std::cout << "❌ Usage per task was " << nFirst << ", " << nSameFrame << ", " << nNextFrame << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Arena survives tasks of a frame and is reset by the next frame" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+
+using namespace cry;
+
+static std::atomic<int> s_executed{0};
+static std::atomic<int> s_cancelled{0};
+
+// Submit nCount function tasks that sleep for nSleepMs each
+static bool SubmitSleepingTasks(ICYThreadPool* pPool, int nCount, int nSleepMs)
+{
+    for (int i = 0; i < nCount; ++i)
+    {
+        CYThreadTask task;
+        task.funTaskToExecute = [nSleepMs](void*, bool) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(nSleepMs));
+            s_executed.fetch_add(1);
+        };
+        if (!pPool->SubmitTask(task))
+        {
+            std::cout << "❌ Failed to submit task " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void Reset()
+{
+    s_executed.store(0);
+    s_cancelled.store(0);
+}
+
+int main()
+{
+    std::cout << "=== CYThread Shutdown Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    auto funOnCancelled = [](const CYThreadTask* pTask, ICYIThreadableObject* pObject) {
+        if (pTask || pObject)
+        {
+            s_cancelled.fetch_add(1);
+        }
+    };
+
+    // Test 1: drain finishes every queued task
+    {
+        std::cout << "\n--- Test 1: Drain ---" << std::endl;
+        Reset();
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+        if (!SubmitSleepingTasks(pool.get(), 20, 20)) return 1;
+
+        auto start = std::chrono::steady_clock::now();
+        bool drained = pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Executed " << s_executed.load() << "/20 in " << ms.count() << " ms" << std::endl;
+        if (!drained || s_executed.load() != 20)
+        {
+            std::cout << "❌ Drain lost work" << std::endl;
+            return 1;
+        }
+        if (pool->SubmitTask(CYThreadTask{}))
+        {
+            std::cout << "❌ Pool accepted a task after shutdown" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Drain executed every task" << std::endl;
+    }
+
+    // Test 2: cancel pending reports every dropped task
+    {
+        std::cout << "\n--- Test 2: Cancel Pending ---" << std::endl;
+        Reset();
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+        if (!SubmitSleepingTasks(pool.get(), 12, 100)) return 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_CANCEL_PENDING, 0, funOnCancelled);
+
+        std::cout << "Executed " << s_executed.load() << ", cancelled " << s_cancelled.load() << std::endl;
+        if (s_executed.load() + s_cancelled.load() != 12 || s_cancelled.load() == 0)
+        {
+            std::cout << "❌ Cancelled tasks were not all reported" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Every pending task was reported" << std::endl;
+    }
+
+    // Test 3: drain with a deadline cancels what is left
+    {
+        std::cout << "\n--- Test 3: Drain Deadline ---" << std::endl;
+        Reset();
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+        if (!SubmitSleepingTasks(pool.get(), 12, 50)) return 1;
+
+        bool drained = pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN_DEADLINE, 120, funOnCancelled);
+
+        std::cout << "Executed " << s_executed.load() << ", cancelled " << s_cancelled.load() << std::endl;
+        if (drained || s_executed.load() + s_cancelled.load() != 12)
+        {
+            std::cout << "❌ Deadline drain did not account for every task" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Deadline drain executed or cancelled every task" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
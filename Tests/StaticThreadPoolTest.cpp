@@ -0,0 +1,200 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <new>
+#include <cstdlib>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYStaticThreadPool.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Counts heap allocations made while tracking is on.
+static std::atomic<bool> s_bTrack{false};
+static std::atomic<size_t> s_nAllocations{0};
+
+void* operator new(std::size_t nBytes)
+{
+    if (s_bTrack.load(std::memory_order_relaxed))
+    {
+        s_nAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* pMemory = std::malloc(nBytes ? nBytes : 1))
+    {
+        return pMemory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+    std::free(pMemory);
+}
+
+int main()
+{
+    std::cout << "=== CYThread Static Thread Pool Test ===" << std::endl;
+
+    // Test 1: submitting and running tasks does not allocate
+    {
+        std::cout << "\n--- Test 1: No Allocation ---" << std::endl;
+        CYStaticThreadPool<4, 256, 32> pool;
+
+        std::atomic<int> done{0};
+        const int nTasks = 100000;
+        int nSubmitted = 0;
+        s_bTrack.store(true);
+        while (nSubmitted < nTasks)
+        {
+            if (pool.SubmitTask([&done] { done.fetch_add(1, std::memory_order_relaxed); }))
+            {
+                ++nSubmitted;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        while (done.load() != nTasks)
+        {
+            std::this_thread::yield();
+        }
+        s_bTrack.store(false);
+
+        if (s_nAllocations.load() != 0)
+        {
+            std::cout << "❌ " << s_nAllocations.load() << " allocations after construction" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << nTasks << " tasks executed without allocating" << std::endl;
+    }
+
+    // Test 2: a full ring rejects tasks, the ring runs in FIFO order
+    {
+        std::cout << "\n--- Test 2: Capacity ---" << std::endl;
+        CYStaticThreadPool<1, 8> pool;
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        (void)pool.SubmitTask([&] {
+            started.store(true);
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        if (!WaitUntil([&] { return started.load(); }, 5000))
+        {
+            std::cout << "❌ Worker did not start" << std::endl;
+            return 1;
+        }
+
+        std::mutex mutex;
+        std::vector<int> order;
+        int nAccepted = 0;
+        for (int i = 0; i < 12; ++i)
+        {
+            nAccepted += pool.SubmitTask([&, i] {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+            }) ? 1 : 0;
+        }
+        const size_t nPending = pool.GetPendingTaskCount();
+        release.store(true);
+        (void)pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (nAccepted != 8 || nPending != 8 || order != std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 })
+        {
+            std::cout << "❌ Accepted " << nAccepted << ", executed " << order.size() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Ring full after 8 tasks, drained in order" << std::endl;
+    }
+
+    // Test 3: immediate shutdown destroys queued tasks without running them
+    {
+        std::cout << "\n--- Test 3: Immediate Shutdown ---" << std::endl;
+        std::atomic<int> done{0};
+        std::atomic<int> destroyed{0};
+
+        struct Tracked
+        {
+            std::atomic<int>* pDone;
+            std::atomic<int>* pDestroyed;
+            bool bOwner{ true };
+
+            Tracked(std::atomic<int>* pRun, std::atomic<int>* pGone) noexcept : pDone(pRun), pDestroyed(pGone) {}
+            Tracked(Tracked&& objOther) noexcept : pDone(objOther.pDone), pDestroyed(objOther.pDestroyed) { objOther.bOwner = false; }
+            ~Tracked()
+            {
+                if (bOwner)
+                {
+                    pDestroyed->fetch_add(1);
+                }
+            }
+            void operator()()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                pDone->fetch_add(1);
+            }
+        };
+
+        {
+            CYStaticThreadPool<2, 64, sizeof(Tracked)> pool;
+            for (int i = 0; i < 64; ++i)
+            {
+                (void)pool.SubmitTask(Tracked(&done, &destroyed));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            (void)pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_IMMEDIATE);
+            if (pool.SubmitTask([] {}))
+            {
+                std::cout << "❌ Stopped pool accepted a task" << std::endl;
+                return 1;
+            }
+        }
+
+        if (done.load() >= 64 || destroyed.load() != 64)
+        {
+            std::cout << "❌ Ran " << done.load() << ", destroyed " << destroyed.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << 64 - done.load() << " queued tasks dropped, every task destroyed once" << std::endl;
+    }
+
+    // Test 4: a worker may shut its own pool down
+    {
+        std::cout << "\n--- Test 4: Shutdown From A Worker ---" << std::endl;
+        std::atomic<int> nResult{-1};
+        {
+            CYStaticThreadPool<2, 8> pool;
+            (void)pool.SubmitTask([&] { nResult.store(pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN) ? 1 : 0); });
+            auto start = std::chrono::steady_clock::now();
+            while (nResult.load() < 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            // The destructor joins the worker that stopped the pool.
+        }
+
+        if (nResult.load() != 1)
+        {
+            std::cout << "❌ Shutdown from a worker returned " << nResult.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Worker stopped its own pool, the owner joined it" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
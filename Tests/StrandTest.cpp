@@ -0,0 +1,216 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "../Inc/CYThread/CYStrand.hpp"
+
+using namespace cry;
+
+int main()
+{
+    std::cout << "=== CYThread Strand Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+
+    // Test 1: tasks of one strand never overlap and keep their order
+    {
+        std::cout << "\n--- Test 1: Serialized In-Order Execution ---" << std::endl;
+        const int nTasks = 2000;
+        CYStrand strand(pool.get());
+        std::atomic<int> running{0};
+        std::atomic<bool> overlapped{false};
+        std::vector<int> lstOrder;
+        lstOrder.reserve(nTasks);
+
+        // Several producers, each with its own increasing sequence
+        std::vector<std::thread> lstProducer;
+        for (int p = 0; p < 4; ++p)
+        {
+            lstProducer.emplace_back([&, p] {
+                for (int i = 0; i < nTasks / 4; ++i)
+                {
+                    CYThreadTask task;
+                    task.funTaskToExecute = [&, p, i](void*, bool) {
+                        if (running.fetch_add(1) != 0)
+                        {
+                            overlapped.store(true);
+                        }
+                        lstOrder.push_back(p * nTasks + i);
+                        running.fetch_sub(1);
+                    };
+                    while (!strand.SubmitTask(task))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& objProducer : lstProducer)
+        {
+            objProducer.join();
+        }
+
+        if (strand.Wait(10000) != 0)
+        {
+            std::cout << "❌ Strand did not drain" << std::endl;
+            return 1;
+        }
+
+        std::vector<int> lstLast(4, -1);
+        bool bOrdered = lstOrder.size() == static_cast<size_t>(nTasks);
+        for (int nValue : lstOrder)
+        {
+            int p = nValue / nTasks;
+            int i = nValue % nTasks;
+            bOrdered = bOrdered && i == lstLast[p] + 1;
+            lstLast[p] = i;
+        }
+
+        if (overlapped.load() || !bOrdered)
+        {
+            std::cout << "❌ Overlapped " << overlapped.load() << ", executed " << lstOrder.size() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << nTasks << " strand tasks ran one at a time in order" << std::endl;
+    }
+
+    // Test 2: different strands run in parallel
+    {
+        std::cout << "\n--- Test 2: Parallel Strands ---" << std::endl;
+        CYStrand strandA(pool.get());
+        CYStrand strandB(pool.get());
+        std::atomic<int> running{0};
+        std::atomic<int> maxRunning{0};
+        auto makeTask = [&] {
+            CYThreadTask task;
+            task.funTaskToExecute = [&](void*, bool) {
+                int nNow = running.fetch_add(1) + 1;
+                int nMax = maxRunning.load();
+                while (nNow > nMax && !maxRunning.compare_exchange_weak(nMax, nNow)) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                running.fetch_sub(1);
+            };
+            return task;
+        };
+
+        for (int i = 0; i < 5; ++i)
+        {
+            (void)strandA.SubmitTask(makeTask());
+            (void)strandB.SubmitTask(makeTask());
+        }
+        (void)strandA.Wait();
+        (void)strandB.Wait();
+
+        if (maxRunning.load() != 2)
+        {
+            std::cout << "❌ Max concurrency was " << maxRunning.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Two strands ran side by side, each serialized" << std::endl;
+    }
+
+    // Test 3: a throwing task does not stop the strand
+    {
+        std::cout << "\n--- Test 3: Throwing Task ---" << std::endl;
+        CYStrand strand(pool.get());
+        std::atomic<int> nRan{0};
+        for (int i = 0; i < 10; ++i)
+        {
+            CYThreadTask task;
+            task.funTaskToExecute = [&, i](void*, bool) {
+                nRan.fetch_add(1);
+                if (i % 3 == 0)
+                {
+                    throw std::runtime_error("strand task failed");
+                }
+            };
+            (void)strand.SubmitTask(task);
+        }
+
+        if (strand.Wait(5000) != 0 || nRan.load() != 10)
+        {
+            std::cout << "❌ Only " << nRan.load() << " of 10 tasks ran" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Tasks behind the throwing ones still ran" << std::endl;
+    }
+
+    // Test 4: tasks refused by a stopped pool are kept and run by Wait
+    {
+        std::cout << "\n--- Test 4: Refused Runner Keeps The Queue ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> stopped(factory.CreateThreadPool());
+        stopped->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+        (void)stopped->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        CYStrand strand(stopped.get());
+        std::vector<int> lstOrder;
+        bool bAccepted = true;
+        for (int i = 0; i < 5; ++i)
+        {
+            CYThreadTask task;
+            task.funTaskToExecute = [&, i](void*, bool) { lstOrder.push_back(i); };
+            bAccepted = strand.SubmitTask(task) && bAccepted;
+        }
+        const bool bDeferred = strand.IsRunnerDeferred();
+        const uint32_t nWaitResult = strand.Wait(5000);
+
+        if (!bAccepted || !bDeferred || strand.IsRunnerDeferred() || nWaitResult != 0 || lstOrder != std::vector<int>{ 0, 1, 2, 3, 4 })
+        {
+            std::cout << "❌ Refused tasks were lost or reordered, " << lstOrder.size() << " ran" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Refused tasks ran in order on the waiting thread" << std::endl;
+    }
+
+    // Test 5: a runner dropped by CancelTag does not lose the strand's tasks
+    {
+        std::cout << "\n--- Test 5: Dropped Runner ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> single(factory.CreateThreadPool());
+        single->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> bRelease{false};
+        CYThreadTask blocker;
+        blocker.funTaskToExecute = [&](void*, bool) {
+            while (!bRelease.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        (void)single->SubmitTask(blocker);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        const CYTaskTag nTag = 42;
+        CYStrand strand(single.get());
+        std::atomic<int> nRan{0};
+        for (int i = 0; i < 3; ++i)
+        {
+            CYThreadTask task;
+            task.nTag = nTag;
+            task.funTaskToExecute = [&](void*, bool) { nRan.fetch_add(1); };
+            (void)strand.SubmitTask(task);
+        }
+        const size_t nDropped = single->CancelTag(nTag);
+        bRelease.store(true);
+        const uint32_t nWaitResult = strand.Wait(5000);
+        (void)single->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (nDropped != 1 || nWaitResult != 0 || nRan.load() != 3)
+        {
+            std::cout << "❌ Dropped " << nDropped << " runners, " << nRan.load() << " of 3 tasks ran" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Tasks behind the dropped runner still ran" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,318 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "../Inc/CYThread/CYTaskTag.hpp"
+#include "../Inc/CYThread/CYTaskScope.hpp"
+#include "../Inc/CYThread/CYStrand.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+static CYTaskTagStats FindStats(const ICYThreadPool& pool, CYTaskTag nTag)
+{
+    for (const auto& objStats : pool.GetTagStats())
+    {
+        if (objStats.nTag == nTag)
+        {
+            return objStats;
+        }
+    }
+    return {};
+}
+
+// Object task that reports a tag of its own.
+class TaggedTask : public ICYIThreadableObject
+{
+public:
+    explicit TaggedTask(CYTaskTag nTag) : m_nTag(nTag) {}
+
+    std::atomic<int> m_runs{0};
+
+    void TaskToExecute() override
+    {
+        m_runs.fetch_add(1);
+    }
+
+    CYTaskTag GetTag() const override
+    {
+        return m_nTag;
+    }
+
+private:
+    CYTaskTag m_nTag;
+};
+
+int main()
+{
+    std::cout << "=== CYThread Task Tag Test ===" << std::endl;
+
+    CYThreadFactory factory;
+
+    // Test 1: interned names map to stable tags
+    {
+        std::cout << "\n--- Test 1: Interned Names ---" << std::endl;
+        const CYTaskTag nRender = CYTaskTagRegistry::Intern("render");
+        const CYTaskTag nAudio = CYTaskTagRegistry::Intern("audio");
+        const char* pszName = CYTaskTagRegistry::GetName(nRender);
+
+        if (nRender == CYTHREAD_NO_TAG || nRender == nAudio || CYTaskTagRegistry::Intern("render") != nRender ||
+            !pszName || std::strcmp(pszName, "render") != 0 || CYTaskTagRegistry::GetName(7) != nullptr ||
+            CYTaskTagRegistry::Intern("") != CYTHREAD_NO_TAG)
+        {
+            std::cout << "❌ Interning does not round-trip" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ \"" << pszName << "\" interned as 0x" << std::hex << nRender << std::dec << std::endl;
+    }
+
+    // Test 2: counts, queue wait and CPU time are kept per tag
+    {
+        std::cout << "\n--- Test 2: Per-Tag Statistics ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        CYThreadPoolOptions options;
+        options.bCpuTime = true;
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1, options);
+
+        const CYTaskTag nCompute = CYTaskTagRegistry::Intern("compute");
+        const CYTaskTag nIo = 7;
+
+        std::atomic<bool> bRelease{false};
+        CYThreadTask blocker;
+        blocker.funTaskToExecute = [&](void*, bool) {
+            while (!bRelease.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        (void)pool->SubmitTask(blocker);
+        (void)WaitUntil([&] { return pool->GetMetrics().nStarted == 1; }, 5000);
+
+        CYThreadTask spinner;
+        spinner.nTag = nCompute;
+        spinner.funTaskToExecute = [](void*, bool) {
+            volatile uint64_t nValue = 0;
+            for (int i = 0; i < 5'000'000; ++i)
+            {
+                nValue = nValue + i;
+            }
+        };
+        CYThreadTask sleeper;
+        sleeper.nTag = nIo;
+        sleeper.funTaskToExecute = [](void*, bool) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); };
+        for (int i = 0; i < 4; ++i)
+        {
+            (void)pool->SubmitTask(spinner);
+            (void)pool->SubmitTask(sleeper);
+        }
+        TaggedTask task(nIo);
+        (void)pool->SubmitTask(&task);
+        const bool bAgain = pool->SubmitTask(&task);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const uint32_t nBlocked = pool->WaitForTag(nIo, 10);
+        bRelease.store(true);
+        const uint32_t nCompute0 = pool->WaitForTag(nCompute, 5000);
+        const uint32_t nIo0 = pool->WaitForTag(nIo, 5000);
+
+        const CYTaskTagStats objCompute = FindStats(*pool, nCompute);
+        const CYTaskTagStats objIo = FindStats(*pool, nIo);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        std::cout << "compute: completed " << objCompute.nCompleted << ", wait " << objCompute.GetMeanQueueWaitNs() / 1000
+                  << " us, execution " << objCompute.GetMeanExecutionNs() / 1000 << " us, cpu ratio " << objCompute.GetCpuRatio() << std::endl;
+        std::cout << "io: completed " << objIo.nCompleted << ", rejected " << objIo.nRejected
+                  << ", execution " << objIo.GetMeanExecutionNs() / 1000 << " us, cpu ratio " << objIo.GetCpuRatio() << std::endl;
+
+        if (nBlocked != 1 || nCompute0 != 0 || nIo0 != 0 || bAgain || task.m_runs.load() != 1)
+        {
+            std::cout << "❌ WaitForTag did not follow the tasks" << std::endl;
+            return 1;
+        }
+        if (objCompute.nSubmitted != 4 || objCompute.nCompleted != 4 || objCompute.nPending != 0 || objCompute.nRunning != 0 ||
+            objIo.nSubmitted != 5 || objIo.nCompleted != 5 || objIo.nRejected != 1 || objIo.nPending != 0)
+        {
+            std::cout << "❌ Counters do not match the submitted tasks" << std::endl;
+            return 1;
+        }
+        if (objCompute.GetMeanQueueWaitNs() < 10'000'000 || objCompute.nMaxQueueWaitNs < objCompute.GetMeanQueueWaitNs() ||
+            objIo.GetMeanExecutionNs() < 1'000'000 || objCompute.nCpuTimeNs == 0 || objIo.GetCpuRatio() >= objCompute.GetCpuRatio())
+        {
+            std::cout << "❌ Latencies or CPU time not recorded" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Statistics kept per tag" << std::endl;
+    }
+
+    // Test 3: cancelling a tag drops its queued tasks and stops the running one
+    {
+        std::cout << "\n--- Test 3: Cancel Tag ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        const CYTaskTag nJob = CYTaskTagRegistry::Intern("job");
+        std::atomic<int> nJobRuns{0};
+        std::atomic<int> nOtherRuns{0};
+
+        CYThreadTask blocker;
+        blocker.nTag = nJob;
+        blocker.funCancellableTaskToExecute = [&](void*, const CYStopToken& objStopToken) {
+            nJobRuns.fetch_add(1);
+            while (!objStopToken.stop_requested())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        (void)pool->SubmitTask(blocker);
+        (void)WaitUntil([&] { return nJobRuns.load() == 1; }, 5000);
+
+        CYThreadTask job;
+        job.nTag = nJob;
+        job.funTaskToExecute = [&](void*, bool) { nJobRuns.fetch_add(1); };
+        CYThreadTask other;
+        other.funTaskToExecute = [&](void*, bool) { nOtherRuns.fetch_add(1); };
+        for (int i = 0; i < 10; ++i)
+        {
+            (void)pool->SubmitTask(job);
+        }
+        (void)pool->SubmitTask(other);
+        (void)pool->SubmitTask(other);
+
+        const size_t nDropped = pool->CancelTag(nJob);
+        const uint32_t nIdle = pool->WaitForTag(nJob, 5000);
+        (void)WaitUntil([&] { return nOtherRuns.load() == 2; }, 5000);
+        const CYTaskTagStats objStats = FindStats(*pool, nJob);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        std::cout << "dropped " << nDropped << ", cancelled " << objStats.nCancelled << ", completed " << objStats.nCompleted << std::endl;
+        if (nDropped != 10 || nIdle != 0 || nJobRuns.load() != 1 || nOtherRuns.load() != 2 ||
+            objStats.nCancelled != 10 || objStats.nCompleted != 1 || objStats.nPending != 0)
+        {
+            std::cout << "❌ Tag not cancelled" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Queued tasks dropped, running task stopped" << std::endl;
+    }
+
+    // Test 4: a concurrency limit keeps the tag's tasks from running side by side
+    {
+        std::cout << "\n--- Test 4: Concurrency Limit ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+
+        const CYTaskTag nDisk = CYTaskTagRegistry::Intern("disk");
+        const bool bLimited = pool->SetTagConcurrency(nDisk, 1);
+
+        std::atomic<int> nRunning{0};
+        std::atomic<int> nMaxRunning{0};
+        std::atomic<int> nOtherRuns{0};
+        CYThreadTask diskTask;
+        diskTask.nTag = nDisk;
+        diskTask.funTaskToExecute = [&](void*, bool) {
+            const int nNow = nRunning.fetch_add(1) + 1;
+            int nMax = nMaxRunning.load();
+            while (nNow > nMax && !nMaxRunning.compare_exchange_weak(nMax, nNow))
+            {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(3));
+            nRunning.fetch_sub(1);
+        };
+        CYThreadTask other;
+        other.funTaskToExecute = [&](void*, bool) { nOtherRuns.fetch_add(1); };
+        for (int i = 0; i < 8; ++i)
+        {
+            (void)pool->SubmitTask(diskTask);
+            (void)pool->SubmitTask(other);
+        }
+
+        const uint32_t nIdle = pool->WaitForTag(nDisk, 10000);
+        (void)WaitUntil([&] { return nOtherRuns.load() == 8; }, 5000);
+        const CYTaskTagStats objStats = FindStats(*pool, nDisk);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        std::cout << "completed " << objStats.nCompleted << ", most running at once " << nMaxRunning.load() << std::endl;
+        if (!bLimited || nIdle != 0 || objStats.nCompleted != 8 || objStats.nConcurrencyLimit != 1 ||
+            nMaxRunning.load() != 1 || nOtherRuns.load() != 8)
+        {
+            std::cout << "❌ Limit not respected" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ At most one task of the tag ran at a time" << std::endl;
+    }
+
+    // Test 5: tasks spawned in a scope keep their tag
+    {
+        std::cout << "\n--- Test 5: Scoped Tagged Tasks ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+        const CYTaskTag nScoped = CYTaskTagRegistry::Intern("scoped");
+        TaggedTask object(nScoped);
+        std::atomic<int> nFunctionRuns{0};
+        {
+            CYTaskScope scope(pool.get());
+            CYThreadTask task;
+            task.nTag = nScoped;
+            task.funTaskToExecute = [&](void*, bool) { nFunctionRuns.fetch_add(1); };
+            (void)scope.SubmitTask(task);
+            (void)scope.SubmitTask(&object);
+        }
+
+        const uint32_t nIdle = pool->WaitForTag(nScoped, 5000);
+        const CYTaskTagStats objStats = FindStats(*pool, nScoped);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        std::cout << "submitted " << objStats.nSubmitted << ", completed " << objStats.nCompleted << std::endl;
+        if (nIdle != 0 || nFunctionRuns.load() != 1 || object.m_runs.load() != 1 ||
+            objStats.nSubmitted != 2 || objStats.nCompleted != 2)
+        {
+            std::cout << "❌ Scoped tasks lost their tag" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Function and object spawned in a scope were counted under their tag" << std::endl;
+    }
+
+    // Test 6: strand runners carry the tag of their tasks
+    {
+        std::cout << "\n--- Test 6: Strand Tagged Tasks ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+        const CYTaskTag nSerial = CYTaskTagRegistry::Intern("serial");
+        std::atomic<int> nTaggedRuns{0};
+        std::atomic<int> nOtherRuns{0};
+        CYStrand strand(pool.get());
+        for (int i = 0; i < 10; ++i)
+        {
+            CYThreadTask task;
+            task.nTag = i % 2 == 0 ? nSerial : CYTHREAD_NO_TAG;
+            task.funTaskToExecute = [&, i](void*, bool) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                (i % 2 == 0 ? nTaggedRuns : nOtherRuns).fetch_add(1);
+            };
+            (void)strand.SubmitTask(task);
+        }
+
+        const uint32_t nWaited = strand.Wait(5000);
+        const CYTaskTagStats objStats = FindStats(*pool, nSerial);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        std::cout << "tagged runners completed " << objStats.nCompleted << std::endl;
+        if (nWaited != 0 || nTaggedRuns.load() != 5 || nOtherRuns.load() != 5 || objStats.nCompleted == 0)
+        {
+            std::cout << "❌ Strand runners did not carry the tag" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Tagged strand tasks ran under runners of their tag" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "../Inc/CYThread/CYTaskGroup.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+static CYThreadTask MakeSpinTask(std::atomic<int>& started, std::atomic<int>& stopped)
+{
+    CYThreadTask task;
+    task.funCancellableTaskToExecute = [&started, &stopped](void*, const CYStopToken& objStopToken) {
+        started.fetch_add(1);
+        auto start = std::chrono::steady_clock::now();
+        while (!objStopToken.stop_requested())
+        {
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5))
+            {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stopped.fetch_add(1);
+    };
+    return task;
+}
+
+int main()
+{
+    std::cout << "=== CYThread Task Group Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+    // Test 1: Wait returns once every task of the group has run
+    {
+        std::cout << "\n--- Test 1: Group Wait ---" << std::endl;
+        CYTaskGroup group(pool.get());
+        std::atomic<int> executed{0};
+        for (int i = 0; i < 10; ++i)
+        {
+            CYThreadTask task;
+            task.funTaskToExecute = [&](void*, bool) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                executed.fetch_add(1);
+            };
+            if (!group.SubmitTask(task))
+            {
+                std::cout << "❌ Failed to submit task " << i << std::endl;
+                return 1;
+            }
+        }
+
+        if (group.Wait(5000) != 0 || executed.load() != 10 || group.GetPendingCount() != 0)
+        {
+            std::cout << "❌ Wait returned with " << executed.load() << " tasks executed" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ All 10 group tasks finished before Wait returned" << std::endl;
+    }
+
+    // Test 2: Cancel stops running tasks and drops queued ones
+    {
+        std::cout << "\n--- Test 2: Group Cancel ---" << std::endl;
+        CYTaskGroup group(pool.get());
+        std::atomic<int> started{0};
+        std::atomic<int> stopped{0};
+        for (int i = 0; i < 8; ++i)
+        {
+            if (!group.SubmitTask(MakeSpinTask(started, stopped)))
+            {
+                std::cout << "❌ Failed to submit task " << i << std::endl;
+                return 1;
+            }
+        }
+
+        if (!WaitUntil([&] { return started.load() == 2; }, 1000))
+        {
+            std::cout << "❌ Workers never picked up the group tasks" << std::endl;
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        group.Cancel();
+        uint32_t nResult = group.Wait(2000);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Cancel took " << ms.count() << " ms, started " << started.load() << std::endl;
+        if (nResult != 0 || stopped.load() != started.load() || started.load() >= 8)
+        {
+            std::cout << "❌ Cancel did not stop the group" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Running tasks stopped and queued tasks were dropped" << std::endl;
+    }
+
+    // Test 3: cancelling a parent reaches tasks of its children
+    {
+        std::cout << "\n--- Test 3: Nested Group Cancel ---" << std::endl;
+        CYTaskGroup parent(pool.get());
+        CYTaskGroup child(pool.get(), &parent);
+        std::atomic<int> started{0};
+        std::atomic<int> stopped{0};
+        if (!child.SubmitTask(MakeSpinTask(started, stopped)) ||
+            !WaitUntil([&] { return started.load() == 1; }, 1000))
+        {
+            std::cout << "❌ Child task never started" << std::endl;
+            return 1;
+        }
+
+        if (parent.GetPendingCount() != 1)
+        {
+            std::cout << "❌ Parent does not account for the child task" << std::endl;
+            return 1;
+        }
+
+        parent.Cancel();
+        if (parent.Wait(2000) != 0 || stopped.load() != 1 || !child.IsCancelled())
+        {
+            std::cout << "❌ Child task was not cancelled through its parent" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Parent cancellation reached the child task" << std::endl;
+    }
+
+    // Test 4: Cancel takes queued tasks out of the pool before it returns
+    {
+        std::cout << "\n--- Test 4: Cancel Unlinks Queued Tasks ---" << std::endl;
+        CYTaskGroup parent(pool.get());
+        CYTaskGroup child(pool.get(), &parent);
+        std::atomic<int> started{0};
+        std::atomic<int> stopped{0};
+        for (int i = 0; i < 2; ++i)
+        {
+            (void)parent.SubmitTask(MakeSpinTask(started, stopped));
+        }
+        if (!WaitUntil([&] { return started.load() == 2; }, 1000))
+        {
+            std::cout << "❌ Workers never picked up the group tasks" << std::endl;
+            return 1;
+        }
+
+        std::atomic<int> nQueuedRuns{0};
+        CYThreadTask queued;
+        queued.funTaskToExecute = [&](void*, bool) { nQueuedRuns.fetch_add(1); };
+        for (int i = 0; i < 5; ++i)
+        {
+            (void)parent.SubmitTask(queued);
+            (void)child.SubmitTask(queued);
+        }
+        const size_t nDepthBefore = pool->GetMetrics().nQueueDepth;
+
+        parent.Cancel();
+        const size_t nDepthAfter = pool->GetMetrics().nQueueDepth;
+        const int nChildPending = child.GetPendingCount();
+        const int nParentPending = parent.GetPendingCount();
+
+        std::cout << "queued " << nDepthBefore << ", after cancel " << nDepthAfter << ", parent pending " << nParentPending << std::endl;
+        if (nDepthBefore != 10 || nDepthAfter != 0 || nChildPending != 0 || nParentPending > 2 ||
+            parent.Wait(2000) != 0 || nQueuedRuns.load() != 0)
+        {
+            std::cout << "❌ Queued tasks outlived Cancel" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Queued tasks of the group and its child removed by Cancel" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <new>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Every allocation of the process, the library included, goes through these replacements.
+static std::atomic<bool> g_bCounting{false};
+static std::atomic<size_t> g_nAllocations{0};
+
+void* operator new(std::size_t nSize)
+{
+    if (g_bCounting.load(std::memory_order_relaxed))
+    {
+        g_nAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* pMemory = std::malloc(nSize ? nSize : 1))
+    {
+        return pMemory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t nSize, const std::nothrow_t&) noexcept
+{
+    if (g_bCounting.load(std::memory_order_relaxed))
+    {
+        g_nAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::malloc(nSize ? nSize : 1);
+}
+
+void* operator new[](std::size_t nSize)
+{
+    return operator new(nSize);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+    std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+    std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, std::size_t) noexcept
+{
+    std::free(pMemory);
+}
+
+class CountingObject : public ICYIThreadableObject
+{
+public:
+    explicit CountingObject(std::atomic<int>* pDone) : m_pDone(pDone) {}
+
+    void TaskToExecute() override
+    {
+        m_pDone->fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int>* m_pDone;
+};
+
+// One round: function tasks that each submit a child from the worker, plus object tasks.
+static bool RunRound(ICYThreadPool* pPool, std::vector<std::unique_ptr<CountingObject>>& lstObject, std::atomic<int>& done, int nTasks)
+{
+    done.store(0);
+    const int nExpected = nTasks * 2 + static_cast<int>(lstObject.size());
+
+    for (int i = 0; i < nTasks; ++i)
+    {
+        CYThreadTask task;
+        task.funTaskToExecute = [pPool, pDone = &done](void*, bool) {
+            CYThreadTask child;
+            child.funTaskToExecute = [pDone](void*, bool) {
+                pDone->fetch_add(1, std::memory_order_relaxed);
+            };
+            while (!pPool->SubmitTask(child))
+            {
+                std::this_thread::yield();
+            }
+            pDone->fetch_add(1, std::memory_order_relaxed);
+        };
+        while (!pPool->SubmitTask(task))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    for (auto& objObject : lstObject)
+    {
+        while (!pPool->SubmitTask(objObject.get()))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    return WaitUntil([&] { return done.load() == nExpected; }, 10000);
+}
+
+int main()
+{
+    std::cout << "=== CYThread Task Node Pool Test ===" << std::endl;
+
+    // Test 1: the replacement operator new really sees allocations
+    {
+        std::cout << "\n--- Test 1: Allocation Hook ---" << std::endl;
+        g_nAllocations.store(0);
+        g_bCounting.store(true);
+        auto ptrProbe = std::make_unique<int>(42);
+        g_bCounting.store(false);
+        if (g_nAllocations.load() != 1)
+        {
+            std::cout << "❌ Hook counted " << g_nAllocations.load() << " allocations" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Allocations are counted" << std::endl;
+    }
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4);
+
+    std::atomic<int> done{0};
+    std::vector<std::unique_ptr<CountingObject>> lstObject;
+    for (int i = 0; i < 8; ++i)
+    {
+        lstObject.push_back(std::make_unique<CountingObject>(&done));
+    }
+
+    // Test 2: once warm, submitting and completing tasks does not allocate
+    {
+        std::cout << "\n--- Test 2: Steady State ---" << std::endl;
+        for (int nRound = 0; nRound < 10; ++nRound)
+        {
+            if (!RunRound(pool.get(), lstObject, done, 20))
+            {
+                std::cout << "❌ Warm-up round did not finish" << std::endl;
+                return 1;
+            }
+        }
+
+        g_nAllocations.store(0);
+        g_bCounting.store(true);
+        bool bFinished = true;
+        for (int nRound = 0; nRound < 40 && bFinished; ++nRound)
+        {
+            bFinished = RunRound(pool.get(), lstObject, done, 20);
+        }
+        g_bCounting.store(false);
+
+        if (!bFinished)
+        {
+            std::cout << "❌ Measured round did not finish" << std::endl;
+            return 1;
+        }
+        if (g_nAllocations.load() != 0)
+        {
+            std::cout << "❌ " << g_nAllocations.load() << " allocations in steady state" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ 2400 tasks submitted and completed without allocating" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
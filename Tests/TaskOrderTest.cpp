@@ -0,0 +1,201 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+static std::mutex s_mutex;
+static std::vector<int> s_order;
+
+static void Record(int nId)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_order.push_back(nId);
+}
+
+class RecordingObject : public ICYIThreadableObject
+{
+public:
+    explicit RecordingObject(int nId) : m_nId(nId) {}
+
+    void TaskToExecute() override
+    {
+        Record(m_nId);
+    }
+
+private:
+    int m_nId;
+};
+
+// Keep the only worker of a pool busy until the flag is set.
+static bool BlockWorker(ICYThreadPool* pPool, std::atomic<bool>& started, std::atomic<bool>& release)
+{
+    CYThreadTask task;
+    task.funTaskToExecute = [&](void*, bool) {
+        started.store(true);
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    return pPool->SubmitTask(task) && WaitUntil([&] { return started.load(); }, 5000);
+}
+
+// Queue function and object tasks alternately behind a blocked worker and record the run order.
+// Even ids are function tasks, odd ids are objects.
+static bool RunInterleaved(CYTaskOrder eOrder, int nPairs, std::vector<int>& order)
+{
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    CYThreadPoolOptions options;
+    options.eTaskOrder = eOrder;
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1, options);
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    if (!BlockWorker(pool.get(), started, release))
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_order.clear();
+    }
+
+    std::vector<std::unique_ptr<RecordingObject>> lstObject;
+    for (int i = 0; i < nPairs; ++i)
+    {
+        CYThreadTask task;
+        task.funTaskToExecute = [nId = i * 2](void*, bool) { Record(nId); };
+        lstObject.push_back(std::make_unique<RecordingObject>(i * 2 + 1));
+        if (!pool->SubmitTask(task) || !pool->SubmitTask(lstObject.back().get()))
+        {
+            release.store(true);
+            return false;
+        }
+    }
+
+    release.store(true);
+    const bool bDone = WaitUntil([&] {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        return s_order.size() == static_cast<size_t>(nPairs * 2);
+    }, 10000);
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    order = s_order;
+    return bDone;
+}
+
+int main()
+{
+    std::cout << "=== CYThread Task Order Test ===" << std::endl;
+
+    const int nPairs = 10;
+
+    // Test 1: FIFO hands out both kinds in submission order
+    {
+        std::cout << "\n--- Test 1: FIFO Order ---" << std::endl;
+        std::vector<int> order;
+        if (!RunInterleaved(CYTaskOrder::TASK_ORDER_FIFO, nPairs, order))
+        {
+            std::cout << "❌ Tasks did not finish" << std::endl;
+            return 1;
+        }
+        for (int i = 0; i < nPairs * 2; ++i)
+        {
+            if (order[i] != i)
+            {
+                std::cout << "❌ Task " << order[i] << " ran at position " << i << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "✅ Function and object tasks ran in submission order" << std::endl;
+    }
+
+    // Test 2: objects first runs every object before any function task, each kind in order
+    {
+        std::cout << "\n--- Test 2: Objects First ---" << std::endl;
+        std::vector<int> order;
+        if (!RunInterleaved(CYTaskOrder::TASK_ORDER_OBJECTS_FIRST, nPairs, order))
+        {
+            std::cout << "❌ Tasks did not finish" << std::endl;
+            return 1;
+        }
+        for (int i = 0; i < nPairs; ++i)
+        {
+            if (order[i] != i * 2 + 1 || order[nPairs + i] != i * 2)
+            {
+                std::cout << "❌ Unexpected order at position " << i << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "✅ Objects ran first, each kind in submission order" << std::endl;
+    }
+
+    // Test 3: tasks a pass could not place are counted as missed and no longer count against MaxTasks
+    {
+        std::cout << "\n--- Test 3: Missed Tasks ---" << std::endl;
+        CYThreadFactory factory;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        if (!BlockWorker(pool.get(), started, release))
+        {
+            std::cout << "❌ Worker did not start" << std::endl;
+            return 1;
+        }
+
+        std::vector<std::unique_ptr<RecordingObject>> lstObject;
+        for (int i = 0; i < 4; ++i)
+        {
+            lstObject.push_back(std::make_unique<RecordingObject>(i));
+            (void)pool->SubmitTask(lstObject.back().get());
+        }
+        const bool bMissed = WaitUntil([&] { return pool->GetTasksMissedCount() == 4 && pool->GetTaskCount() == 0; }, 1000);
+
+        // Far more than MaxTasks, accepted as earlier ones are marked missed.
+        std::atomic<int> done{0};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { done.fetch_add(1); };
+        int nSubmitted = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (nSubmitted < 100 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+        {
+            if (pool->SubmitTask(task))
+            {
+                ++nSubmitted;
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        release.store(true);
+        const bool bDone = WaitUntil([&] { return done.load() == nSubmitted; }, 5000);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (!bMissed || nSubmitted != 100 || !bDone)
+        {
+            std::cout << "❌ Missed " << bMissed << ", submitted " << nSubmitted << ", done " << done.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Missed objects counted, 100 function tasks queued behind a busy worker" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <stdexcept>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "../Inc/CYThread/CYTaskScope.hpp"
+
+using namespace cry;
+
+static CYThreadTask MakeTask(const std::function<void()>& funBody)
+{
+    CYThreadTask task;
+    task.funTaskToExecute = [funBody](void*, bool) { funBody(); };
+    return task;
+}
+
+class CountingObject : public ICYIThreadableObject
+{
+public:
+    void TaskToExecute() override
+    {
+        runs.fetch_add(1);
+    }
+
+    std::atomic<int> runs{0};
+};
+
+int main()
+{
+    std::cout << "=== CYThread Task Scope Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+    // Test 1: leaving the scope joins every child
+    {
+        std::cout << "\n--- Test 1: Scope Joins Children ---" << std::endl;
+        std::atomic<int> executed{0};
+        {
+            CYTaskScope scope(pool.get());
+            for (int i = 0; i < 10; ++i)
+            {
+                if (!scope.SubmitTask(MakeTask([&] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    executed.fetch_add(1);
+                })))
+                {
+                    std::cout << "❌ Failed to submit task " << i << std::endl;
+                    return 1;
+                }
+            }
+        }
+
+        if (executed.load() != 10)
+        {
+            std::cout << "❌ Scope left with " << executed.load() << " tasks executed" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ All 10 children finished before the scope was left" << std::endl;
+    }
+
+    // Test 2: a child exception reaches the owner
+    {
+        std::cout << "\n--- Test 2: Exception Propagation ---" << std::endl;
+        std::atomic<int> executed{0};
+        bool bCaught = false;
+        try
+        {
+            CYTaskScope scope(pool.get());
+            (void)scope.SubmitTask(MakeTask([&] { executed.fetch_add(1); }));
+            (void)scope.SubmitTask(MakeTask([] { throw std::runtime_error("child failed"); }));
+            (void)scope.SubmitTask(MakeTask([&] { executed.fetch_add(1); }));
+        }
+        catch (const std::runtime_error& e)
+        {
+            bCaught = std::string(e.what()) == "child failed";
+        }
+
+        if (!bCaught || executed.load() != 2)
+        {
+            std::cout << "❌ Exception was not rethrown after the join" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Child exception rethrown to the owner after all children finished" << std::endl;
+    }
+
+    // Test 3: workers waiting on nested scopes help instead of deadlocking
+    {
+        std::cout << "\n--- Test 3: Nested Scopes On Workers ---" << std::endl;
+        std::atomic<int> executed{0};
+        auto start = std::chrono::steady_clock::now();
+        {
+            CYTaskScope scope(pool.get());
+            for (int i = 0; i < 2; ++i)
+            {
+                (void)scope.SubmitTask(MakeTask([&] {
+                    // Both workers block here, only helping lets the inner tasks run.
+                    CYTaskScope inner(pool.get());
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        (void)inner.SubmitTask(MakeTask([&] { executed.fetch_add(1); }));
+                    }
+                }));
+            }
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Nested scopes took " << ms.count() << " ms" << std::endl;
+        if (executed.load() != 8)
+        {
+            std::cout << "❌ Executed " << executed.load() << " inner tasks" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Blocked workers executed their children themselves" << std::endl;
+    }
+
+    // Test 4: cancelling a scope reaches a child its owner runs while it waits
+    {
+        std::cout << "\n--- Test 4: Cancel Helped Child ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> single(factory.CreateThreadPool());
+        single->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<CYTaskScope*> pScope{nullptr};
+        std::atomic<bool> bChildStarted{false};
+        std::atomic<bool> bChildStopped{false};
+        std::atomic<bool> bOwnerDone{false};
+        std::atomic<bool> bOwnerStopped{false};
+        CYThreadTask owner;
+        owner.funCancellableTaskToExecute = [&](void*, const CYStopToken& objOwnerToken) {
+            CYTaskScope scope(single.get());
+            CYThreadTask child;
+            child.funCancellableTaskToExecute = [&](void*, const CYStopToken& objStopToken) {
+                bChildStarted.store(true);
+                auto start = std::chrono::steady_clock::now();
+                while (!objStopToken.stop_requested() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                bChildStopped.store(objStopToken.stop_requested());
+            };
+            (void)scope.SubmitTask(child);
+            pScope.store(&scope);
+            scope.Join();
+            pScope.store(nullptr);
+            bOwnerStopped.store(objOwnerToken.stop_requested());
+            bOwnerDone.store(true);
+        };
+        (void)single->SubmitTask(owner);
+
+        auto start = std::chrono::steady_clock::now();
+        while (!bChildStarted.load() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // The child keeps the scope alive until it stops.
+        if (auto pCurrentScope = pScope.load())
+        {
+            pCurrentScope->Cancel();
+        }
+        while (!bOwnerDone.load() && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        (void)single->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        std::cout << "Helped child stopped after " << ms.count() << " ms" << std::endl;
+        if (!bChildStarted.load() || !bChildStopped.load() || !bOwnerDone.load())
+        {
+            std::cout << "❌ Cancel did not reach the helped child" << std::endl;
+            return 1;
+        }
+        if (bOwnerStopped.load())
+        {
+            std::cout << "❌ Cancelling the helped child stopped its owner" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Helped child observed the cancellation, its owner did not" << std::endl;
+    }
+
+    // Test 5: a worker of another pool waits for the scope instead of running its tasks
+    {
+        std::cout << "\n--- Test 5: Join From Another Pool ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> poolA(factory.CreateThreadPool());
+        std::unique_ptr<ICYThreadPool> poolB(factory.CreateThreadPool());
+        poolA->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+        poolB->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        std::atomic<bool> bRelease{false};
+        (void)poolB->SubmitTask(MakeTask([&] {
+            while (!bRelease.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }));
+
+        std::atomic<int> nChildWorker{-2};
+        std::atomic<bool> bJoined{false};
+        (void)poolA->SubmitTask(MakeTask([&] {
+            CYTaskScope scope(poolB.get());
+            (void)scope.SubmitTask(MakeTask([&] { nChildWorker.store(poolB->GetCurrentWorkerIndex()); }));
+            scope.Join();
+            bJoined.store(true);
+        }));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const int nBeforeRelease = nChildWorker.load();
+        bRelease.store(true);
+        auto start = std::chrono::steady_clock::now();
+        while (!bJoined.load() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        (void)poolA->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        (void)poolB->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (nBeforeRelease != -2 || nChildWorker.load() != 0 || !bJoined.load())
+        {
+            std::cout << "❌ Child ran on worker " << nChildWorker.load() << " of its pool" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Child ran on its own pool's worker" << std::endl;
+    }
+
+    // Test 6: an object spawned in a scope counts as queued until it starts
+    {
+        std::cout << "\n--- Test 6: Scope Object Queued Once ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> single(factory.CreateThreadPool());
+        single->CreateThreadPool(CY_PLATFORM_WINDOWS, 1);
+
+        // The only worker is busy, so the scope task stays queued.
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        (void)single->SubmitTask(MakeTask([&] {
+            started.store(true);
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }));
+        while (!started.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        CountingObject object;
+        bool bFirst = false;
+        bool bScopeAgain = true;
+        bool bPoolAgain = true;
+        bool bAfterRun = false;
+        {
+            CYTaskScope scope(single.get());
+            bFirst = scope.SubmitTask(&object);
+            bScopeAgain = scope.SubmitTask(&object);
+            bPoolAgain = single->SubmitTask(&object);
+            release.store(true);
+            scope.Join();
+            bAfterRun = scope.SubmitTask(&object);
+        }
+        (void)single->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (!bFirst || bScopeAgain || bPoolAgain || !bAfterRun || object.runs.load() != 2)
+        {
+            std::cout << "❌ Object was queued twice or not released after it ran" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Object queued once, submitted again after it started" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
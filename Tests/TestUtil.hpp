@@ -0,0 +1,23 @@
+#ifndef __CY_TEST_UTIL_HPP__
+#define __CY_TEST_UTIL_HPP__
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+// Poll funDone every millisecond until it holds, false once nTimeoutMs passed without it.
+inline bool WaitUntil(const std::function<bool()>& funDone, int nTimeoutMs)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (!funDone())
+    {
+        if (std::chrono::steady_clock::now() - start > std::chrono::milliseconds(nTimeoutMs))
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+#endif // __CY_TEST_UTIL_HPP__
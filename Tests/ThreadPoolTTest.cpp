@@ -0,0 +1,220 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadPoolT.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Plain callable task, dispatched without std::function.
+struct CountTask
+{
+    std::atomic<int>* pCounter;
+
+    void operator()() const
+    {
+        pCounter->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+class CountingObject : public ICYIThreadableObject
+{
+public:
+    std::atomic<int> nRuns{0};
+
+    void TaskToExecute() override
+    {
+        nRuns.fetch_add(1);
+    }
+};
+
+int main()
+{
+    std::cout << "=== CYThread Templated Pool Test ===" << std::endl;
+
+    // Test 1: the default pool runs CYThreadTask
+    {
+        std::cout << "\n--- Test 1: Default Policies ---" << std::endl;
+        CYThreadPoolT<> pool;
+        pool.CreateThreadPool(4);
+
+        std::atomic<int> done{0};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { done.fetch_add(1); };
+        for (int i = 0; i < 1000; ++i)
+        {
+            (void)pool.SubmitTask(task);
+        }
+        if (!WaitUntil([&] { return done.load() == 1000; }, 5000))
+        {
+            std::cout << "❌ " << done.load() << " of 1000 tasks executed" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ 1000 tasks executed" << std::endl;
+    }
+
+    // Test 2: callable tasks with spinning workers and counters
+    {
+        std::cout << "\n--- Test 2: Spin Idle Policy ---" << std::endl;
+        CYThreadPoolT<CYFifoQueuePolicy<CountTask>, CYSpinIdlePolicy<>, CYCountingInstrumentation> pool;
+        pool.CreateThreadPool(2);
+
+        std::atomic<int> done{0};
+        const int nTasks = 100000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nTasks; ++i)
+        {
+            (void)pool.SubmitTask(CountTask{ &done });
+        }
+        (void)pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        auto nElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        auto& objStats = pool.GetInstrumentation();
+        if (done.load() != nTasks || objStats.GetSubmittedCount() != static_cast<uint64_t>(nTasks) || objStats.GetExecutedCount() != static_cast<uint64_t>(nTasks))
+        {
+            std::cout << "❌ Done " << done.load() << ", submitted " << objStats.GetSubmittedCount() << ", executed " << objStats.GetExecutedCount() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << nTasks << " tasks drained in " << nElapsedMs << " ms" << std::endl;
+    }
+
+    // Test 3: LIFO order on a single worker, object tasks, worker index
+    {
+        std::cout << "\n--- Test 3: LIFO Queue ---" << std::endl;
+        using Pool = CYThreadPoolT<CYLifoQueuePolicy<std::function<void()>>>;
+        Pool pool;
+        pool.CreateThreadPool(1);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        (void)pool.SubmitTask([&] {
+            started.store(true);
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        if (!WaitUntil([&] { return started.load(); }, 5000))
+        {
+            std::cout << "❌ Worker did not start" << std::endl;
+            return 1;
+        }
+
+        std::mutex mutex;
+        std::vector<int> order;
+        int nWorkerIndex = -2;
+        for (int i = 0; i < 5; ++i)
+        {
+            (void)pool.SubmitTask([&, i] {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+                nWorkerIndex = pool.GetCurrentWorkerIndex();
+            });
+        }
+        release.store(true);
+        (void)pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (order != std::vector<int>{ 4, 3, 2, 1, 0 } || nWorkerIndex != 0 || pool.GetCurrentWorkerIndex() != -1)
+        {
+            std::cout << "❌ Unexpected order or worker index " << nWorkerIndex << std::endl;
+            return 1;
+        }
+
+        CYThreadPoolT<CYFifoQueuePolicy<ICYIThreadableObject*>> objectPool;
+        objectPool.CreateThreadPool(2);
+        CountingObject objObject;
+        for (int i = 0; i < 10; ++i)
+        {
+            (void)objectPool.SubmitTask(&objObject);
+        }
+        (void)objectPool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        if (objObject.nRuns.load() != 10)
+        {
+            std::cout << "❌ Object ran " << objObject.nRuns.load() << " times" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Newest task first, objects dispatched" << std::endl;
+    }
+
+    // Test 4: task limit and cancelled tasks
+    {
+        std::cout << "\n--- Test 4: Limit And Cancel ---" << std::endl;
+        CYThreadPoolT<CYFifoQueuePolicy<CYThreadTask>, CYBlockingIdlePolicy, CYCountingInstrumentation> pool;
+        pool.CreateThreadPool(1, 8);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        CYThreadTask blockTask;
+        blockTask.funTaskToExecute = [&](void*, bool) {
+            started.store(true);
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        (void)pool.SubmitTask(blockTask);
+        (void)WaitUntil([&] { return started.load(); }, 5000);
+
+        std::atomic<int> done{0};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { done.fetch_add(1); };
+        int nAccepted = 0;
+        for (int i = 0; i < 20; ++i)
+        {
+            nAccepted += pool.SubmitTask(task) ? 1 : 0;
+        }
+
+        int nCancelled = 0;
+        std::thread releaser([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            release.store(true);
+        });
+        (void)pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_CANCEL_PENDING, 0, [&](CYThreadTask&) { ++nCancelled; });
+        releaser.join();
+
+        if (nAccepted != 8 || pool.GetInstrumentation().GetRejectedCount() != 12 || nCancelled != 8 || done.load() != 0 || pool.SubmitTask(task))
+        {
+            std::cout << "❌ Accepted " << nAccepted << ", cancelled " << nCancelled << ", done " << done.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Limit enforced, " << nCancelled << " tasks reported as cancelled" << std::endl;
+    }
+
+    // Test 5: a worker can shut its own pool down
+    {
+        std::cout << "\n--- Test 5: Shutdown From A Worker ---" << std::endl;
+        CYThreadPoolT<> pool;
+        pool.CreateThreadPool(3);
+
+        std::atomic<bool> bStopped{false};
+        std::atomic<bool> bResult{false};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) {
+            bResult.store(pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN));
+            bStopped.store(true);
+        };
+        (void)pool.SubmitTask(task);
+
+        const bool bDone = WaitUntil([&] { return bStopped.load(); }, 5000);
+        // The calling worker is joined here, after that the pool can be started again.
+        const bool bSecond = pool.Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        const bool bRestarted = pool.CreateThreadPool(1);
+
+        if (!bDone || !bResult.load() || bSecond || !bRestarted)
+        {
+            std::cout << "❌ Worker shutdown did not complete" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Worker shut its pool down without joining itself" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+
+using namespace cry;
+
+static CYThreadTask MakeTask(const std::function<void()>& funBody)
+{
+    CYThreadTask task;
+    task.funTaskToExecute = [funBody](void*, bool) { funBody(); };
+    return task;
+}
+
+int main()
+{
+    std::cout << "=== CYThread Timer Test ===" << std::endl;
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+
+    // Test 1: SubmitAfter never fires early
+    {
+        std::cout << "\n--- Test 1: SubmitAfter ---" << std::endl;
+        std::atomic<bool> fired{false};
+        std::atomic<int64_t> elapsedMs{0};
+        auto start = std::chrono::steady_clock::now();
+        CYTimerId nTimerId = pool->SubmitAfter(std::chrono::milliseconds(50), MakeTask([&] {
+            elapsedMs.store(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+            fired.store(true);
+        }));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        std::cout << "Fired after " << elapsedMs.load() << " ms" << std::endl;
+        if (nTimerId == CYTHREAD_INVALID_TIMER_ID || !fired.load() || elapsedMs.load() < 50)
+        {
+            std::cout << "❌ Delayed task did not fire on time" << std::endl;
+            return 1;
+        }
+        if (pool->CancelTimer(nTimerId))
+        {
+            std::cout << "❌ Cancelling a fired timer succeeded" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Delayed task fired after its delay" << std::endl;
+    }
+
+    // Test 2: cancelled timers never fire
+    {
+        std::cout << "\n--- Test 2: CancelTimer ---" << std::endl;
+        std::atomic<int> fired{0};
+        CYTimerId nTimerId = pool->SubmitAt(std::chrono::steady_clock::now() + std::chrono::milliseconds(30),
+            MakeTask([&] { fired.fetch_add(1); }));
+        if (!pool->CancelTimer(nTimerId))
+        {
+            std::cout << "❌ Pending timer could not be cancelled" << std::endl;
+            return 1;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (fired.load() != 0)
+        {
+            std::cout << "❌ Cancelled timer fired" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Cancelled timer did not fire" << std::endl;
+    }
+
+    // Test 3: SubmitEvery repeats until cancelled
+    {
+        std::cout << "\n--- Test 3: SubmitEvery ---" << std::endl;
+        std::atomic<int> fired{0};
+        CYTimerId nTimerId = pool->SubmitEvery(std::chrono::milliseconds(20), MakeTask([&] { fired.fetch_add(1); }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(210));
+        if (!pool->CancelTimer(nTimerId))
+        {
+            std::cout << "❌ Periodic timer could not be cancelled" << std::endl;
+            return 1;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        int nFired = fired.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::cout << "Fired " << nFired << " times" << std::endl;
+        if (nFired < 5 || nFired > 11 || fired.load() != nFired)
+        {
+            std::cout << "❌ Periodic timer fired " << fired.load() << " times" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Periodic task repeated and stopped after cancel" << std::endl;
+    }
+
+    // Test 4: a million timeouts are cheap to create and cancel
+    {
+        std::cout << "\n--- Test 4: Mass Create And Cancel ---" << std::endl;
+        const int nCount = 1000000;
+        std::vector<CYTimerId> lstTimer;
+        lstTimer.reserve(nCount);
+        std::atomic<int> fired{0};
+        CYThreadTask task = MakeTask([&] { fired.fetch_add(1); });
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nCount; ++i)
+        {
+            lstTimer.push_back(pool->SubmitAfter(std::chrono::milliseconds(60000 + i % 100000), task));
+        }
+        int nCancelled = 0;
+        for (auto nTimerId : lstTimer)
+        {
+            nCancelled += pool->CancelTimer(nTimerId) ? 1 : 0;
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Created and cancelled " << nCancelled << " timers in " << ms.count() << " ms" << std::endl;
+        if (nCancelled != nCount || fired.load() != 0)
+        {
+            std::cout << "❌ Not every timer was cancelled" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ All timers cancelled" << std::endl;
+    }
+
+    // Test 5: Shutdown runs due timers on drain and reports the others
+    {
+        std::cout << "\n--- Test 5: Timers On Shutdown ---" << std::endl;
+        std::atomic<int> fired{0};
+        int nReported = 0;
+        auto funOnCancelled = [&](const CYThreadTask* pTask, ICYIThreadableObject*) { nReported += pTask ? 1 : 0; };
+
+        std::unique_ptr<ICYThreadPool> drainPool(factory.CreateThreadPool());
+        drainPool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+        (void)drainPool->SubmitAfter(std::chrono::milliseconds(1), MakeTask([&] { fired.fetch_add(1); }));
+        (void)drainPool->SubmitAfter(std::chrono::milliseconds(60000), MakeTask([&] { fired.fetch_add(1); }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        (void)drainPool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN, 0, funOnCancelled);
+        if (fired.load() != 1 || nReported != 1)
+        {
+            std::cout << "❌ Drain ran " << fired.load() << " timers and reported " << nReported << std::endl;
+            return 1;
+        }
+
+        nReported = 0;
+        std::unique_ptr<ICYThreadPool> cancelPool(factory.CreateThreadPool());
+        cancelPool->CreateThreadPool(CY_PLATFORM_WINDOWS, 2);
+        (void)cancelPool->SubmitAfter(std::chrono::milliseconds(60000), MakeTask([&] { fired.fetch_add(1); }));
+        (void)cancelPool->SubmitEvery(std::chrono::milliseconds(60000), MakeTask([&] { fired.fetch_add(1); }));
+        (void)cancelPool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_CANCEL_PENDING, 0, funOnCancelled);
+        if (nReported != 2 || cancelPool->SubmitAfter(std::chrono::milliseconds(1), MakeTask([] {})) != CYTHREAD_INVALID_TIMER_ID)
+        {
+            std::cout << "❌ Cancel reported " << nReported << " timers" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Pending timers were run or reported" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+static size_t CountOf(const std::string& strText, const std::string& strPattern)
+{
+    size_t nCount = 0;
+    for (size_t nPos = strText.find(strPattern); nPos != std::string::npos; nPos = strText.find(strPattern, nPos + 1))
+    {
+        ++nCount;
+    }
+    return nCount;
+}
+
+// Runs nTasks short tasks and returns the trace, empty if the pool wrote none.
+static std::string RunAndTrace(int nWorkers, size_t nTraceCapacity, int nTasks)
+{
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    CYThreadPoolOptions options;
+    options.nTraceCapacity = nTraceCapacity;
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, nWorkers, options);
+
+    CYThreadTask task;
+    task.funTaskToExecute = [](void*, bool) { std::this_thread::sleep_for(std::chrono::microseconds(100)); };
+    for (int i = 0; i < nTasks; ++i)
+    {
+        while (!pool->SubmitTask(task))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    (void)WaitUntil([&] { return pool->GetMetrics().nCompleted == static_cast<uint64_t>(nTasks); }, 10000);
+
+    std::ostringstream objStream;
+    const bool bWritten = pool->WriteTrace(objStream);
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    return bWritten ? objStream.str() : std::string();
+}
+
+int main()
+{
+    std::cout << "=== CYThread Trace Test ===" << std::endl;
+
+    // Test 1: every task shows up with its submit, dispatch and span
+    {
+        std::cout << "\n--- Test 1: Chrome Trace ---" << std::endl;
+        const std::string strTrace = RunAndTrace(2, 4096, 50);
+
+        const size_t nTasks = CountOf(strTrace, "\"name\":\"task\"");
+        const size_t nSubmits = CountOf(strTrace, "\"name\":\"submit\"");
+        const size_t nDispatches = CountOf(strTrace, "\"name\":\"dispatch\"");
+        const size_t nIdle = CountOf(strTrace, "\"name\":\"idle\"");
+        std::cout << "tasks " << nTasks << ", submits " << nSubmits << ", dispatches " << nDispatches << ", idle spans " << nIdle
+                  << ", " << strTrace.size() << " bytes" << std::endl;
+
+        if (strTrace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) != 0 || strTrace.substr(strTrace.size() - 2) != "]}" ||
+            CountOf(strTrace, "{") != CountOf(strTrace, "}") || CountOf(strTrace, "\"thread_name\"") != 2)
+        {
+            std::cout << "❌ Trace is not well formed" << std::endl;
+            return 1;
+        }
+        if (nTasks != 50 || nSubmits != 50 || nDispatches != 50 || nIdle == 0)
+        {
+            std::cout << "❌ Trace misses events" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Trace holds every event" << std::endl;
+    }
+
+    // Test 2: a pool without tracing writes nothing
+    {
+        std::cout << "\n--- Test 2: Tracing Off ---" << std::endl;
+        if (!RunAndTrace(2, 0, 10).empty())
+        {
+            std::cout << "❌ Trace written without tracing" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ No trace without tracing" << std::endl;
+    }
+
+    // Test 3: a full ring keeps the newest events
+    {
+        std::cout << "\n--- Test 3: Ring Wraps ---" << std::endl;
+        const std::string strTrace = RunAndTrace(1, 16, 200);
+        const size_t nEvents = CountOf(strTrace, "\"ph\":\"X\"");
+        if (strTrace.empty() || nEvents == 0 || nEvents > 16)
+        {
+            std::cout << "❌ Worker ring kept " << nEvents << " spans" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Worker ring kept " << nEvents << " spans" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
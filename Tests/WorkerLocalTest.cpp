@@ -0,0 +1,106 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <set>
+#include <mutex>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "../Inc/CYThread/CYWorkerLocal.hpp"
+
+using namespace cry;
+
+int main()
+{
+    std::cout << "=== CYThread Worker Local Test ===" << std::endl;
+
+    const int nWorkers = 4;
+    std::mutex mutex;
+    std::set<int> started;
+    std::set<int> stopped;
+    std::set<std::thread::id> hookThreads;
+
+    CYThreadPoolOptions options;
+    options.funOnWorkerStart = [&](int nWorkerIndex) {
+        std::lock_guard<std::mutex> lock(mutex);
+        started.insert(nWorkerIndex);
+        hookThreads.insert(std::this_thread::get_id());
+    };
+    options.funOnWorkerStop = [&](int nWorkerIndex) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped.insert(nWorkerIndex);
+    };
+
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, nWorkers, options);
+
+    // Test 1: the start hook ran on every worker before its first task
+    {
+        std::cout << "\n--- Test 1: Start Hooks ---" << std::endl;
+        std::atomic<int> beforeHook{0};
+        (void)pool->RunOnAllWorkers([&](int nWorkerIndex, int, CYBarrier&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!started.count(nWorkerIndex) || !hookThreads.count(std::this_thread::get_id()))
+            {
+                beforeHook.fetch_add(1);
+            }
+        });
+
+        if (beforeHook.load() != 0 || started.size() != static_cast<size_t>(nWorkers))
+        {
+            std::cout << "❌ A worker ran a task before its start hook" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Start hook ran on each worker thread" << std::endl;
+    }
+
+    // Test 2: worker-local counters reduce to the exact total
+    {
+        std::cout << "\n--- Test 2: Worker Local Reduction ---" << std::endl;
+        const int nPerWorker = 100000;
+        CYWorkerLocal<long long> counters(pool.get(), 0);
+        (void)pool->RunOnAllWorkers([&](int, int, CYBarrier&) {
+            auto& nLocal = counters.Local();
+            for (int i = 0; i < nPerWorker; ++i)
+            {
+                ++nLocal;
+            }
+        });
+
+        long long nTotal = counters.Combine(0LL, [](long long a, long long b) { return a + b; });
+        int nBusySlots = 0;
+        counters.Enumerate([&](size_t, long long& nValue) { nBusySlots += nValue != 0 ? 1 : 0; });
+
+        if (nTotal != static_cast<long long>(nPerWorker) * nWorkers || nBusySlots != nWorkers)
+        {
+            std::cout << "❌ Total " << nTotal << ", busy slots " << nBusySlots << std::endl;
+            return 1;
+        }
+        if (reinterpret_cast<uintptr_t>(&counters.Local()) % CYTHREAD_CACHE_LINE_SIZE != 0)
+        {
+            std::cout << "❌ Instances are not cache line aligned" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << nTotal << " increments without shared atomics" << std::endl;
+    }
+
+    // Test 3: the stop hook runs when the pool shuts down
+    {
+        std::cout << "\n--- Test 3: Stop Hooks ---" << std::endl;
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopped.size() != static_cast<size_t>(nWorkers))
+        {
+            std::cout << "❌ Stop hook ran on " << stopped.size() << " workers" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Stop hook ran on every worker" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
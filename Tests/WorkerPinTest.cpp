@@ -0,0 +1,95 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+int main()
+{
+    std::cout << "=== CYThread Worker Pin Test ===" << std::endl;
+
+    const int nWorkers = 4;
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, nWorkers);
+
+    // Test 1: outside the pool there is no current worker
+    {
+        std::cout << "\n--- Test 1: Non-Worker Thread ---" << std::endl;
+        if (pool->GetCurrentWorkerIndex() != -1)
+        {
+            std::cout << "❌ Main thread reported worker " << pool->GetCurrentWorkerIndex() << std::endl;
+            return 1;
+        }
+
+        CYThreadTask task;
+        if (pool->SubmitToWorker(nWorkers, task) || pool->SubmitToWorker(-1, task))
+        {
+            std::cout << "❌ Invalid worker index was accepted" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Main thread is not a worker and invalid indices are refused" << std::endl;
+    }
+
+    // Test 2: pinned tasks run on their worker and may use per-worker state without locks
+    {
+        std::cout << "\n--- Test 2: Per-Worker Counters ---" << std::endl;
+        const int nPerWorker = 50;
+        std::vector<int> lstCounter(nWorkers, 0);
+        std::atomic<int> misplaced{0};
+        std::atomic<int> executed{0};
+
+        for (int i = 0; i < nPerWorker; ++i)
+        {
+            for (int nWorker = 0; nWorker < nWorkers; ++nWorker)
+            {
+                CYThreadTask task;
+                task.funTaskToExecute = [&, nWorker, pPool = pool.get()](void*, bool) {
+                    if (pPool->GetCurrentWorkerIndex() != nWorker)
+                    {
+                        misplaced.fetch_add(1);
+                    }
+                    ++lstCounter[nWorker];
+                    executed.fetch_add(1);
+                };
+                while (!pool->SubmitToWorker(nWorker, task))
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+
+        if (!WaitUntil([&] { return executed.load() == nPerWorker * nWorkers; }, 10000))
+        {
+            std::cout << "❌ Executed " << executed.load() << " pinned tasks" << std::endl;
+            return 1;
+        }
+
+        for (int nWorker = 0; nWorker < nWorkers; ++nWorker)
+        {
+            if (lstCounter[nWorker] != nPerWorker)
+            {
+                std::cout << "❌ Worker " << nWorker << " counted " << lstCounter[nWorker] << std::endl;
+                return 1;
+            }
+        }
+
+        if (misplaced.load() != 0)
+        {
+            std::cout << "❌ " << misplaced.load() << " tasks ran on the wrong worker" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Every pinned task ran on its own worker" << std::endl;
+    }
+
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}
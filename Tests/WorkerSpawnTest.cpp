@@ -0,0 +1,179 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <set>
+#include <functional>
+
+// Include CYThread headers
+#include "../Inc/CYThread/CYThreadFactory.hpp"
+#include "TestUtil.hpp"
+
+using namespace cry;
+
+// Records the index of every worker that started.
+struct StartedWorkers
+{
+    std::mutex mutex;
+    std::set<int> lstIndex;
+
+    CYWorkerHook Hook()
+    {
+        return [this](int nWorkerIndex) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lstIndex.insert(nWorkerIndex);
+        };
+    }
+
+    size_t Count()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lstIndex.size();
+    }
+};
+
+static long long CreateAndMeasure(CYWorkerSpawnMode eMode, int nWorkers, StartedWorkers& objStarted)
+{
+    CYThreadFactory factory;
+    std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+    CYThreadPoolOptions options;
+    options.eSpawnMode = eMode;
+    options.funOnWorkerStart = objStarted.Hook();
+
+    auto start = std::chrono::steady_clock::now();
+    pool->CreateThreadPool(CY_PLATFORM_WINDOWS, nWorkers, options);
+    auto nElapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    (void)WaitUntil([&] { return objStarted.Count() == static_cast<size_t>(nWorkers); }, 5000);
+    (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+    return nElapsedUs;
+}
+
+int main()
+{
+    std::cout << "=== CYThread Worker Spawn Test ===" << std::endl;
+
+    CYThreadFactory factory;
+
+    // Test 1: a lazy pool starts without workers and grows with demand
+    {
+        std::cout << "\n--- Test 1: Lazy Spawn ---" << std::endl;
+        StartedWorkers objStarted;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        CYThreadPoolOptions options;
+        options.eSpawnMode = CYWorkerSpawnMode::SPAWN_MODE_LAZY;
+        options.funOnWorkerStart = objStarted.Hook();
+        if (!pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 8, options))
+        {
+            std::cout << "❌ Lazy pool creation failed" << std::endl;
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const size_t nAtCreate = objStarted.Count();
+
+        std::atomic<int> done{0};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { done.fetch_add(1); };
+        (void)pool->SubmitTask(task);
+        (void)WaitUntil([&] { return done.load() == 1; }, 5000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const size_t nAfterOne = objStarted.Count();
+
+        // Eight tasks that only finish together need every worker.
+        std::atomic<int> running{0};
+        CYThreadTask blockTask;
+        blockTask.funTaskToExecute = [&](void*, bool) {
+            running.fetch_add(1);
+            (void)WaitUntil([&] { return running.load() == 8; }, 5000);
+        };
+        for (int i = 0; i < 8; ++i)
+        {
+            (void)pool->SubmitTask(blockTask);
+        }
+        const bool bAllRan = WaitUntil([&] { return running.load() == 8; }, 5000);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (nAtCreate != 0 || nAfterOne != 1 || !bAllRan || objStarted.Count() != 8)
+        {
+            std::cout << "❌ Workers at create " << nAtCreate << ", after one task " << nAfterOne << ", at the end " << objStarted.Count() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ 0 workers at create, 1 after one task, 8 under load" << std::endl;
+    }
+
+    // Test 2: parallel spawn creates every worker with unique indices
+    {
+        std::cout << "\n--- Test 2: Parallel Spawn ---" << std::endl;
+        const int nWorkers = 64;
+        StartedWorkers objEager;
+        StartedWorkers objParallel;
+        const long long nEagerUs = CreateAndMeasure(CYWorkerSpawnMode::SPAWN_MODE_EAGER, nWorkers, objEager);
+        const long long nParallelUs = CreateAndMeasure(CYWorkerSpawnMode::SPAWN_MODE_PARALLEL, nWorkers, objParallel);
+
+        if (objParallel.Count() != static_cast<size_t>(nWorkers) || *objParallel.lstIndex.rbegin() != nWorkers - 1)
+        {
+            std::cout << "❌ " << objParallel.Count() << " workers started" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ " << nWorkers << " workers, eager " << nEagerUs << " us, parallel " << nParallelUs << " us" << std::endl;
+    }
+
+    // Test 3: prewarming a lazy pool spawns and warms every worker
+    {
+        std::cout << "\n--- Test 3: Prewarm ---" << std::endl;
+        StartedWorkers objStarted;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        CYThreadPoolOptions options;
+        options.eSpawnMode = CYWorkerSpawnMode::SPAWN_MODE_LAZY;
+        options.funOnWorkerStart = objStarted.Hook();
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 4, options);
+
+        if (!pool->Prewarm(256 * 1024) || objStarted.Count() != 4)
+        {
+            std::cout << "❌ Prewarm failed, " << objStarted.Count() << " workers started" << std::endl;
+            return 1;
+        }
+
+        // Not from inside the pool, the calling worker could never join the region.
+        std::atomic<int> nResult{-1};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { nResult.store(pool->Prewarm() ? 1 : 0); };
+        (void)pool->SubmitTask(task);
+        if (!WaitUntil([&] { return nResult.load() != -1; }, 5000) || nResult.load() != 0)
+        {
+            std::cout << "❌ Prewarm from a worker returned " << nResult.load() << std::endl;
+            return 1;
+        }
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+        std::cout << "✅ 4 workers spawned and warmed" << std::endl;
+    }
+
+    // Test 4: a task pinned to a worker that was not spawned yet
+    {
+        std::cout << "\n--- Test 4: Pinned Lazy Worker ---" << std::endl;
+        std::unique_ptr<ICYThreadPool> pool(factory.CreateThreadPool());
+        CYThreadPoolOptions options;
+        options.eSpawnMode = CYWorkerSpawnMode::SPAWN_MODE_LAZY;
+        pool->CreateThreadPool(CY_PLATFORM_WINDOWS, 6, options);
+
+        std::atomic<int> nRanOn{-1};
+        CYThreadTask task;
+        task.funTaskToExecute = [&](void*, bool) { nRanOn.store(pool->GetCurrentWorkerIndex()); };
+        const bool bSubmitted = pool->SubmitToWorker(5, task);
+        const bool bRejected = !pool->SubmitToWorker(6, task);
+        (void)WaitUntil([&] { return nRanOn.load() != -1; }, 5000);
+        (void)pool->Shutdown(CYShutdownMode::SHUTDOWN_MODE_DRAIN);
+
+        if (!bSubmitted || !bRejected || nRanOn.load() != 5)
+        {
+            std::cout << "❌ Pinned task ran on worker " << nRanOn.load() << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Pinned task ran on lazily spawned worker 5" << std::endl;
+    }
+
+    std::cout << "\n=== All Tests Completed Successfully! ===" << std::endl;
+    return 0;
+}